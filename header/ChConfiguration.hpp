@@ -0,0 +1,146 @@
+/*
+ * ChConfiguration.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef CH_CONFIGURATION_H_
+#define CH_CONFIGURATION_H_
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include "Typedef.h"
+#include "PeConfiguration.hpp"
+
+namespace cgra
+{
+
+/*!
+ * \brief Expand a VirtualChannel configuration without feedback registers to the layout of this build
+ *
+ * \details
+ * The input selects of the input VirtualChannel of the given configuration
+ * are calc_bitwidth(cInputChannel_NumOfInputs) bits wide, i.e. they can only
+ * select VCGRA data inputs. With FEEDBACK_REGISTERS, the selects are widened
+ * to cInputChannel_MuxScltBitwidth bits and the following fields are moved
+ * accordingly. Without FEEDBACK_REGISTERS, the configuration is returned
+ * unchanged.
+ *
+ * \param[in] configA VirtualChannel configuration without feedback registers as byte stream
+ * \return VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ */
+inline std::vector<uint8_t> expandChConfiguration(const std::vector<uint8_t>& configA)
+{
+    constexpr uint32_t t_selectBitwidth{calc_bitwidth(cInputChannel_NumOfInputs)};
+    constexpr uint32_t t_inputChannelBitwidth{cInputChannel_NumOfOutputs * t_selectBitwidth};
+    constexpr uint32_t t_syncStart{t_inputChannelBitwidth + (cNumOfLevels - 1) * cChannelConfigBitwidth};
+    constexpr uint32_t t_bitwidth{8 * calc_numOfBytes(t_syncStart + cPeLevels.back())};
+
+    std::vector<uint8_t> t_config(calc_numOfBytes(cVChConfigBitWidth), 0);
+    for (uint32_t t_output = 0; cInputChannel_NumOfOutputs > t_output; ++t_output) {
+        insertConfigField(t_config, cVChConfigBitWidth, t_output * cInputChannel_MuxScltBitwidth,
+                          cInputChannel_MuxScltBitwidth,
+                          extractConfigField(configA, t_bitwidth, t_output * t_selectBitwidth, t_selectBitwidth));
+    }
+    for (uint32_t t_level = 0; cNumOfLevels - 1 > t_level; ++t_level) {
+        insertConfigField(t_config, cVChConfigBitWidth, cInputChannelConfigBitwidth + t_level * cChannelConfigBitwidth,
+                          cChannelConfigBitwidth,
+                          extractConfigField(configA, t_bitwidth, t_inputChannelBitwidth + t_level * cChannelConfigBitwidth,
+                                             cChannelConfigBitwidth));
+    }
+    insertConfigField(t_config, cVChConfigBitWidth, cSyncConfigStart, cPeLevels.back(),
+                      extractConfigField(configA, t_bitwidth, t_syncStart, cPeLevels.back()));
+
+    return t_config;
+}
+
+/*!
+ * \brief Connect an output of the input VirtualChannel to a VCGRA data input
+ *
+ * \details
+ * Output 2 * i (2 * i + 1) of the input VirtualChannel is In1 (In2) of PE i of the first level.
+ *
+ * \param[in,out] configA   VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ * \param[in] outputA       Output of the input VirtualChannel
+ * \param[in] inputA        VCGRA data input
+ *
+ * \throw std::out_of_range if the output or the data input does not exist
+ */
+inline void setInputSelect(std::vector<uint8_t>& configA, const uint32_t outputA, const uint32_t inputA)
+{
+    if (cInputChannel_NumOfOutputs <= outputA || cInputChannel_NumOfInputs <= inputA)
+        throw std::out_of_range("Input channel select " + std::to_string(outputA) + "/" + std::to_string(inputA) +
+                                " does not exist.");
+
+    insertConfigField(configA, cVChConfigBitWidth, outputA * cInputChannel_MuxScltBitwidth,
+                      cInputChannel_MuxScltBitwidth, inputA);
+}
+
+/*!
+ * \brief Connect an output of a general VirtualChannel to a PE of the previous level
+ *
+ * \details
+ * VirtualChannel l connects PE level l to PE level l + 1. Its output 2 * i
+ * (2 * i + 1) is In1 (In2) of PE i of level l + 1.
+ *
+ * \param[in,out] configA   VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ * \param[in] channelA      Index of the general VirtualChannel
+ * \param[in] outputA       Output of the VirtualChannel
+ * \param[in] peA           PE of level channelA which drives the output
+ *
+ * \throw std::out_of_range if the VirtualChannel, the output or the PE does not exist
+ */
+inline void setChannelSelect(std::vector<uint8_t>& configA, const uint32_t channelA, const uint32_t outputA,
+                             const uint32_t peA)
+{
+    if (cNumOfLevels - 1 <= channelA || 2U * cPeLevels.at(channelA + 1) <= outputA || cPeLevels.at(channelA) <= peA)
+        throw std::out_of_range("Channel select " + std::to_string(channelA) + "/" + std::to_string(outputA) + "/" +
+                                std::to_string(peA) + " does not exist.");
+
+    insertConfigField(configA, cVChConfigBitWidth,
+                      cInputChannelConfigBitwidth + channelA * cChannelConfigBitwidth + outputA * cChannel_MuxScltBitwidth,
+                      cChannel_MuxScltBitwidth, peA);
+}
+
+/*!
+ * \brief Set the Synchronizer mask of the last PE level
+ *
+ * \param[in,out] configA   VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ * \param[in] maskA         Bit i is set if PE i of the last level does not produce a result
+ */
+inline void setSyncMask(std::vector<uint8_t>& configA, const uint32_t maskA)
+{
+    insertConfigField(configA, cVChConfigBitWidth, cSyncConfigStart, cPeLevels.back(), maskA);
+}
+
+#ifdef FEEDBACK_REGISTERS
+/*!
+ * \brief Connect an output of the input VirtualChannel to a feedback register
+ *
+ * \param[in,out] configA   VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ * \param[in] outputA       Output of the input VirtualChannel
+ * \param[in] ageA          Invocation which produced the value (0 is the most recent one)
+ * \param[in] resultA       VCGRA data output which produced the value
+ *
+ * \throw std::out_of_range if the output or the feedback register does not exist
+ */
+inline void setInputFeedback(std::vector<uint8_t>& configA, const uint32_t outputA, const uint32_t ageA,
+                             const uint32_t resultA)
+{
+    if (cInputChannel_NumOfOutputs <= outputA)
+        throw std::out_of_range("Input channel output " + std::to_string(outputA) + " does not exist.");
+    if (cFeedbackDepth <= ageA || cPeLevels.back() <= resultA)
+        throw std::out_of_range("Feedback register " + std::to_string(ageA) + "/" + std::to_string(resultA) +
+                                " does not exist.");
+
+    insertConfigField(configA, cVChConfigBitWidth, outputA * cInputChannel_MuxScltBitwidth,
+                      cInputChannel_MuxScltBitwidth,
+                      cInputChannel_NumOfInputs + ageA * cPeLevels.back() + resultA);
+}
+#endif
+
+} // namespace cgra
+
+#endif // CH_CONFIGURATION_H_
@@ -0,0 +1,95 @@
+/*
+ * ClockEdgeTracker.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef CLOCK_EDGE_TRACKER_H_
+#define CLOCK_EDGE_TRACKER_H_
+
+#include <systemc>
+#include <cstdint>
+
+namespace cgra
+{
+
+/*!
+ * \class ClockEdgeTracker
+ *
+ * \brief Reconstruct rising clock edges a suspended process did not observe
+ *
+ * \details
+ * Activity gated processes (ACTIVITY_GATING) do not wake up on clock edges
+ * while they wait for a relevant input change. To keep cycle based statistics
+ * exact, the tracker remembers the time of the last rising edge a process
+ * observed and calculates the number of missed edges from the clock period.
+ */
+class ClockEdgeTracker
+{
+public:
+    /*!
+     * \brief Fetch the clock period of the sc_clock bound to a clock port
+     *
+     * \details
+     * Needs to be called after port binding, e.g. in end_of_elaboration().
+     *
+     * \param[in] clkA Clock port of the module
+     */
+    template <typename P>
+    void init(const P& clkA)
+    {
+        auto t_clock = dynamic_cast<const sc_core::sc_clock*>(clkA.get_interface());
+
+        if (nullptr == t_clock)
+        {
+            SC_REPORT_ERROR("ClockEdgeTracker",
+                "Activity gating requires a clock port bound to an sc_clock.");
+            return;
+        }
+        m_period = t_clock->period();
+    }
+
+    /*!
+     * \brief Register a rising clock edge observed by a process
+     *
+     * \return Number of rising edges since the last observed edge which were not observed
+     */
+    uint32_t observe()
+    {
+        const sc_core::sc_time t_now{sc_core::sc_time_stamp()};
+        uint32_t t_missed{0U};
+
+        if (m_edgeSeen && m_period.value())
+        {
+            const auto t_edges = (t_now - m_lastEdge).value() / m_period.value();
+            t_missed = t_edges ? static_cast<uint32_t>(t_edges - 1) : 0U;
+        }
+        m_edgeSeen = true;
+        m_lastEdge = t_now;
+
+        return t_missed;
+    }
+
+    /*!
+     * \brief Number of rising edges which passed since the last observed edge
+     */
+    uint32_t pending() const
+    {
+        if (!m_edgeSeen || !m_period.value())
+            return 0U;
+
+        return static_cast<uint32_t>((sc_core::sc_time_stamp() - m_lastEdge).value() / m_period.value());
+    }
+
+private:
+    sc_core::sc_time m_period{sc_core::SC_ZERO_TIME};
+    //!< \brief Period of the observed clock
+    sc_core::sc_time m_lastEdge{sc_core::SC_ZERO_TIME};
+    //!< \brief Time of the last observed rising edge
+    bool m_edgeSeen{false};
+    //!< \brief True after the first observed rising edge
+};
+
+} // namespace cgra
+
+#endif // CLOCK_EDGE_TRACKER_H_
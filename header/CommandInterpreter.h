@@ -35,6 +35,29 @@ public:
     typedef sc_dt::sc_lv<16> address_type_t;
     //!< \brief Type to select address in shared memory
 
+    /*!
+     * \struct Instruction
+     *
+     * \brief Assembler Command with already separated parts
+     *
+     * \details
+     * Assembler Commands are separated once when a program is stored in the
+     * program memory of the ManagementUnit.
+     */
+    struct Instruction
+    {
+        uint32_t assembler;
+        //!< \brief Complete Assembler Command
+        uint16_t address;
+        //!< \brief Address in shared memory
+        uint8_t line;
+        //!< \brief Cache line
+        uint8_t place;
+        //!< \brief Place in cache line
+        uint8_t command;
+        //!< \brief Command to process
+    };
+
 #ifndef GSYSC
     //Entity ports
     sc_core::sc_in<assembler_type_t> assembler{"Assembler_Command_In"};
@@ -118,6 +141,17 @@ public:
      */
     void separate();
 
+    /*!
+     *  \brief Separate Assembler Command parts without simulation
+     *
+     *  \details
+     *  Same structure as separate().
+     *
+     *  \param[in] assemblerA Assembler Command
+     *  \return Instruction with separated parts
+     */
+    static Instruction predecode(uint32_t assemblerA);
+
     /*!
      * \brief Defaulted Destructor
      */
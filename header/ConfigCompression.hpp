@@ -0,0 +1,203 @@
+/*
+ * ConfigCompression.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef CONFIG_COMPRESSION_H_
+#define CONFIG_COMPRESSION_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace cgra
+{
+
+/*!
+ * \brief Compress a configuration byte stream for the shared memory
+ *
+ * \details
+ * The encoding is a byte oriented run-length code (PackBits). Each packet
+ * starts with a header byte h:
+ *   - h < 128: h + 1 literal bytes follow
+ *   - h > 128: the following byte is repeated 257 - h times
+ *   - h = 128: no operation
+ *
+ * Configurations contain long runs of equal bytes, e.g. unused PEs, equal
+ * operation codes or repeated channel selects. A configuration is
+ * compressed on its own, thus every cache line can be decompressed
+ * independently of other configurations in shared memory.
+ *
+ * \param[in] configA Configuration byte stream, most significant byte first
+ * \return Compressed byte stream
+ */
+inline std::vector<uint8_t> compressConfiguration(const std::vector<uint8_t>& configA)
+{
+    std::vector<uint8_t> t_compressed;
+    std::size_t t_pos{0};
+
+    while (configA.size() > t_pos)
+    {
+        //Length of the run of equal bytes at the current position (max 128)
+        std::size_t t_run{1};
+        while (configA.size() > t_pos + t_run && 128 > t_run && configA[t_pos + t_run] == configA[t_pos])
+            ++t_run;
+
+        if (1 < t_run)
+        {
+            t_compressed.push_back(static_cast<uint8_t>(257 - t_run));
+            t_compressed.push_back(configA[t_pos]);
+            t_pos += t_run;
+        }
+        else
+        {
+            //Collect literal bytes until the next run of at least two bytes (max 128)
+            std::size_t t_literals{1};
+            while (configA.size() > t_pos + t_literals && 128 > t_literals &&
+                   !(configA.size() > t_pos + t_literals + 1 && configA[t_pos + t_literals] == configA[t_pos + t_literals + 1]))
+                ++t_literals;
+
+            t_compressed.push_back(static_cast<uint8_t>(t_literals - 1));
+            t_compressed.insert(t_compressed.end(), configA.begin() + t_pos, configA.begin() + t_pos + t_literals);
+            t_pos += t_literals;
+        }
+    }
+
+    return t_compressed;
+}
+
+static constexpr uint8_t cCompressionNoOp{128};
+//!< \brief Packet header without payload, pads compressed streams to whole bursts
+
+/*!
+ * \brief Number of compressed bytes of a configuration in memory
+ *
+ * \details
+ * Only the packet headers are evaluated, thus the MMU knows how many bytes
+ * of a compressed configuration need to be streamed to the configuration
+ * caches without decompressing it.
+ *
+ * \param[in] memA      Memory which contains the compressed stream
+ * \param[in] addressA  Address of the first packet header in memory
+ * \param[in] sizeA     Number of bytes of the decompressed configuration
+ * \tparam M            Byte addressed memory with size() and operator[]
+ * \return Number of compressed bytes, 0 if the compressed stream exceeds the memory
+ */
+template <typename M>
+uint64_t compressedConfigurationSize(const M& memA, const uint64_t addressA, const uint64_t sizeA)
+{
+    uint64_t t_address{addressA};
+    uint64_t t_decompressed{0};
+
+    while (sizeA > t_decompressed)
+    {
+        if (memA.size() <= t_address)
+            return 0;
+
+        const uint8_t t_header{memA[t_address]};
+        if (128 > t_header)
+        {
+            t_decompressed += t_header + 1U;
+            t_address += t_header + 2U;
+        }
+        else if (128 < t_header)
+        {
+            t_decompressed += 257U - t_header;
+            t_address += 2;
+        }
+        else
+            ++t_address;
+    }
+
+    return (memA.size() < t_address) ? 0 : t_address - addressA;
+}
+
+/*!
+ * \class ConfigDecompressor
+ *
+ * \brief Decompress a configuration stream byte by byte
+ *
+ * \details
+ * Counterpart of compressConfiguration(). Compressed bytes are fed in stream
+ * order and the restored configuration bytes are appended to an output
+ * container. Packets may be split between two calls, thus a compressed
+ * stream can be fed burst by burst.
+ */
+class ConfigDecompressor
+{
+public:
+    /*!
+     * \brief Start decompressing a new configuration
+     */
+    void reset()
+    {
+        m_count = 0;
+        m_literal = false;
+        m_repeat = false;
+    }
+
+    /*!
+     * \brief Decompress the next compressed byte
+     *
+     * \param[in] byteA     Next byte of the compressed stream
+     * \param[out] outA     Container the restored bytes are appended to
+     * \tparam O            Byte container with push_back()
+     */
+    template <typename O>
+    void decode(const uint8_t byteA, O& outA)
+    {
+        ++m_bytesRead;
+
+        if (m_literal)
+        {
+            outA.push_back(byteA);
+            ++m_bytesWritten;
+            m_literal = (0 != --m_count);
+        }
+        else if (m_repeat)
+        {
+            for (uint32_t t_idx = 0; m_count > t_idx; ++t_idx)
+                outA.push_back(byteA);
+            m_bytesWritten += m_count;
+            m_count = 0;
+            m_repeat = false;
+        }
+        else if (128 > byteA)
+        {
+            m_literal = true;
+            m_count = byteA + 1U;
+        }
+        else if (128 < byteA)
+        {
+            m_repeat = true;
+            m_count = 257U - byteA;
+        }
+    }
+
+    /*!
+     * \brief Number of compressed bytes fed to the decompressor
+     */
+    uint64_t bytesRead() const { return m_bytesRead; }
+
+    /*!
+     * \brief Number of restored bytes
+     */
+    uint64_t bytesWritten() const { return m_bytesWritten; }
+
+private:
+    uint32_t m_count{0};
+    //!< \brief Remaining literal bytes or repetitions of the current packet
+    bool m_literal{false};
+    //!< \brief The next compressed bytes are literal bytes
+    bool m_repeat{false};
+    //!< \brief The next compressed byte is repeated m_count times
+    uint64_t m_bytesRead{0};
+    //!< \brief Total number of compressed bytes
+    uint64_t m_bytesWritten{0};
+    //!< \brief Total number of restored bytes
+};
+
+} // namespace cgra
+
+#endif // CONFIG_COMPRESSION_H_
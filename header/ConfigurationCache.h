@@ -60,6 +60,15 @@ typedef ConfigurationCache<cgra::ch_config_type_t,
  * configuration can not be overwritten while it is used.
  * "T" needs to be a data type with a vector which has is an
  * integer multiple of "stream_type_t".
+ * In burst mode (MMU_BURST_WIDTH) the cache line is shifted by N bits
+ * per stream and "T" may be shorter than or no multiple of N. The first
+ * stream of a configuration then carries its upper bits right-aligned.
+ * With PARTIAL_RECONFIGURATION, a stream is written to the place of the
+ * cache line which is selected by slt_place instead of being shifted in.
+ * Place 0 is the most significant stream of a cache line, i.e. the first
+ * stream of a whole cache line transmission. Thus, single bytes or
+ * segments of a configuration can be replaced without streaming the
+ * whole cache line.
  *
  * \tparam T Type of stored configuration (e.g. bitwidth)
  * \tparam M Bitwidth of select interfaces
@@ -85,6 +94,10 @@ public:
     //!< \brief Type for streaming input data to fill cache line
     typedef cgra::cache_ack_type_t ack_type_t;
     //!< \brief Acknowledge data type
+#ifdef PARTIAL_RECONFIGURATION
+    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfPlacesPerCacheLine)> select_place_type_t;
+    //!< \brief Select a place (stream) within a cache line
+#endif
 
     //Entity Ports
 
@@ -99,6 +112,10 @@ public:
     //!< \brief Select cache line to store datum from data-in-stream
     sc_core::sc_in<select_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for current-configuration
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_in<select_place_type_t> slt_place{"data_in_cache_place"};
+    //!< \brief Select place within cache line to store datum from data-in-stream
+#endif
     sc_core::sc_out<config_type_t> currentConfig{"current_configuration"};
     //!< \brief Currently set configuration
     sc_core::sc_out<ack_type_t> ack{"acknowledge"};
@@ -114,6 +131,10 @@ public:
     //!< \brief Select cache line to store datum from data-in-stream
     sc_in<select_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for current-configuration
+#ifdef PARTIAL_RECONFIGURATION
+    sc_in<select_place_type_t> slt_place{"data_in_cache_place"};
+    //!< \brief Select place within cache line to store datum from data-in-stream
+#endif
     sc_out<config_type_t> currentConfig{"current_configuration"};
     //!< \brief Currently set configuration
     sc_out<ack_type_t> ack{"acknowledge"};
@@ -174,8 +195,32 @@ public:
             if(slt_in.read().to_uint() != slt_out.read().to_uint())
             {
                 auto tmp_cacheline = m_cachelines[slt_in.read().to_uint()].read();
+#if defined(PARTIAL_RECONFIGURATION)
+                //Place 0 holds the most significant stream of a cache line
+                const uint32_t t_numOfPlaces = (tmp_cacheline.length() + N - 1) / N;
+                const uint32_t t_place = slt_place.read().to_uint();
+                if (t_numOfPlaces > t_place) {
+                    const uint32_t t_lsb = (t_numOfPlaces - 1 - t_place) * N;
+                    const uint32_t t_msb = (t_lsb + N > static_cast<uint32_t>(tmp_cacheline.length())) ?
+                        tmp_cacheline.length() - 1 : t_lsb + N - 1;
+                    tmp_cacheline.range(t_msb, t_lsb) = dataInStream.read().range(t_msb - t_lsb, 0);
+                }
+                else {
+                    SC_REPORT_WARNING("Configuration Warning", "Selected place not in range of cache line. Configuration is unchanged");
+                }
+#elif !defined(MMU_BURST_WIDTH)
                 tmp_cacheline = tmp_cacheline.lrotate(N);
                 tmp_cacheline |= dataInStream.read();
+#else
+                //Shift in burst; a burst wider than the cache line replaces it
+                if (N < tmp_cacheline.length()) {
+                    tmp_cacheline <<= N;
+                    tmp_cacheline |= dataInStream.read();
+                }
+                else {
+                    tmp_cacheline = dataInStream.read();
+                }
+#endif
                 m_cachelines[slt_in.read().to_uint()].write(tmp_cacheline);
                 ack.write(true);
             }
@@ -234,6 +279,9 @@ public:
         os << "Bitwidth serial input:\t\t" << std::setw(3) << static_cast<uint32_t>(N) << std::endl;
         os << "Selected input cache line:\t" << std::setw(3) << slt_in.read().to_string() << std::endl;
         os << "Selected output cache line:\t" << std::setw(3) << slt_out.read().to_string() << std::endl;
+#ifdef PARTIAL_RECONFIGURATION
+        os << "Selected input place:\t\t" << std::setw(3) << slt_place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#endif
 
         os << "Cache content\n";
         os << "=============\n";
@@ -0,0 +1,390 @@
+/*
+ * ConfigurationDecompressor.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef CONFIGURATION_DECOMPRESSOR_H_
+#define CONFIGURATION_DECOMPRESSOR_H_
+
+#include <systemc>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include "Typedef.h"
+#include "ConfigCompression.hpp"
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+namespace cgra {
+
+//Forward declaration of ConfigurationDecompressor template class
+template <uint8_t N>
+class ConfigurationDecompressor;
+
+//Decompressor Definitions for VCGRA instance
+//-------------------------------------------
+typedef ConfigurationDecompressor<cgra::cBitWidthOfSerialInterfacePeConfCache> pe_config_decompressor_type_t;
+//!< \brief Type definition for decompressor in front of Processing_Element configuration cache
+typedef ConfigurationDecompressor<cgra::cBitWidthOfSerialInterfaceVChConfCache> ch_config_decompressor_type_t;
+//!< \brief Type definition for decompressor in front of VirtualChannel configuration cache
+
+
+/*!
+ * \class ConfigurationDecompressor
+ *
+ * \brief Decompression stage in front of a ConfigurationCache
+ *
+ * \details
+ * If "compressed" is not set, the stage forwards the stream, write enable,
+ * place and acknowledge signals between MMU and ConfigurationCache without
+ * delay. If it is set, the MMU streams a compressed configuration (see
+ * compressConfiguration()) with N / 8 compressed bytes per stream. The
+ * first compressed byte is the most significant byte of a stream, the last
+ * stream is padded with no-operation packets. Each received stream is
+ * decompressed and the restored bytes are written to the ConfigurationCache
+ * with the same streams as an uncompressed transmission of the MMU: the
+ * first stream of a cache line carries the remainder of the cache line size
+ * right-aligned, all following streams are complete. A received stream is
+ * acknowledged to the MMU after all restored streams of it are stored, thus
+ * a cache line is complete when the MMU transmission is finished.
+ *
+ * \tparam N Bitwidth of serial configuration stream
+ */
+template <uint8_t N = 8>
+class ConfigurationDecompressor : public sc_core::sc_module
+{
+public:
+    typedef cgra::clock_type_t clock_type_t;
+    //!< \brief Clock type
+    typedef cgra::cache_write_type_t write_enable_type_t;
+    //!< \brief Type for write enable signal
+    typedef sc_dt::sc_lv<N> stream_type_t;
+    //!< \brief Type for configuration streams
+    typedef cgra::cache_ack_type_t ack_type_t;
+    //!< \brief Acknowledge data type
+#ifdef PARTIAL_RECONFIGURATION
+    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfPlacesPerCacheLine)> select_place_type_t;
+    //!< \brief Select a place (stream) within a cache line
+#endif
+
+    static_assert(0 == N % 8, "Configuration streams need to consist of whole bytes.");
+
+    //Entity Ports
+
+#ifndef GSYSC
+    sc_core::sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock of decompression stage
+    sc_core::sc_in<bool> compressed{"compressed"};
+    //!< \brief The MMU streams a compressed configuration
+    sc_core::sc_in<stream_type_t> dataInStream{"data_in_stream"};
+    //!< \brief (Compressed) configuration stream from MMU
+    sc_core::sc_in<write_enable_type_t> write{"write"};
+    //!< \brief Write enable from MMU
+    sc_core::sc_out<ack_type_t> ack{"acknowledge"};
+    //!< \brief Acknowledge to MMU
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_in<select_place_type_t> slt_place{"data_in_cache_place"};
+    //!< \brief Place within cache line from MMU
+    sc_core::sc_out<select_place_type_t> cache_place{"cache_place"};
+    //!< \brief Place within cache line to ConfigurationCache
+#endif
+    sc_core::sc_out<stream_type_t> dataOutStream{"data_out_stream"};
+    //!< \brief Decompressed configuration stream to ConfigurationCache
+    sc_core::sc_out<write_enable_type_t> cache_write{"cache_write"};
+    //!< \brief Write enable to ConfigurationCache
+    sc_core::sc_in<ack_type_t> cache_ack{"cache_acknowledge"};
+    //!< \brief Acknowledge from ConfigurationCache
+#else
+    sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock of decompression stage
+    sc_in<bool> compressed{"compressed"};
+    //!< \brief The MMU streams a compressed configuration
+    sc_in<stream_type_t> dataInStream{"data_in_stream"};
+    //!< \brief (Compressed) configuration stream from MMU
+    sc_in<write_enable_type_t> write{"write"};
+    //!< \brief Write enable from MMU
+    sc_out<ack_type_t> ack{"acknowledge"};
+    //!< \brief Acknowledge to MMU
+#ifdef PARTIAL_RECONFIGURATION
+    sc_in<select_place_type_t> slt_place{"data_in_cache_place"};
+    //!< \brief Place within cache line from MMU
+    sc_out<select_place_type_t> cache_place{"cache_place"};
+    //!< \brief Place within cache line to ConfigurationCache
+#endif
+    sc_out<stream_type_t> dataOutStream{"data_out_stream"};
+    //!< \brief Decompressed configuration stream to ConfigurationCache
+    sc_out<write_enable_type_t> cache_write{"cache_write"};
+    //!< \brief Write enable to ConfigurationCache
+    sc_in<ack_type_t> cache_ack{"cache_acknowledge"};
+    //!< \brief Acknowledge from ConfigurationCache
+#endif
+
+    //Ctor
+    SC_HAS_PROCESS(ConfigurationDecompressor);
+    /*!
+     * \brief General Constructor
+     *
+     * \param[in] nameA                 SystemC module name for ConfigurationDecompressor instance
+     * \param[in] configBitStreamLength Number of configuration bits of the following ConfigurationCache
+     */
+    ConfigurationDecompressor(const sc_core::sc_module_name& nameA, uint32_t configBitStreamLength) :
+        sc_core::sc_module(nameA), m_numOfBytes(cgra::calc_numOfBytes(configBitStreamLength))
+    {
+        SC_METHOD(forward);
+        sensitive << compressed << dataInStream << write << cache_ack;
+        sensitive << m_stream << m_write << m_ack;
+#ifdef PARTIAL_RECONFIGURATION
+        sensitive << slt_place << m_place;
+#endif
+        SC_METHOD(decompress);
+        sensitive << clk.pos();
+    }
+
+    ConfigurationDecompressor() = delete;
+    //!< \brief SystemC requires unique module name
+    ConfigurationDecompressor(const ConfigurationDecompressor& rhs) = delete;
+    //!< \brief sc_module cannot being copied
+    ConfigurationDecompressor& operator=(const ConfigurationDecompressor& rhs) = delete;
+    //!< \brief sc_module cannot being copied
+
+    virtual ~ConfigurationDecompressor() = default;
+    //!< \brief Destructor
+
+    /*!
+     * \brief Initialize output signals of module
+     */
+    void end_of_elaboration() override
+    {
+        ack.write(false);
+        cache_write.write(false);
+        dataOutStream.write(0);
+#ifdef PARTIAL_RECONFIGURATION
+        cache_place.write(0);
+#endif
+    }
+
+    /*!
+     * \brief Connect MMU or decompression state machine to ConfigurationCache
+     */
+    void forward()
+    {
+        if (compressed.read())
+        {
+            dataOutStream.write(m_stream.read());
+            cache_write.write(m_write.read());
+            ack.write(m_ack.read());
+#ifdef PARTIAL_RECONFIGURATION
+            cache_place.write(m_place.read());
+#endif
+        }
+        else
+        {
+            dataOutStream.write(dataInStream.read());
+            cache_write.write(write.read());
+            ack.write(cache_ack.read());
+#ifdef PARTIAL_RECONFIGURATION
+            cache_place.write(slt_place.read());
+#endif
+        }
+    }
+
+    /*!
+     * \brief Decompress received streams and write them to ConfigurationCache
+     */
+    void decompress()
+    {
+        if (!compressed.read())
+        {
+            m_state = STATES::RECEIVE;
+            m_ack.write(false);
+            m_write.write(false);
+            restart();
+            return;
+        }
+
+        switch (m_state)
+        {
+            case STATES::RECEIVE:
+            {
+                if (write.read() && !m_ack.read())
+                {
+                    //The first compressed byte is the most significant byte of the stream
+                    const stream_type_t t_stream{dataInStream.read()};
+                    for (int32_t t_byte = cStreamBytes - 1; 0 <= t_byte; --t_byte) {
+                        m_decompressor.decode(static_cast<uint8_t>(t_stream.range(8 * t_byte + 7, 8 * t_byte).to_uint()),
+                                              m_buffer);
+                    }
+                    ++m_transmissions;
+                    m_state = STATES::STORE;
+                }
+                break;
+            }
+            case STATES::STORE:
+            {
+                //The first stream of a cache line carries the remainder of the cache line size
+                const uint32_t t_streamBytes{(0 == m_lineBytes) ? (m_numOfBytes - 1U) % cStreamBytes + 1U : cStreamBytes};
+
+                if (t_streamBytes <= m_buffer.size())
+                {
+                    stream_type_t t_stream{0};
+                    for (uint32_t t_idx = 0; t_streamBytes > t_idx; ++t_idx)
+                    {
+                        const uint32_t t_lsb{(t_streamBytes - 1 - t_idx) * 8};
+                        t_stream.range(t_lsb + 7, t_lsb) = m_buffer.front();
+                        m_buffer.pop_front();
+                    }
+                    m_stream.write(t_stream);
+                    m_write.write(true);
+                    m_lineBytes += t_streamBytes;
+                    m_state = STATES::WAIT_ACK;
+                }
+                else
+                {
+                    //Restored bytes are stored, request next stream from MMU
+                    m_ack.write(true);
+                    m_state = STATES::RELEASE;
+                }
+                break;
+            }
+            case STATES::WAIT_ACK:
+            {
+                if (cache_ack.read())
+                {
+                    m_write.write(false);
+                    if (m_numOfBytes <= m_lineBytes)
+                    {
+                        if (!m_buffer.empty()) {
+                            SC_REPORT_WARNING("Decompression Warning", "Compressed configuration exceeds cache line. Remaining bytes are discarded.");
+                        }
+                        restart();
+                    }
+#ifdef PARTIAL_RECONFIGURATION
+                    else {
+                        m_place.write(m_place.read() + 1);
+                    }
+#endif
+                    m_state = STATES::STORE;
+                }
+                break;
+            }
+            case STATES::RELEASE:
+            {
+                if (!write.read())
+                {
+                    m_ack.write(false);
+                    m_state = STATES::RECEIVE;
+                }
+                break;
+            }
+            default:
+            {
+                m_state = STATES::RECEIVE;
+                SC_REPORT_WARNING("Decompression Warning", "Unknown state-machine state. Wait for new stream.");
+                break;
+            }
+        }
+    }
+
+    /*!
+     * \brief Print kind of SystemC module
+     */
+    const char* kind() const override {
+        return "Configuration Decompressor";
+    }
+
+    /*!
+     * \brief Print configuration decompressor name
+     *
+     * \param[out] os Define used outstream [default: std::cout]
+     */
+    void print(std::ostream& os = std::cout) const override
+    {
+        os << name();
+    }
+
+    /*!
+     * \brief Dump configuration decompressor information
+     *
+     * \param[out] os Define used outstream [default: std::cout]
+     */
+    void dump(std::ostream& os = std::cout) const override
+    {
+        os << name() << "\t\t" << kind() << std::endl;
+        os << "Cache line length:\t\t" << std::setw(3) << m_numOfBytes << std::endl;
+        os << "Bitwidth serial input:\t\t" << std::setw(3) << static_cast<uint32_t>(N) << std::endl;
+        os << "Compressed transmissions:\t" << m_transmissions << std::endl;
+        os << "Compressed bytes:\t\t" << m_decompressor.bytesRead() << std::endl;
+        os << "Decompressed bytes:\t\t" << m_decompressor.bytesWritten() << std::endl;
+    }
+
+    /*!
+     * \brief Return number of received compressed streams
+     */
+    uint64_t transmissions() const { return m_transmissions; }
+
+    /*!
+     * \brief Return number of received compressed bytes (including padding)
+     */
+    uint64_t compressedBytes() const { return m_decompressor.bytesRead(); }
+
+    /*!
+     * \brief Return number of restored configuration bytes
+     */
+    uint64_t decompressedBytes() const { return m_decompressor.bytesWritten(); }
+
+private:
+    /*!
+     * \brief Start a new cache line
+     */
+    void restart()
+    {
+        m_buffer.clear();
+        m_decompressor.reset();
+        m_lineBytes = 0;
+#ifdef PARTIAL_RECONFIGURATION
+        m_place.write(0);
+#endif
+    }
+
+    static constexpr uint32_t cStreamBytes{N / 8};
+    //!< \brief Number of bytes per configuration stream
+
+    /*! Decompression state machine states */
+    enum class STATES : uint8_t
+    {
+        RECEIVE,    //!< \brief Wait for compressed stream of MMU
+        STORE,      //!< \brief Write next restored stream to ConfigurationCache
+        WAIT_ACK,   //!< \brief Wait for acknowledge of ConfigurationCache
+        RELEASE     //!< \brief Wait for MMU to release write enable
+    } m_state{STATES::RECEIVE};
+    //!< \brief State machine variable
+
+    const uint32_t m_numOfBytes;
+    //!< \brief Number of bytes of a cache line
+    uint32_t m_lineBytes{0};
+    //!< \brief Number of bytes of the current cache line written to ConfigurationCache
+    uint64_t m_transmissions{0};
+    //!< \brief Number of received compressed streams
+    ConfigDecompressor m_decompressor;
+    //!< \brief Restores configuration bytes from compressed bytes
+    std::deque<uint8_t> m_buffer;
+    //!< \brief Restored bytes which are not written to ConfigurationCache yet
+    sc_core::sc_signal<stream_type_t> m_stream{"decompressed_stream"};
+    //!< \brief Decompressed stream to ConfigurationCache
+    sc_core::sc_signal<write_enable_type_t> m_write{"decompressed_write"};
+    //!< \brief Write enable of decompressed stream
+    sc_core::sc_signal<ack_type_t> m_ack{"compressed_ack"};
+    //!< \brief Acknowledge of compressed stream
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_signal<select_place_type_t> m_place{"decompressed_place"};
+    //!< \brief Place of decompressed stream within cache line
+#endif
+};
+
+} //end namespace cgra
+
+#endif //CONFIGURATION_DECOMPRESSOR_H_
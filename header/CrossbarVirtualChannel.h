@@ -0,0 +1,368 @@
+/*
+ * CrossbarVirtualChannel.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef CROSSBARVIRTUALCHANNEL_H_
+#define CROSSBARVIRTUALCHANNEL_H_
+
+#include <systemc>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <array>
+#include "Typedef.h"
+
+#ifdef ACTIVITY_GATING
+#include "ClockEdgeTracker.hpp"
+#endif
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+namespace cgra {
+
+/*!
+ * \class CrossbarVirtualChannel
+ *
+ * \brief VirtualChannel which routes all outputs within a single process
+ *
+ * \details
+ * Drop-in replacement of VirtualChannel with the same ports, configuration
+ * bit order and timing. Instead of T Multiplexer modules and internal
+ * buffer signals, the channel keeps the sampled inputs as member variables
+ * and a select table which is decoded once per configuration change.
+ *
+ * On every rising clock edge, the outputs are routed from the inputs which
+ * were sampled on the previous edge and the inputs are sampled again. Like
+ * in VirtualChannel, a datum needs two clock edges from an input to an
+ * output and a configuration change takes effect with the next edge.
+ *
+ * \tparam R Number preceding PEs of a VC
+ * \tparam S Bitwidth of the inputs of a VC
+ * \tparam T Number of VC outputs = 2 x Number of succeeding PEs of a VC
+ * \tparam U Bitwidth of the outputs of a VC
+ * \tparam L Bitwidth of select lines
+ * \tparam N Internal Bitwidth of a VC (default = 8); Needs to be >= max(S,U)
+ */
+template <uint32_t R, uint32_t S, uint32_t T, uint32_t U, uint32_t L, uint32_t N = U>
+class CrossbarVirtualChannel : public sc_core::sc_module {
+private:
+    typedef sc_dt::sc_int<N> internal_type_t;
+    //!< \brief Type for sampled inputs (max(S,U))
+
+public:
+    typedef sc_dt::sc_int<S> input_type_t;
+    //!< \brief Type of VirtualChannel data inputs
+    typedef cgra::clock_type_t clock_type_t;
+    //!< \brief Clock type
+    typedef cgra::reset_type_t reset_type_t;
+    //!< \brief Reset type
+    typedef cgra::config_vector_t<T * L> conf_type_t;
+    //!< \brief Type of VirtualChannel configuration port
+    typedef bool valid_type_t;
+    //!< \brief Type of VirtualChannel valid signals
+    typedef bool enables_type_t;
+    //!< \brief Type of VirtualChannel enable signals
+    typedef cgra::config_vector_t<L> select_type_t;
+    //!< \brief Type of a select line within the configuration
+    typedef sc_dt::sc_int<U> output_type_t;
+    //!< \brief Type of VirtualChannel data output
+
+#ifndef GSYSC
+    //Entity ports
+    sc_core::sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock port of a VC
+    sc_core::sc_in<reset_type_t> rst{"rst"};
+    //!< \brief Reset VC buffers if rst equals false
+    std::array<sc_core::sc_in<valid_type_t>, R > valids;
+    //!< \brief Input port for all valid signals of the preceding PEs
+    sc_core::sc_in<conf_type_t> conf{"conf"};
+    //!< \brief Configuration bitstream with a select line for every output
+    std::array<sc_core::sc_in<input_type_t>, R> channel_inputs;
+    //!< \brief Data inputs of all preceding PEs
+    std::array<sc_core::sc_out<output_type_t>, T> channel_outputs;
+    //!< \brief Data outputs for all succeding PEs
+    std::array<sc_core::sc_out<enables_type_t>, T> enables;
+    //!< \brief Corresponding Enable signals for succeeding PEs
+#else
+    //Entity ports
+    sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock port of a VC
+    sc_in<reset_type_t> rst{"rst"};
+    //!< \brief Reset VC buffers if rst equals false
+    std::array<sc_in<valid_type_t>, R > valids;
+    //!< \brief Input port for all valid signals of the preceding PEs
+    sc_in<conf_type_t> conf{"conf"};
+    //!< \brief Configuration bitstream with a select line for every output
+    std::array<sc_in<input_type_t>, R> channel_inputs;
+    //!< \brief Data inputs of all preceding PEs
+    std::array<sc_out<output_type_t>, T> channel_outputs;
+    //!< \brief Data outputs for all succeding PEs
+    std::array<sc_out<enables_type_t>, T> enables;
+    //!< \brief Corresponding Enable signals for succeeding PEs
+#endif
+
+    SC_HAS_PROCESS(CrossbarVirtualChannel);
+    /*!
+     * \brief Named C'tor for a VC
+     *
+     * \param[in] nameA Name of the VC within the simulation
+     */
+    CrossbarVirtualChannel(const sc_core::sc_module_name& nameA) : sc_core::sc_module(nameA)
+#ifdef MCPAT
+    ,m_totalCycles{0U}, m_idleCycles{0U}, m_busyCycles{0U}
+#endif
+    {
+        //Register SystemC methods at simulator
+        SC_METHOD(route);
+        sensitive << clk.pos();
+        SC_METHOD(decode_select);
+        sensitive << conf.value_changed();
+    }
+
+    /*!
+     * \brief Callback of sc_core::sc_module class to initialize outputs of VC
+     */
+    virtual void end_of_elaboration() override
+    {
+        m_inputs.fill(0);
+        m_valids.fill(false);
+        m_selects.fill(0);
+
+        for (uint32_t i = 0; i < T; ++i)
+        {
+            channel_outputs[i].write(0);
+            enables[i].write(false);
+        }
+
+#ifdef ACTIVITY_GATING
+        m_inputActivity |= rst.value_changed_event();
+        m_inputActivity |= conf.value_changed_event();
+        for (uint32_t i = 0; i < R; ++i)
+        {
+            m_inputActivity |= channel_inputs[i].value_changed_event();
+            m_inputActivity |= valids[i].value_changed_event();
+        }
+        m_edgeTracker.init(clk);
+#endif
+    }
+
+    /*!
+     * \brief Print kind of SystemC-module
+     */
+    virtual const char* kind() const override {
+        return "Crossbar Virtual Channel";
+    }
+
+    /*!
+     * \brief Print VirtualChannel name
+     *
+     * \param[out]     os     Select outstream to write [default: std::cout]
+     */
+    virtual void print(std::ostream& os = ::std::cout) const override
+    {
+        os << name();
+    }
+
+    /*!
+     * \brief Dump VirtualChannel information
+     *
+     * \param[out]     os     Select outstream to write [default: std::cout]
+     */
+    virtual void dump(std::ostream& os = ::std::cout) const override
+    {
+        os << name() << "\t" << kind() << std::endl;
+        os << "Number of Inputs:\t" << channel_inputs.size() << "\n";
+        os << "Input bitwidth:\t\t" << S << "\n";
+        os << "Number of Outputs:\t" << channel_outputs.size() << "\n";
+        os << "Output bitwidth:\t" << U << "\n";
+        os << "Internal bitwidth:\t" << N << "\n";
+        os << "Length of configuration bitstream:\t" << (L*T) << std::endl;
+
+        if(conf.size())
+        {
+            os << "Current Configuration:\t" << conf.read().to_string(sc_dt::SC_HEX,true) << std::endl;
+        }
+
+        os << "Output:\t\tSelected input\tSampled data\tSampled valid\n";
+        for (uint32_t i = 0; i < T; ++i)
+        {
+            os << std::setw(6) << i << "\t\t" << std::setw(6) << m_selects[i] << "\t\t"
+               << std::setw(6) << m_inputs[m_selects[i]].to_int64() << "\t\t" << m_valids[m_selects[i]] << "\n";
+        }
+        os << std::endl;
+    }
+
+#ifdef MCPAT
+    /**
+     * \brief Dump runtime statistics for McPAT simulation
+     *
+     * \param os Define used outstream [default: std::cout]
+     */
+    void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
+    {
+#ifdef ACTIVITY_GATING
+        //A VC is busy for all clock cycles it did not observe
+        const uint32_t t_pending = m_suspended ? m_edgeTracker.pending() : 0U;
+#else
+        const uint32_t t_pending = 0U;
+#endif
+        os << name() << "\t" << kind() << std::endl;
+        os << "total cycles: " << m_totalCycles + t_pending << "\n";
+        os << "idle cycles: " << m_idleCycles << "\n";
+        os << "busy cycles: " << m_busyCycles + t_pending << "\n";
+        os << std::endl;
+    }
+#endif
+
+    //Processes
+    /*!
+     * \brief Route the sampled inputs to the outputs and sample the inputs
+     *
+     * \details
+     * With ACTIVITY_GATING, the process suspends itself if the sampled
+     * inputs did not change, because the next edge would route the same
+     * values again. It wakes up if an input, valid, reset or configuration
+     * signal changes.
+     */
+    void route()
+    {
+#ifdef ACTIVITY_GATING
+        if (m_suspended)
+        {
+            //Woken up by an input change, sample it on the next clock edge
+            m_suspended = false;
+            if (!clk.posedge())
+                return;
+        }
+#ifdef MCPAT
+        {
+            const uint32_t t_missedCycles{m_edgeTracker.observe()};
+            m_totalCycles += t_missedCycles;
+            m_busyCycles += t_missedCycles;
+        }
+#endif
+#endif
+
+#ifdef MCPAT
+        /* A virtual channel always changes its input and output buffer states.
+         * Thus the component is always busy and has no idle state.
+         */
+        ++m_totalCycles;
+        ++m_busyCycles;
+#endif
+        for (uint32_t i = 0; i < T; ++i)
+        {
+            channel_outputs[i].write(m_inputs[m_selects[i]].range(U - 1, 0));
+            enables[i].write(m_valids[m_selects[i]]);
+        }
+
+        const bool t_reset{!rst.read()};
+#ifdef ACTIVITY_GATING
+        bool t_changed{false};
+#endif
+        for (uint32_t i = 0; i < R; ++i)
+        {
+            const internal_type_t t_input = t_reset ? internal_type_t{0} : internal_type_t{channel_inputs[i].read()};
+            const bool t_valid{!t_reset && valids[i].read()};
+#ifdef ACTIVITY_GATING
+            t_changed = t_changed || (t_input != m_inputs[i]) || (t_valid != m_valids[i]);
+#endif
+            m_inputs[i] = t_input;
+            m_valids[i] = t_valid;
+        }
+
+#ifdef ACTIVITY_GATING
+        //Routing unchanged inputs again would not change the outputs
+        if (!t_changed)
+        {
+            next_trigger(m_inputActivity);
+            m_suspended = true;
+        }
+#endif
+    }
+
+    /*!
+     * \brief Decode the select table from the configuration bitstream
+     *
+     * \details
+     * The bit order is the same as in VirtualChannel::split_select: the
+     * select line of output 0 is located at the most significant bits of
+     * the configuration.
+     */
+    void decode_select()
+    {
+        if (m_externalSelects)
+            return;
+
+        const conf_type_t t_conf{conf.read()};
+        for (uint32_t i = 0; i < T; ++i)
+        {
+            m_selects[i] = t_conf.range(T * L - 1 - i * L, T * L - (i + 1) * L).to_uint();
+            // Check, that selecting index is valid
+            sc_assert(m_selects[i] < R);
+        }
+    }
+
+    /*!
+     * \brief Take the select table from load_selects() instead of decoding conf
+     *
+     * \details
+     * Needs to be called during elaboration. Afterwards, conf is only
+     * observed and the owner of the channel needs to call load_selects()
+     * for every configuration change.
+     */
+    void use_external_selects()
+    {
+        m_externalSelects = true;
+    }
+
+    /*!
+     * \brief Replace the select table by a pre-decoded one
+     *
+     * \param[in] selectsA Selected input of every output, same values as the fields of conf
+     */
+    void load_selects(const std::array<uint32_t, T>& selectsA)
+    {
+        m_selects = selectsA;
+    }
+
+private:
+    //Forbidden Constructors
+    CrossbarVirtualChannel() = delete;
+    CrossbarVirtualChannel(const CrossbarVirtualChannel& src) = delete;
+    CrossbarVirtualChannel& operator=(const CrossbarVirtualChannel& src) = delete;
+    CrossbarVirtualChannel(CrossbarVirtualChannel&& src) = delete;
+    CrossbarVirtualChannel& operator=(CrossbarVirtualChannel&& src) = delete;
+
+    std::array<internal_type_t, R> m_inputs;
+    //!< \brief Data inputs sampled on the previous clock edge
+    std::array<bool, R> m_valids;
+    //!< \brief Valid inputs sampled on the previous clock edge
+    std::array<uint32_t, T> m_selects;
+    //!< \brief Selected input of every output, decoded from conf
+    bool m_externalSelects{false};
+    //!< \brief Select table is written by load_selects() instead of decode_select()
+#ifdef ACTIVITY_GATING
+    sc_core::sc_event_or_list m_inputActivity;
+    //!< \brief Value changes which wake up a suspended route
+    cgra::ClockEdgeTracker m_edgeTracker;
+    //!< \brief Reconstructs clock cycles while route is suspended
+    bool m_suspended{false};
+    //!< \brief route waits for an input change
+#endif
+#ifdef MCPAT
+    //McPAT dynamic statistic counters:
+    uint32_t m_totalCycles;   //!< \brief Count total number of executed cycles
+    uint32_t m_idleCycles;    //!< \brief Count number of idle cycles
+    uint32_t m_busyCycles;    //!< \brief Count number of working cycles
+#endif
+
+};
+
+} // namespace cgra
+
+#endif // CROSSBARVIRTUALCHANNEL_H_
@@ -22,13 +22,14 @@
 namespace cgra {
 
 //Forward declaration of DataCache class
-template <uint32_t B, uint32_t N, uint32_t L>
+template <uint32_t B, uint32_t N, uint32_t L, uint32_t S>
 class DataInCache;
 
 //Definition of input data cache types
 typedef DataInCache<cgra::cDataValueBitwidth,
         2 * cgra::cPeLevels.front(),
-        cgra::cNumberDataInCacheLines
+        cgra::cNumberDataInCacheLines,
+        cgra::cDataStreamBitWidthDataCaches
         > data_input_cache_type_t;
 //!< \brief Type definition for the input data cache of a VCGRA
 
@@ -48,12 +49,18 @@ typedef DataInCache<cgra::cDataValueBitwidth,
  * The selected cache line is linked in parallel to the first virtual
  * channel.
  *
+ * In burst mode (MMU_BURST_WIDTH) the serial interface is S bits wide and
+ * transports S/B values. If the burst input is set, all values of the data
+ * stream are stored beginning at the selected place (value 0 in the least
+ * significant bits). Otherwise, only the first value is stored.
+ *
  * \tparam B Bitwidth for a single integer value (with respect to VirtualChannel data bitwidth)
  * \tparam N Number of data values in a data cache line
  * \tparam L Number of cache lines
+ * \tparam S Bitwidth of the serial interface (multiple of B)
  *
  */
-template <uint32_t B, uint32_t N, uint32_t L = 2>
+template <uint32_t B, uint32_t N, uint32_t L = 2, uint32_t S = B>
 class DataInCache : public sc_core::sc_module
 #ifdef MCPAT
     ,                protected cgra::McPatCacheAccessCounter
@@ -68,11 +75,11 @@ public:
     //!< \brief Type for line selector
     typedef cgra::cache_write_type_t write_enable_type_t;
     //!< \brief Type for write enable signal
-    typedef sc_dt::sc_lv<B> stream_type_t;
+    typedef sc_dt::sc_lv<S> stream_type_t;
     //!< \brief Type for streaming input data to fill cache line
     typedef cgra::cache_ack_type_t ack_type_t;
     //!< \brief Acknowledge data type
-    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfValuesPerCacheLine)> select_value_type_t;
+    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfPlacesPerCacheLine)> select_value_type_t;
     //!< \brief Select cache place in cache line to store data
 
 #ifndef GSYSC
@@ -89,6 +96,10 @@ public:
     //!< \brief Select current cache place for to store value at data in stream
     sc_core::sc_in<select_lines_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for current-data set
+#ifdef MMU_BURST_WIDTH
+    sc_core::sc_in<bool> burst{"burst"};
+    //!< \brief Store all values of the data stream beginning at the selected place
+#endif
     std::array<sc_core::sc_out<value_type_t>, N> currentValues;
     //!< \brief Currently set values to process
     sc_core::sc_out<ack_type_t> ack{"acknowledge"};
@@ -107,6 +118,10 @@ public:
     //!< \brief Select current cache place for to store value at data in stream
     sc_in<select_lines_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for current-data set
+#ifdef MMU_BURST_WIDTH
+    sc_in<bool> burst{"burst"};
+    //!< \brief Store all values of the data stream beginning at the selected place
+#endif
     std::array<sc_out<value_type_t>, N> currentValues;
     //!< \brief Currently set values to process
     sc_out<ack_type_t> ack{"acknowledge"};
@@ -176,8 +191,18 @@ public:
         else if (write.read() && !ack.read()) {
             // Check if selected cache line is currently in use
             if (slt_in.read().to_uint() != slt_out.read().to_uint()) {
+#ifndef MMU_BURST_WIDTH
                 auto &value = m_cacheLines[slt_in.read().to_uint()][slt_place.read().to_uint()];
                 value.write(dataInStream.read());
+#else
+                auto &line = m_cacheLines[slt_in.read().to_uint()];
+                const auto t_stream = dataInStream.read();
+                const uint32_t t_numOfValues = burst.read() ? S / B : 1;
+                for (uint32_t idx = 0; t_numOfValues > idx && N > slt_place.read().to_uint() + idx; ++idx) {
+                    line[slt_place.read().to_uint() + idx].write(
+                        sc_dt::sc_lv<B>{t_stream.range(B * idx + B - 1, B * idx)});
+                }
+#endif
                 ack.write(true);
             }
             else {
@@ -249,7 +274,7 @@ public:
         os << name() << ": " << kind() << std::endl;
         os << "Number of cache lines:\t\t\t" << std::setw(3) << static_cast<uint32_t>(L) << std::endl;
         os << "Cache line length[#bytes]:\t\t" << std::setw(3) << static_cast<uint32_t>(size()) << std::endl;
-        os << "Bitwidth serial input:\t\t\t" << std::setw(3) << static_cast<uint32_t>(B) << std::endl;
+        os << "Bitwidth serial input:\t\t\t" << std::setw(3) << static_cast<uint32_t>(S) << std::endl;
         os << "Number of places per line:\t\t" << std::setw(3) << static_cast<uint32_t>(N) << std::endl;
         os << "Selected input cache line:\t\t" << std::setw(3) << slt_in.read().to_string(sc_dt::SC_DEC, false) << std::endl;
         os << "Selected cache line place:\t\t" << std::setw(3) << slt_place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
@@ -339,6 +364,8 @@ private:
     //!< \brief Two-dimensional array, where 1st. dimension is cache line and 2nd. dimension is value
     const uint32_t m_numOfBytes{cgra::calc_numOfBytes(B * N)};
     //!< \brief Cache line size in bytes
+
+    static_assert(0 == S % B, "Serial interface needs to transport an integer number of values");
 };
 
 } // namespace cgra
@@ -22,13 +22,14 @@
 namespace cgra {
 
 //Forward declaration of DataCache class
-template <uint32_t B, uint32_t N, uint32_t L>
+template <uint32_t B, uint32_t N, uint32_t L, uint32_t S>
 class DataOutCache;
 
 //Definition of output data cache types
 typedef DataOutCache<cgra::cDataValueBitwidth,
         cgra::cPeLevels.back(),
-        cgra::cNumberDataOutCacheLines
+        cgra::cNumberDataOutCacheLines,
+        cgra::cDataStreamBitWidthDataCaches
         > data_output_cache_type_t;
 //!< \brief Type definition for the input data cache of a VCGRA
 
@@ -48,12 +49,19 @@ typedef DataOutCache<cgra::cDataValueBitwidth,
  * last PE level in the VCGRA instance. A value is transmitted into
  * shared memory via a serial interface; speed: one value per clock cycle.
  *
+ * In burst mode (MMU_BURST_WIDTH) the serial interface is S bits wide. If
+ * the burst input is set, S/B consecutive values beginning at the selected
+ * place are transmitted at once (value 0 in the least significant bits,
+ * places beyond the cache line are zero). Otherwise, only the selected value
+ * is transmitted.
+ *
  * \tparam B Bitwidth for a single integer value (with respect to VirtualChannel data bitwidth)
  * \tparam N Number of data values in a data cache line
  * \tparam L Number of cache lines
+ * \tparam S Bitwidth of the serial interface (multiple of B)
  *
  */
-template <uint32_t B, uint32_t N, uint32_t L = 2>
+template <uint32_t B, uint32_t N, uint32_t L = 2, uint32_t S = B>
 class DataOutCache : public sc_core::sc_module
 #ifdef MCPAT
     ,                protected cgra::McPatCacheAccessCounter
@@ -68,13 +76,13 @@ public:
     //!< \brief Type for line selector
     typedef cgra::cache_load_type_t load_enable_type_t;
     //!< \brief Type for load signal
-    typedef sc_dt::sc_lv<B> stream_type_t;
+    typedef sc_dt::sc_lv<S> stream_type_t;
     //!< \brief Type for streaming a value to shared memory
     typedef cgra::cache_ack_type_t ack_type_t;
     //!< \brief Acknowledge data type
     typedef bool update_type_t;
     //!< \brief Data type for update of input values
-    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfValuesPerCacheLine)> select_value_type_t;
+    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cgra::cMaxNumberOfPlacesPerCacheLine)> select_value_type_t;
     //!< \brief Select cache place in cache line to process data
 
 #ifndef GSYSC
@@ -93,6 +101,10 @@ public:
     //!< \brief Select current cache place for data out stream
     sc_core::sc_in<select_lines_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for data out stream.
+#ifdef MMU_BURST_WIDTH
+    sc_core::sc_in<bool> burst{"burst"};
+    //!< \brief Transmit all values of the data stream beginning at the selected place
+#endif
     sc_core::sc_out<stream_type_t> dataOutStream{"data_out_stream"};
     //!< \brief Data stream to shared memory
     sc_core::sc_out<ack_type_t> ack{"acknowledge"};
@@ -113,6 +125,10 @@ public:
     //!< \brief Select current cache place for data out stream
     sc_in<select_lines_type_t> slt_out{"data_out_cache_line"};
     //!< \brief Select current cache line for data out stream.
+#ifdef MMU_BURST_WIDTH
+    sc_in<bool> burst{"burst"};
+    //!< \brief Transmit all values of the data stream beginning at the selected place
+#endif
     sc_out<stream_type_t> dataOutStream{"data_out_stream"};
     //!< \brief Data stream to shared memory
     sc_out<ack_type_t> ack{"acknowledge"};
@@ -188,8 +204,18 @@ public:
         else if(load.read() && !ack.read())
         {
             //Check if selected cache line is currently in use
+#ifndef MMU_BURST_WIDTH
             auto* tvalue = &m_cacheLines[slt_out.read().to_uint()][slt_place.read().to_uint()];
             dataOutStream.write(tvalue->read());
+#else
+            const auto& t_line = m_cacheLines[slt_out.read().to_uint()];
+            const uint32_t t_numOfValues = burst.read() ? S / B : 1;
+            stream_type_t t_stream{0};
+            for (uint32_t idx = 0; t_numOfValues > idx && N > slt_place.read().to_uint() + idx; ++idx) {
+                t_stream.range(B * idx + B - 1, B * idx) = t_line[slt_place.read().to_uint() + idx].read();
+            }
+            dataOutStream.write(t_stream);
+#endif
             ack.write(true);
         }
         else if (ack.read() && !load.read()){
@@ -279,7 +305,7 @@ public:
         os << name() << "\t\t" << kind() << std::endl;
         os << "Number of cache lines:\t\t\t" << std::setw(3) << static_cast<uint32_t>(L) << std::endl;
         os << "Cache line length[#bytes]:\t\t" << std::setw(3) << static_cast<uint32_t>(size()) << std::endl;
-        os << "Bitwidth serial output:\t\t\t" << std::setw(3) << static_cast<uint32_t>(B) << std::endl;
+        os << "Bitwidth serial output:\t\t\t" << std::setw(3) << static_cast<uint32_t>(S) << std::endl;
         os << "Number of places per line:\t\t" << std::setw(3) << static_cast<uint32_t>(N) << std::endl;
         os << "Selected input cache line:\t\t" << std::setw(3) << slt_in.read().to_string(sc_dt::SC_DEC, false) << std::endl;
         os << "Selected cache line place:\t\t" << std::setw(3) << slt_place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
@@ -369,6 +395,8 @@ private:
     //!< \brief Number of current cache line for new input values (slt_in)
     const uint32_t m_numOfBytes{cgra::calc_numOfBytes(B * N)};
     //!< \brief Cache line size in bytes
+
+    static_assert(0 == S % B, "Serial interface needs to transport an integer number of values");
 };
 
 } //End namespace CGRA
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <array>
+#include "Typedef.h"
 
 #ifdef GSYSC
 #include <gsysc.h>
@@ -37,7 +38,7 @@ class Demultiplexer : public sc_core::sc_module {
 public:
     typedef T config_type_t;
     //!< \brief Type of input configuration vector
-    typedef sc_dt::sc_lv<L / N> configpart_type_t;
+    typedef cgra::config_vector_t<L / N> configpart_type_t;
     //!< \brief Select type for Demultiplexer input signals
 #ifndef GSYSC
     //Entity ports:
@@ -0,0 +1,217 @@
+/*
+ * FeedbackRegisters.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef FEEDBACK_REGISTERS_H_
+#define FEEDBACK_REGISTERS_H_
+
+#include <systemc>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <array>
+#include <algorithm>
+#include "Typedef.h"
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+namespace cgra {
+
+/*!
+ * \class FeedbackRegisters
+ *
+ * \brief Register file which keeps the results of the last VCGRA invocations
+ *
+ * \details
+ * The register file is attached to the data outputs of the last PE level.
+ * On every rising edge of the VCGRA ready signal, the registers of all
+ * invocations are shifted by one and the current results are stored.
+ * Feedback output a * N + o holds data output o of the a-th last invocation
+ * (a = 0 is the most recent one).
+ *
+ * With PIPELINED_PE, ready is high for one clock cycle per result vector
+ * and stays high while vectors are streamed back to back. Thus, the
+ * results are stored on every clock edge at which ready is high.
+ *
+ * The data outputs are registered one clock cycle before ready is observed,
+ * because the Synchronizer raises ready one cycle after the valid signals.
+ *
+ * \tparam T Data type of the VCGRA data outputs
+ * \tparam N Number of VCGRA data outputs
+ * \tparam D Number of stored invocations
+ */
+template <typename T, uint32_t N, uint32_t D>
+class FeedbackRegisters : public sc_core::sc_module
+{
+public:
+    typedef T data_type_t;
+    //!< \brief Type of stored values
+    typedef cgra::clock_type_t clock_type_t;
+    //!< \brief Clock type
+    typedef cgra::reset_type_t reset_type_t;
+    //!< \brief Reset type
+    typedef cgra::ready_type_t ready_type_t;
+    //!< \brief Type of VCGRA ready signal
+
+#ifndef GSYSC
+    //Entity ports
+    sc_core::sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock port
+    sc_core::sc_in<reset_type_t> rst{"rst"};
+    //!< \brief Clear all registers if rst equals false
+    sc_core::sc_in<ready_type_t> ready{"ready"};
+    //!< \brief Ready signal of the VCGRA Synchronizer
+    std::array<sc_core::sc_in<data_type_t>, N> data_inputs;
+    //!< \brief Data outputs of the last PE level
+    std::array<sc_core::sc_out<data_type_t>, N * D> feedback_outputs;
+    //!< \brief Stored results, connected to the input VirtualChannel
+#else
+    //Entity ports
+    sc_in<clock_type_t> clk{"clk"};
+    //!< \brief Clock port
+    sc_in<reset_type_t> rst{"rst"};
+    //!< \brief Clear all registers if rst equals false
+    sc_in<ready_type_t> ready{"ready"};
+    //!< \brief Ready signal of the VCGRA Synchronizer
+    std::array<sc_in<data_type_t>, N> data_inputs;
+    //!< \brief Data outputs of the last PE level
+    std::array<sc_out<data_type_t>, N * D> feedback_outputs;
+    //!< \brief Stored results, connected to the input VirtualChannel
+#endif
+
+    SC_HAS_PROCESS(FeedbackRegisters);
+    /*!
+     * \brief General Constructor
+     *
+     * \param[in] nameA Name of the FeedbackRegisters as a SystemC Module
+     */
+    FeedbackRegisters(const sc_core::sc_module_name& nameA) : sc_core::sc_module(nameA)
+#ifdef MCPAT
+    ,m_totalCycles{0U}, m_writeAccesses{0U}
+#endif
+    {
+        SC_METHOD(capture);
+        sensitive << clk.pos();
+    }
+
+    /*!
+     * \brief Initialize outputs of the register file
+     */
+    virtual void end_of_elaboration() override
+    {
+        m_registers.fill(0);
+        m_sampledInputs.fill(0);
+        for (auto& out : feedback_outputs)
+            out.write(0);
+    }
+
+    /*!
+     * \brief Print kind of SystemC-module
+     */
+    virtual const char* kind() const override {
+        return "Feedback Registers";
+    }
+
+    /*!
+     * \brief Dump stored values
+     *
+     * \param[out] os Define used outstream [default: std::cout]
+     */
+    virtual void dump(std::ostream& os = ::std::cout) const override
+    {
+        os << name() << "\t\t" << kind() << "\n";
+        for (uint32_t t_age = 0; D > t_age; ++t_age)
+        {
+            os << "Invocation -" << t_age << ":\t";
+            for (uint32_t t_output = 0; N > t_output; ++t_output)
+                os << std::setw(7) << m_registers[t_age * N + t_output];
+            os << "\n";
+        }
+        os << std::endl;
+    }
+
+#ifdef MCPAT
+    /**
+     * \brief Dump runtime statistics for McPAT simulation
+     *
+     * \param os Define used outstream [default: std::cout]
+     */
+    void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
+    {
+        os << name() << "\t\t" << kind() << "\n";
+        os << "total cycles: " << m_totalCycles << "\n";
+        os << "write accesses: " << m_writeAccesses << "\n";
+        os << std::endl;
+    }
+#endif
+
+    /*!
+     * \brief Store the results of an invocation on the rising edge of ready (every ready cycle with PIPELINED_PE)
+     */
+    void capture()
+    {
+#ifdef MCPAT
+        ++m_totalCycles;
+#endif
+        bool t_update{false};
+        if (!rst.read())
+        {
+            m_registers.fill(0);
+            t_update = true;
+        }
+#ifdef PIPELINED_PE
+        else if (ready.read())
+#else
+        else if (ready.read() && !m_readyBefore)
+#endif
+        {
+            std::copy_backward(m_registers.cbegin(), m_registers.cend() - N, m_registers.end());
+            std::copy(m_sampledInputs.cbegin(), m_sampledInputs.cend(), m_registers.begin());
+            t_update = true;
+#ifdef MCPAT
+            ++m_writeAccesses;
+#endif
+        }
+        m_readyBefore = !rst.read() || ready.read();
+
+        for (uint32_t i = 0; N > i; ++i)
+            m_sampledInputs[i] = data_inputs[i].read();
+
+        if (t_update)
+        {
+            for (uint32_t i = 0; N * D > i; ++i)
+                feedback_outputs[i].write(m_registers[i]);
+        }
+    }
+
+    /*!
+     * \brief Defaulted Destructor
+     */
+    virtual ~FeedbackRegisters() = default;
+
+private:
+    FeedbackRegisters() = delete;
+    FeedbackRegisters(const FeedbackRegisters& src) = delete;              //!< \brief because sc_module could not be copied
+    FeedbackRegisters& operator=(const FeedbackRegisters& src) = delete;   //!< \brief because move not implemented for sc_module
+    FeedbackRegisters(FeedbackRegisters&& src) = delete;                   //!< \brief because sc_module could not be copied
+    FeedbackRegisters& operator=(FeedbackRegisters&& src) = delete;        //!< \brief because move not implemented for sc_module
+
+    std::array<data_type_t, N * D> m_registers;
+    //!< \brief Stored results, index a * N + o
+    std::array<data_type_t, N> m_sampledInputs;
+    //!< \brief Data inputs at the previous clock edge
+    bool m_readyBefore{true};
+    //!< \brief Ready at the previous clock edge, the initial ready of a VCGRA is high
+#ifdef MCPAT
+    uint32_t m_totalCycles;     //!< \brief Count total number of executed cycles
+    uint32_t m_writeAccesses;   //!< \brief Count number of stored invocations
+#endif
+};
+
+} //end namespace cgra
+
+#endif // FEEDBACK_REGISTERS_H_
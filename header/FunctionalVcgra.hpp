@@ -0,0 +1,264 @@
+/*
+ * FunctionalVcgra.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef FUNCTIONAL_VCGRA_H_
+#define FUNCTIONAL_VCGRA_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <iostream>
+#include "Typedef.h"
+#include "PeDatapath.h"
+
+namespace cgra
+{
+
+/*!
+ * \class FunctionalVcgra
+ *
+ * \brief Untimed functional model of a configured VCGRA
+ *
+ * \details
+ * The functional model decodes the PE and VirtualChannel configuration
+ * bitstreams with the same bit layout as the Demultiplexer, the Selectors
+ * and VirtualChannel::split_select of a VCGRA instance. The configuration
+ * is translated into a flat dataflow graph which only contains the PEs
+ * that produce a valid result. The graph is executed directly on integer
+ * arrays without any SystemC simulation.
+ *
+ * The results are bit-identical to the cycle-accurate VCGRA with the
+ * NativeDatapath (PackedDatapath with PACKED_DATAPATH). Outputs of PEs which never become valid are reported
+ * as zero, see outputValid().
+ *
+ * Configurations are byte streams with the most significant byte first,
+ * i.e. the format used by the testbenches and the shared memory.
+ *
+ * The accumulators of MAC operations keep their values between input
+ * vectors and calls like the PE registers. They are cleared by configure()
+ * and resetAccumulators(). Thus, evaluate() and evaluateBatch() change the
+ * state of the model and each thread needs its own model.
+ *
+ * With PE_IMMEDIATES, the immediate operands of the PEs are stored behind
+ * the PE results within the value vector. They are always valid.
+ *
+ * With FEEDBACK_REGISTERS, the feedback registers follow the immediate
+ * operands. Like in the VCGRA, they store the data outputs of the last
+ * cFeedbackDepth input vectors if the Synchronizer raises ready and keep
+ * their values if the configuration changes. Outputs which never become
+ * valid are stored as zero. Use feedbackRegisters() and
+ * loadFeedbackRegisters() to continue with a model of another configuration.
+ */
+class FunctionalVcgra
+{
+public:
+#ifdef PACKED_DATAPATH
+    typedef cgra::PackedDatapath<cgra::cPeDataBitwidth, cgra::cPeDataBitwidth, cgra::cPackedLanes,
+                                 cgra::cPackedUnsignedLanes> datapath_type_t;
+#else
+    typedef cgra::NativeDatapath<cgra::cPeDataBitwidth, cgra::cPeDataBitwidth> datapath_type_t;
+#endif
+    //!< \brief Datapath to process PE operations
+    typedef typename datapath_type_t::operand_type_t value_type_t;
+    //!< \brief Type of input and output values
+
+    static constexpr uint32_t cNumOfInputs{cgra::cInputChannel_NumOfInputs};
+    //!< \brief Number of values of an input vector
+    static constexpr uint32_t cNumOfOutputs{cgra::cPeLevels.back()};
+    //!< \brief Number of values of an output vector
+#ifdef PE_IMMEDIATES
+    static constexpr uint32_t cNumOfConstants{cgra::cNumOfPe};
+#else
+    static constexpr uint32_t cNumOfConstants{0};
+#endif
+    //!< \brief Number of immediate operands within the value vector
+    static constexpr uint32_t cNumOfFeedbackRegisters{cgra::cNumOfFeedbackRegisters};
+    //!< \brief Number of feedback registers within the value vector
+    static constexpr uint32_t cFeedbackStart{cNumOfInputs + cgra::cNumOfPe + cNumOfConstants};
+    //!< \brief Index of the first feedback register within the value vector
+    static constexpr uint32_t cNumOfValues{cFeedbackStart + cNumOfFeedbackRegisters};
+    //!< \brief Length of the value vector: data inputs, PE results, immediate operands and feedback registers
+
+    typedef std::array<value_type_t, cNumOfFeedbackRegisters> feedback_registers_t;
+    //!< \brief Values of all feedback registers, index age * cNumOfOutputs + output
+
+    /*!
+     * \struct Node
+     *
+     * \brief Operation of one PE within the dataflow graph
+     */
+    struct Node
+    {
+        uint8_t operation;
+        //!< \brief Configured PE operation
+        uint16_t result;
+        //!< \brief Index of the result within the value vector
+        uint16_t operands[2];
+        //!< \brief Indices of both operands within the value vector
+    };
+
+    /*!
+     * \brief Create an unconfigured functional model
+     */
+    FunctionalVcgra() = default;
+
+    /*!
+     * \brief Create a functional model for a configuration
+     *
+     * \param[in] peConfigA PE configuration as byte stream
+     * \param[in] chConfigA VirtualChannel configuration as byte stream
+     */
+    FunctionalVcgra(const std::vector<uint8_t>& peConfigA, const std::vector<uint8_t>& chConfigA);
+
+    /*!
+     * \brief Decode a new configuration
+     *
+     * \param[in] peConfigA PE configuration as byte stream
+     * \param[in] chConfigA VirtualChannel configuration as byte stream
+     *
+     * \throw std::invalid_argument if a Multiplexer selects a non-existing input
+     */
+    void configure(const std::vector<uint8_t>& peConfigA, const std::vector<uint8_t>& chConfigA);
+
+    /*!
+     * \brief Process one input vector
+     *
+     * \param[in] inputsA   cNumOfInputs input values
+     * \param[out] outputsA cNumOfOutputs result values
+     */
+    void evaluate(const value_type_t* inputsA, value_type_t* outputsA);
+
+    /*!
+     * \brief Process a batch of input vectors
+     *
+     * \param[in] inputsA       numVectorsA x cNumOfInputs input values (row-major)
+     * \param[out] outputsA     numVectorsA x cNumOfOutputs result values (row-major)
+     * \param[in] numVectorsA   Number of input vectors
+     */
+    void evaluateBatch(const value_type_t* inputsA, value_type_t* outputsA, std::size_t numVectorsA);
+
+    /*!
+     * \brief Clear the accumulators of all MAC operations
+     */
+    void resetAccumulators() { m_accumulators.fill(0); }
+
+    /*!
+     * \brief Access the feedback registers
+     */
+    const feedback_registers_t& feedbackRegisters() const { return m_feedback; }
+
+    /*!
+     * \brief Overwrite the feedback registers, e.g. with the registers of another model
+     *
+     * \param[in] registersA New values of the feedback registers
+     */
+    void loadFeedbackRegisters(const feedback_registers_t& registersA) { m_feedback = registersA; }
+
+    /*!
+     * \brief Check if the configuration reads feedback registers
+     */
+    bool readsFeedback() const { return m_readsFeedback; }
+
+    /*!
+     * \brief Check if a result of the last PE level becomes valid
+     *
+     * \param[in] outputA Index of the VCGRA data output
+     */
+    bool outputValid(uint32_t outputA) const { return m_outputValid.at(outputA); }
+
+    /*!
+     * \brief Check if the Synchronizer of the VCGRA raises ready
+     */
+    bool ready() const { return m_ready; }
+
+    /*!
+     * \brief Access the decoded dataflow graph in topological order
+     */
+    const std::vector<Node>& nodes() const { return m_nodes; }
+
+    /*!
+     * \brief Access the immediate operands, indexed by PE
+     *
+     * \details
+     * The immediate operand of PE p is located at index
+     * cNumOfInputs + cNumOfPe + p of the value vector.
+     */
+    const std::array<value_type_t, cNumOfPe>& constants() const { return m_constants; }
+
+    /*!
+     * \brief Print the decoded dataflow graph
+     *
+     * \param[out] os Define used outstream [default: std::cout]
+     */
+    void dump(std::ostream& os = ::std::cout) const;
+
+    /*!
+     * \brief Execute one PE operation
+     *
+     * \details
+     * MAC requires an accumulator and returns zero, see accumulate().
+     *
+     * \param[in] operationA Operation code of the PE
+     * \param[in] aA First operand
+     * \param[in] bA Second operand
+     */
+    static value_type_t execute(uint8_t operationA, value_type_t aA, value_type_t bA);
+
+    /*!
+     * \brief Execute a MAC operation
+     *
+     * \param[in,out] accA Accumulator of the PE
+     * \param[in] aA First operand
+     * \param[in] bA Second operand
+     * \return New accumulator value
+     */
+    static value_type_t accumulate(value_type_t& accA, const value_type_t aA, const value_type_t bA)
+    {
+        accA = datapath_type_t::mac(accA, aA, bA);
+        return accA;
+    }
+
+    /*!
+     * \brief Store the results of an input vector in the feedback registers
+     *
+     * \param[in,out] registersA    Feedback registers
+     * \param[in] outputsA          First data output of the input vector
+     * \param[in] strideA           Distance between two data outputs of the input vector
+     */
+    static void storeFeedback(feedback_registers_t& registersA, const value_type_t* outputsA, const std::size_t strideA)
+    {
+        if (0 == cNumOfFeedbackRegisters)
+            return;
+
+        std::copy_backward(registersA.begin(), registersA.end() - cNumOfOutputs, registersA.end());
+        for (uint32_t t_output = 0; cNumOfOutputs > t_output; ++t_output)
+            registersA[t_output] = outputsA[t_output * strideA];
+    }
+
+private:
+    std::vector<Node> m_nodes;
+    //!< \brief PEs which produce valid results in topological order
+    std::vector<bool> m_outputValid = std::vector<bool>(cNumOfOutputs, false);
+    //!< \brief Valid status of each VCGRA data output
+    std::vector<uint16_t> m_outputs = std::vector<uint16_t>(cNumOfOutputs, 0);
+    //!< \brief Indices of the VCGRA data outputs within the value vector
+    bool m_ready{false};
+    //!< \brief Synchronizer raises ready for the current configuration
+    bool m_readsFeedback{false};
+    //!< \brief A PE of the first level reads a feedback register
+    std::array<value_type_t, cNumOfPe> m_accumulators{};
+    //!< \brief Accumulators of MAC operations, indexed by PE
+    std::array<value_type_t, cNumOfPe> m_constants{};
+    //!< \brief Immediate operands, indexed by PE
+    feedback_registers_t m_feedback{};
+    //!< \brief Results of the last input vectors
+};
+
+} // namespace cgra
+
+#endif // FUNCTIONAL_VCGRA_H_
@@ -15,6 +15,10 @@
 #include <cstring>
 #include "Typedef.h"
 #include "CommandInterpreter.h"
+#include "SharedMemory.hpp"
+#ifdef COMPRESSED_CONFIG
+#include "ConfigCompression.hpp"
+#endif
 
 namespace cgra
 {
@@ -26,6 +30,24 @@ namespace cgra
  *
  * \details
  *
+ * With PACKED_DATAPATH, a value of the data caches contains cPackedLanes
+ * sub-word lanes. The MMU packs lane l of a data input value from the l-th
+ * of cPackedLanes consecutive values in shared memory (saturated to the
+ * range of a lane) and stores the lanes of data output values sign extended
+ * (zero extended with PACKED_UNSIGNED) in the same way. Thus, the memory
+ * layout of data values is unchanged, but a data cache value covers
+ * cPackedLanes values in shared memory.
+ *
+ * With PARTIAL_RECONFIGURATION, a configuration transmission with a place
+ * other than 127 loads a segment of "segment" consecutive bytes from shared
+ * memory into the configuration cache line, beginning at the selected place.
+ *
+ * With COMPRESSED_CONFIG, a configuration cache line can be loaded from a
+ * compressed configuration (see compressConfiguration()) if "compressed" is
+ * set. The MMU streams the compressed bytes unchanged, the first byte is the
+ * most significant byte of a stream and the last stream is padded with
+ * no-operation packets. A ConfigurationDecompressor in front of the
+ * configuration cache restores the configuration.
  */
 class MMU : public sc_core::sc_module
 {
@@ -38,7 +60,7 @@ public:
     //!< \brief Start processing using data at address, line, cache select and place port
     typedef cgra::cache_slct_type_t cache_select_type_t;
     //!< \brief MMU selection type for available caches
-    typedef CommandInterpreter::address_type_t address_type_t;
+    typedef cgra::memory_address_type_t address_type_t;
     //!< \brief MMU address type for shared memory data location
     typedef CommandInterpreter::place_type_t place_type_t;
     //!< \brief MMU place type for data position in cache line of target/source cache
@@ -48,9 +70,9 @@ public:
     //!< \brief Cache transmission write enable type
     typedef sc_dt::sc_lv<cgra::cDataStreamBitWidthConfCaches> conf_stream_type_t;
     //!< \brief Configuration data stream type
-    typedef sc_dt::sc_lv<cgra::cDataValueBitwidth> data_stream_type_t;
+    typedef sc_dt::sc_lv<cgra::cDataStreamBitWidthDataCaches> data_stream_type_t;
     //!< \brief Value data stream type
-    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cMaxNumberOfValuesPerCacheLine)> cache_place_type_t;
+    typedef sc_dt::sc_uint<cgra::calc_bitwidth(cMaxNumberOfPlacesPerCacheLine)> cache_place_type_t;
     //!< \brief Data type for place signal lines to data caches
 
 #ifndef GSYSC
@@ -58,6 +80,14 @@ public:
     //!< \brief Shared memory address to load from/store to data
     sc_core::sc_in<place_type_t> place{"Place"};
     //!< \brief Cache line place in target cache
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_in<place_type_t> segment{"Segment"};
+    //!< \brief Number of configuration bytes loaded beginning at place (place != 127)
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_core::sc_in<bool> compressed{"Compressed"};
+    //!< \brief Configuration cache line is loaded from a compressed configuration
+#endif
     sc_core::sc_in<cache_select_type_t> cache_select{"Cache_Select"};
     //!< \brief Cache selection for latest operation
     sc_core::sc_in<start_type_t> start{"Start"};
@@ -76,6 +106,10 @@ public:
     //!< \brief Data value in stream from data output caches of VCGRA
     sc_core::sc_out<cache_place_type_t> cache_place{"Slct_Cache_Place"};
     //!< \brief Selected Cache place in data input/output caches.
+#ifdef MMU_BURST_WIDTH
+    sc_core::sc_out<bool> burst{"Burst"};
+    //!< \brief Data caches use all values of a data stream (block transmission)
+#endif
     sc_core::sc_in<clock_type_t> clk{"clock"};
     //!< \brief System clock input
 #else
@@ -83,6 +117,14 @@ public:
     //!< \brief Shared memory address to load from/store to data
     sc_in<place_type_t> place{"Place"};
     //!< \brief Cache line place in target cache
+#ifdef PARTIAL_RECONFIGURATION
+    sc_in<place_type_t> segment{"Segment"};
+    //!< \brief Number of configuration bytes loaded beginning at place (place != 127)
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_in<bool> compressed{"Compressed"};
+    //!< \brief Configuration cache line is loaded from a compressed configuration
+#endif
     sc_in<cache_select_type_t> cache_select{"Cache_Select"};
     //!< \brief Cache selection for latest operation
     sc_in<start_type_t> start{"Start"};
@@ -101,6 +143,10 @@ public:
     //!< \brief Data value in stream from data output caches of VCGRA
     sc_out<cache_place_type_t> cache_place{"Slct_Cache_Place"};
     //!< \brief Selected Cache place in data input/output caches.
+#ifdef MMU_BURST_WIDTH
+    sc_out<bool> burst{"Burst"};
+    //!< \brief Data caches use all values of a data stream (block transmission)
+#endif
     sc_in<clock_type_t> clk{"clock"};
     //!< \brief System clock input
 #endif
@@ -134,7 +180,7 @@ public:
      */
     MMU(const sc_core::sc_module_name& nameA, std::initializer_list<uint16_t> cacheFeaturesA );
 
-    virtual ~MMU();
+    virtual ~MMU() = default;
     //!< \brief Destructor
 
     /*!
@@ -241,6 +287,14 @@ private:
      * bitwidth of the streaming interfaces.
      */
     typedef uint8_t memory_size_type_t;
+    static constexpr uint16_t cDataValueSize{cgra::cDataValueBitwidth / (8 * sizeof(memory_size_type_t))};
+    //!< \brief Number of memory lines of a data value in shared memory
+    static constexpr uint16_t cDataValueMemorySize{cgra::cPackedLanes * cDataValueSize};
+    //!< \brief Number of memory lines covered by a data cache value (cPackedLanes data values)
+#ifdef MMU_BURST_WIDTH
+    static constexpr uint16_t cBurstSize{cgra::cMmuBurstWidth / (8 * sizeof(memory_size_type_t))};
+    //!< \brief Number of memory lines transferred with a full burst
+#endif
 
     //Private Members
     enum CACHE_TYPE pCurrentCache{CACHE_TYPE::NONE};
@@ -258,12 +312,8 @@ private:
     //!< \brief Cache line place in target cache (input buffer)
     sc_core::sc_buffer<cache_place_type_t> pPlaceOut{"CurrentPlace_OutputBuffer"};
     //!< \brief Cache line place in target cache (output buffer)
-    memory_size_type_t* const pMemStartPtr{static_cast<memory_size_type_t*>(calloc(cgra::cMemorySize, sizeof(memory_size_type_t)))};
-    //!< \brief Start address of shared memory block.
-    memory_size_type_t* const pMemEndPtr{pMemStartPtr+cgra::cMemorySize - 1};
-    //!< \brief End address of shared memory block.
-    memory_size_type_t* pCurrentMemPtr;
-    //!< \brief Actual position in shared memory block.
+    SharedMemory pMemory{cgra::cMemorySize};
+    //!< \brief Shared memory block, pages are allocated on the first write access.
 
     /*!
      * \brief Flag for block transmissions of whole cache lines.
@@ -278,6 +328,24 @@ private:
     //!< \brief This is the number of open required transmissions to complete transmission process.
     uint16_t pAddressStepSize{0};
     //!< \brief This is the step size for address adaption in block transfers.
+#ifdef PARTIAL_RECONFIGURATION
+    uint16_t pSegmentLength{1};
+    //!< \brief Number of configuration bytes of the current segment transmission
+#endif
+#ifdef COMPRESSED_CONFIG
+    bool pCompressed{false};
+    //!< \brief Current configuration transmission streams a compressed configuration
+    uint64_t pCompressedBytes{0};
+    //!< \brief Total number of compressed configuration bytes read from shared memory
+#endif
+#ifdef MMU_BURST_WIDTH
+    uint16_t pRemainingSize{0};
+    //!< \brief Number of memory lines left to transfer in the current transmission sequence
+    uint16_t pBurstLength{0};
+    //!< \brief Number of memory lines transferred with the current burst
+    uint16_t pPlaceStepSize{1};
+    //!< \brief Number of cache places covered by one burst
+#endif
 
     /*! Definition for cache properties to ease the access. */
     enum FEATURE_SELECT : uint8_t
@@ -309,8 +377,16 @@ private:
     //!< \brief Handle data transmission to data input cache
     void process_configuration();
     //!< \brief Handle data transmission to configuration caches
+#ifdef COMPRESSED_CONFIG
+    void process_compressed_configuration();
+    //!< \brief Handle data transmission of a compressed configuration to configuration caches
+#endif
     void process_data_output();
     //!< \brief Handle data transmission from data output cache
+    sc_dt::int_type load_data_value(uint64_t addressA) const;
+    //!< \brief Read a data cache value from shared memory (packs lanes with PACKED_DATAPATH)
+    void store_data_value(uint64_t addressA, sc_dt::int_type valueA);
+    //!< \brief Write a data cache value to shared memory (unpacks lanes with PACKED_DATAPATH)
 
 #ifdef MCPAT
     //McPAT dynamic statistic counters:
@@ -329,8 +405,8 @@ inline void cgra::MMU::dump_memory(const uint32_t startAddrA,
         std::ostream& os) const
 {
 
-    //Set temporary pointer to access memory data.
-    memory_size_type_t* tMemPtr = pMemStartPtr + startAddrA;
+    //Address of the next dumped element
+    uint64_t tAddress{startAddrA};
 
     if(!(formatA == sc_dt::SC_OCT || formatA == sc_dt::SC_DEC || \
             formatA == sc_dt::SC_HEX || formatA == sc_dt::SC_NOBASE))
@@ -339,30 +415,33 @@ inline void cgra::MMU::dump_memory(const uint32_t startAddrA,
 
     //Count number of printed elements in a row. Insert line break after 8 dumped elements.
     uint16_t tLinecounter{0};
-    while(tMemPtr <= pMemEndPtr && tMemPtr <= (pMemStartPtr + endAddrA))
+    while(tAddress < cgra::cMemorySize && tAddress <= endAddrA)
     {
+        T tValue{};
+        pMemory.read(tAddress, &tValue, sizeof(T));
+
         switch (formatA)
         {
             case sc_dt::SC_OCT:
                 if(showBaseA)
-                    os << std::oct << std::showbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::oct << std::showbase << tValue;
                 else
-                    os << std::oct << std::noshowbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::oct << std::noshowbase << tValue;
                 break;
             case sc_dt::SC_DEC:
                 if(showBaseA)
-                    os << std::dec << std::showbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::dec << std::showbase << tValue;
                 else
-                    os << std::dec << std::noshowbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::dec << std::noshowbase << tValue;
                 break;
             case sc_dt::SC_HEX:
                 if(showBaseA)
-                    os << std::hex << std::showbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::hex << std::showbase << tValue;
                 else
-                    os << std::hex << std::noshowbase << *(reinterpret_cast<T*>(tMemPtr));
+                    os << std::hex << std::noshowbase << tValue;
                 break;
             default:
-                os << *(reinterpret_cast<T*>(tMemPtr));
+                os << tValue;
                 break;
         }
         //Set line break after 8 values in a row.
@@ -371,7 +450,7 @@ inline void cgra::MMU::dump_memory(const uint32_t startAddrA,
         else
             os << '\t';
 
-        tMemPtr += sizeof(T) / sizeof(memory_size_type_t);
+        tAddress += sizeof(T) / sizeof(memory_size_type_t);
         ++tLinecounter;
     }
 
@@ -383,15 +462,15 @@ template<typename T>
 inline bool cgra::MMU::write_shared_memory(const uint32_t startAddrA,
         T* startDataA, const uint32_t numOfValuesA)
 {
-    //Set temporary pointer to access memory data.
-    memory_size_type_t* tMemPtr = pMemStartPtr + startAddrA;
+    //Address of the next stored value
+    uint64_t tAddress{startAddrA};
 
     uint32_t tStoreCounter{0};
 
-    while(tMemPtr + sizeof(T) <= pMemEndPtr && tStoreCounter < numOfValuesA)
+    while(tAddress + sizeof(T) < cgra::cMemorySize && tStoreCounter < numOfValuesA)
     {
-        memcpy(tMemPtr, startDataA, sizeof(T));
-        tMemPtr += sizeof(T) / sizeof(memory_size_type_t);
+        pMemory.write(tAddress, startDataA, sizeof(T));
+        tAddress += sizeof(T) / sizeof(memory_size_type_t);
         ++startDataA;
         ++tStoreCounter;
     }
@@ -407,15 +486,15 @@ inline bool cgra::MMU::read_shared_memory(const uint32_t startAddrA,
         T* startDataA, uint32_t numOfValuesA) const
 {
 
-    //Set temporary pointer to access memory data.
-    memory_size_type_t* tMemPtr = pMemStartPtr + startAddrA;
+    //Address of the next read value
+    uint64_t tAddress{startAddrA};
 
     uint32_t tStoreCounter{0};
 
-    while(tMemPtr <= pMemEndPtr && tStoreCounter < numOfValuesA)
+    while(tAddress < cgra::cMemorySize && tStoreCounter < numOfValuesA)
     {
-        memcpy(startDataA,  tMemPtr, sizeof(T));
-        tMemPtr += sizeof(T) / sizeof(memory_size_type_t);
+        pMemory.read(tAddress, startDataA, sizeof(T));
+        tAddress += sizeof(T) / sizeof(memory_size_type_t);
         ++startDataA;
         ++tStoreCounter;
     }
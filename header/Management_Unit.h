@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <array>
+#include <vector>
 #include <utility>
 #include "Typedef.h"
 #include "CommandInterpreter.h"
@@ -24,6 +25,37 @@ namespace cgra {
  * or process data, start the array or pause its execution
  * until the VCGRA finishes its processing.
  *
+ * A prefetch engine overlaps data transfers with VCGRA processing.
+ * SET_STREAM defines an input stream of DataInCache lines and an
+ * output stream of DataOutCache lines in shared memory (line field:
+ * 0 = input base address, 1 = input stride, 2 = output base address,
+ * 3 = output stride; strides default to the shared memory size of a
+ * cache line as transferred by the MMU). While
+ * a stream is active, START swaps the cache lines, starts the VCGRA
+ * and loads the next input block into the inactive DataInCache line
+ * or stores the previous results from the inactive DataOutCache line.
+ * STOP_STREAM stores the last results and disables both streams.
+ *
+ * The line field of an assembler command addresses 8 cache lines.
+ * SET_LINE_BANK selects a bank of 8 cache lines for all following
+ * cache line commands (line = bank * 8 + line field), thus caches with
+ * more than 8 lines can be addressed. Banks beyond the largest cache are
+ * ignored.
+ *
+ * With PARTIAL_RECONFIGURATION, LOADPC and LOADCC with a place other than
+ * 127 load a segment of a configuration cache line beginning at the byte
+ * given by place. SET_SEGMENT sets the number of bytes of all following
+ * segments (default 1). Thus, only the changed bytes of a configuration
+ * need to be transferred.
+ *
+ * With COMPRESSED_CONFIG, LOADPCZ and LOADCCZ load a whole configuration
+ * cache line from a compressed configuration in shared memory.
+ *
+ * The address field of an assembler command addresses 64KiB of shared
+ * memory. SET_ADDR_HIGH sets the upper 16 bits of all following shared
+ * memory addresses (address = high * 65536 + address field), thus shared
+ * memories with up to 32 bit addresses can be accessed.
+ *
  */
 class ManagementUnit : public sc_core::sc_module
 {
@@ -44,8 +76,8 @@ public:
     //!< \brief Start type for VCGRA
     typedef CommandInterpreter::assembler_type_t assembler_type_t;
     //!< \brief Type definition for assembler command
-    typedef CommandInterpreter::address_type_t address_type_t;
-    //!< \brief Type definition for assembler command
+    typedef cgra::memory_address_type_t address_type_t;
+    //!< \brief Type definition for shared memory addresses
     typedef CommandInterpreter::place_type_t place_type_t;
     //!< \brief Type definition for assembler command
     typedef sc_dt::sc_lv<cgra::calc_bitwidth(cgra::cNumberDataInCacheLines)>\
@@ -83,6 +115,14 @@ public:
     //!< \brief Shared memory (start) address of data (sequence)
     sc_core::sc_out<place_type_t> place{"Place"};
     //!< \brief Place in cache line to store data from or load data to
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_out<place_type_t> segment{"Segment"};
+    //!< \brief Number of configuration bytes loaded by LOADPC and LOADCC with place != 127
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_core::sc_out<bool> compressed{"Compressed"};
+    //!< \brief MMU loads a configuration cache line from a compressed configuration
+#endif
     sc_core::sc_out<MMU::cache_select_type_t> cache_select{"Cache_Select"};
     //!< \brief Selection of source/target cache
     sc_core::sc_in<MMU::ready_type_t> mmu_ready{"MMU_Ready"};
@@ -116,6 +156,14 @@ public:
     //!< \brief Shared memory (start) address of data (sequence)
     sc_out<place_type_t> place{"Place"};
     //!< \brief Place in cache line to store data from or load data to
+#ifdef PARTIAL_RECONFIGURATION
+    sc_out<place_type_t> segment{"Segment"};
+    //!< \brief Number of configuration bytes loaded by LOADPC and LOADCC with place != 127
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_out<bool> compressed{"Compressed"};
+    //!< \brief MMU loads a configuration cache line from a compressed configuration
+#endif
     sc_out<MMU::cache_select_type_t> cache_select{"Cache_Select"};
     //!< \brief Selection of source/target cache
     sc_in<MMU::ready_type_t> mmu_ready{"MMU_Ready"};
@@ -184,6 +232,17 @@ public:
      */
     void state_machine();
 
+    /*!
+     * \brief Replace assembler program in program memory
+     *
+     * \details
+     * Needs to be called before the simulation starts.
+     *
+     * \param [in] programA Pointer to assembler commands as 32 bit words
+     * \param [in] sizeA Number of assembler commands
+     */
+    void load_program(const uint32_t* programA, const uint64_t sizeA);
+
     /* Public Members:
      * ==============
      *
@@ -191,6 +250,7 @@ public:
      */
 
     //Internal signals
+#ifndef PREDECODED_INSTRUCTIONS
     sc_core::sc_buffer<CommandInterpreter::command_type_t> m_currentCommand{"CurrentCommand"};
     //!< \brief Local buffer for latest command
     sc_core::sc_buffer<CommandInterpreter::assembler_type_t> m_currentAssembler{"CurrentAssembler"};
@@ -201,6 +261,7 @@ public:
     //!< \brief Local buffer for latest line number in data cache
     sc_core::sc_buffer<CommandInterpreter::place_type_t> m_currentPlace{"CurrentPlace"};
     //!< \brief Local buffer for latest place number in data cache
+#endif
     sc_core::sc_fifo<bool> m_readyInterrupt{"VCGRA_Ready_Interrupt", 1};
     //!< \brief Interrupt buffer for VCGRA ready signal if ManagementUnit does not wait active.
 
@@ -217,12 +278,16 @@ private:
 
     //Private Members
     //===============
+#ifndef PREDECODED_INSTRUCTIONS
     CommandInterpreter m_cInterpreter{"cInterpreter"};
     //!< \brief Select parts from Assembler Command
-    std::array<assembler_type_t, cgra::cProgramMemorySize> m_programMemory;
-    //!< \brief Program memory for assembler program
-    assembler_type_t* m_programPointer;
+#endif
+    std::vector<CommandInterpreter::Instruction> m_programMemory;
+    //!< \brief Program memory for assembler program (max. cProgramMemorySize commands)
+    std::size_t m_programPointer;
     //!< \brief Program pointer for assembler program
+    CommandInterpreter::Instruction m_currentInstruction;
+    //!< \brief Latest fetched assembler command
 
 #ifdef MCPAT
     //McPAT dynamic statistic counters:
@@ -231,6 +296,44 @@ private:
     uint32_t m_busyCycles;    //!< \brief Count number of working cycles
 #endif
 
+    static constexpr uint32_t cDataValueMemorySize{cgra::cPackedLanes * cgra::calc_numOfBytes(cgra::cDataValueBitwidth)};
+    //!< \brief Number of shared memory bytes the MMU transfers per data cache value (cPackedLanes data values)
+    static constexpr uint32_t cDicStreamStride{cDataValueMemorySize * 2 * cgra::cPeLevels.front()};
+    //!< \brief Default address distance of two consecutive input blocks (one DataInCache line)
+    static constexpr uint32_t cDocStreamStride{cDataValueMemorySize * cgra::cPeLevels.back()};
+    //!< \brief Default address distance of two consecutive output blocks (one DataOutCache line)
+
+    uint16_t m_lineBank{0};
+    //!< \brief Selected bank of cache lines (upper bits of cache line numbers)
+    uint16_t m_segmentLength{1};
+    //!< \brief Number of configuration bytes of a partial configuration load
+    uint16_t m_addressHigh{0};
+    //!< \brief Upper 16 bits of shared memory addresses
+
+    //Prefetch engine
+    bool m_streamInput{false};
+    //!< \brief DataInCache lines are loaded by the prefetch engine
+    bool m_streamOutput{false};
+    //!< \brief DataOutCache lines are stored by the prefetch engine
+    bool m_loadPending{false};
+    //!< \brief Next input block needs to be loaded into the inactive DataInCache line
+    bool m_storePending{false};
+    //!< \brief Results in the inactive DataOutCache line need to be stored
+    bool m_resultPending{false};
+    //!< \brief VCGRA was started and its results are not stored yet
+    uint32_t m_dicStreamBase{0};
+    //!< \brief Shared memory address of the first input block
+    uint32_t m_dicStreamStride{cDicStreamStride};
+    //!< \brief Address distance of two consecutive input blocks
+    uint32_t m_dicStreamBlocks{0};
+    //!< \brief Number of loaded input blocks
+    uint32_t m_docStreamBase{0};
+    //!< \brief Shared memory address of the first output block
+    uint32_t m_docStreamStride{cDocStreamStride};
+    //!< \brief Address distance of two consecutive output blocks
+    uint32_t m_docStreamBlocks{0};
+    //!< \brief Number of stored output blocks
+
     //Internal signals
     /*! ManagementUnit processing status */
     enum ACTIVE_STATE : uint8_t
@@ -265,9 +368,20 @@ private:
         SLCT_DIC_LINE,    //!< \brief Select current cache line for DataInCache
         SLCT_DOC_LINE,    //!< \brief Select current cache line for DataOutCache
         SLCT_PECC_LINE,    //!< \brief Select current cache line for Processing_Element ConfigurationCache
-        SLCT_CHCC_LINE    //!< \brief Select current cache line for VirtualChannel ConfigurationCache
+        SLCT_CHCC_LINE,    //!< \brief Select current cache line for VirtualChannel ConfigurationCache
+        SET_STREAM,        //!< \brief Set a base address or stride of the prefetch engine
+        STOP_STREAM,       //!< \brief Store pending results and disable the prefetch engine
+        SWAP_LINES,        //!< \brief Swap active and inactive cache lines of the streamed caches
+        PREFETCH,          //!< \brief Load next input block and store previous results
+        SET_LINE_BANK,     //!< \brief Select bank of 8 cache lines for following line selections
+        SET_SEGMENT,       //!< \brief Set number of bytes of following partial configuration loads
+        LOADPCZ,           //!< \brief Load complete configuration cache of PEs from a compressed configuration
+        LOADCCZ,           //!< \brief Load complete configuration cache of vCh from a compressed configuration
+        SET_ADDR_HIGH      //!< \brief Set upper 16 bits of following shared memory addresses
     } m_current_state;
     //!< Current state of ManagementUnit state machine
+    enum STATE m_returnState;
+    //!< State after a finished MMU transmission
 
     //Private Functions
     //=================
@@ -302,6 +416,36 @@ private:
      */
     void start_state();
 
+    /*!
+     * \brief Set a stream parameter of the prefetch engine
+     *
+     * \details
+     * Setting the input base address (re)starts the input stream and
+     * loads its first block into the inactive DataInCache line.
+     * Setting the output base address (re)starts the output stream.
+     */
+    void set_stream();
+
+    /*!
+     * \brief Exchange select_in and select_out lines of streamed caches
+     *
+     * \details
+     * The prefetched input block becomes the active DataInCache line.
+     * The DataOutCache line with the results of the previous VCGRA run
+     * becomes the line to store.
+     */
+    void swap_lines();
+
+    /*!
+     * \brief Issue pending transmissions of the prefetch engine
+     *
+     * \details
+     * Each transmission is performed as STOREDA or LOADDA by the MMU.
+     * Afterwards, the state machine returns to this state until no
+     * transmission is pending.
+     */
+    void prefetch();
+
     /*!
      * \brief Pause until VCGRA has finished its processing
      */
@@ -0,0 +1,334 @@
+/*
+ * MonolithicVCGRA.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef MONOLITHIC_VCGRA_H_
+#define MONOLITHIC_VCGRA_H_
+
+#include <systemc>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <iostream>
+#include "Typedef.h"
+#include "VCGRA.h"
+#include "ThreadPool.hpp"
+
+#ifndef MONOLITHIC_VCGRA_THREADS
+#define MONOLITHIC_VCGRA_THREADS 1
+#endif
+
+namespace cgra {
+
+/*!
+ * \class MonolithicVCGRA
+ *
+ * \brief VCGRA model which updates all components within one clocked process
+ *
+ * \details
+ * Drop-in replacement of VCGRA with the same ports, configuration layout and
+ * cycle behavior. Instead of Processing_Element, VirtualChannel,
+ * Synchronizer, Selector and Demultiplexer modules connected by signals, the
+ * registers of all components are kept in plain arrays indexed by PE.
+ *
+ * On every rising clock edge, the Synchronizer is updated first, followed
+ * by a channel phase and a PE phase. The channels write their outputs and
+ * samples into a second register set, so every component reads the registers
+ * of its predecessor before they are updated, like the modules of VCGRA read
+ * signals written at the previous clock edge. The configuration inputs are
+ * decoded once per change. Only the data outputs and ready are SystemC
+ * signals.
+ *
+ * Both phases only touch registers of the PEs (and the channel outputs in
+ * front of them) within a partition of the PE array. With
+ * MONOLITHIC_VCGRA_THREADS > 1, the partitions are evaluated by a ThreadPool
+ * with a barrier after each phase. The results are bit-identical to the
+ * single-threaded evaluation; all SystemC ports are accessed by the simulation
+ * thread only.
+ *
+ * The model follows PIPELINED_PE, PE_IMMEDIATES, FEEDBACK_REGISTERS and the
+ * selected datapath policy. ACTIVITY_GATING has no effect, because there is
+ * only one process; McPAT statistics are written for the same components as
+ * by VCGRA. The structural VCGRA remains the reference model and is always
+ * used with gSysC.
+ */
+class MonolithicVCGRA : public sc_core::sc_module
+{
+public:
+    typedef VCGRA::pe_datapath_type_t pe_datapath_type_t;
+    //!< \brief Datapath policy of the Processing_Elements
+    typedef VCGRA::pe_type_t::config_type_t pe_config_part_type_t;
+    //!< \brief Configuration part of a single PE
+    typedef VCGRA::start_type_t start_type_t;
+    //!< \brief VCGRA start port type definition
+    typedef VCGRA::reset_type_t reset_type_t;
+    //!< \brief VCGRA reset port type definition
+    typedef VCGRA::ready_type_t ready_type_t;
+    //!< \brief VCGRA ready port type definition
+    typedef VCGRA::clock_type_t clock_type_t;
+    //!< \brief VCGRA clock port type definition
+    typedef VCGRA::data_input_type_t data_input_type_t;
+    //!< \brief VCGRA data input type
+    typedef VCGRA::data_output_type_t data_output_type_t;
+    //!< \brief VCGRA data output type
+
+    //Entity ports
+    sc_core::sc_in<cgra::clock_type_t> clk{"clk"};
+    //!< \brief VCGRA clock port
+    sc_core::sc_in<cgra::start_type_t> start{"start"};
+    //!< \brief VCGRA start port
+    sc_core::sc_in<cgra::reset_type_t> rst{"rst"};
+    //!< \brief VCGRA reset port
+    sc_core::sc_in<cgra::pe_config_type_t> pe_config{"pe_config"};
+    //!< \brief VCGRA PE configuration port
+    sc_core::sc_in<cgra::ch_config_type_t> ch_config{"ch_config"};
+    //!< \brief VCGRA VirtualChannel configuration port
+    std::array<sc_core::sc_in<data_input_type_t>, cgra::cInputChannel_NumOfInputs> data_inputs;
+    //!< \brief VCGRA data inputs to first VirtualChannel level
+    sc_core::sc_out<cgra::ready_type_t> ready{"ready"};
+    //!< \brief VCGRA ready port
+    std::array<sc_core::sc_out<data_output_type_t>, cgra::cPeLevels.back()> data_outputs;
+    //!< \brief VCGRA data outputs
+
+    static constexpr uint32_t cNumOfThreads{MONOLITHIC_VCGRA_THREADS};
+    //!< \brief Number of threads which evaluate the PE array
+
+    //Member functions
+    //------------------
+    SC_HAS_PROCESS(MonolithicVCGRA);
+    /*!
+     * \brief General constructor
+     */
+    MonolithicVCGRA(const sc_core::sc_module_name& nameA);
+
+    /*!
+     * \brief Initialize output signals and registers
+     */
+    virtual void end_of_elaboration() override;
+
+    /*!
+     * \brief Print sc_module type
+     *
+     * \return Module kind.
+     */
+    const char * kind() const override
+    { return "Monolithic VCGRA"; }
+
+    /*!
+     * \brief Print VCGRA instance name
+     *
+     * \param[out] os Outstream for string of sc_module instance name
+     */
+    virtual void print(::std::ostream& os = std::cout) const override
+    { os << name(); }
+
+    /*!
+     * \brief Dump sc_module internal information
+     *
+     * \param[out] os Outstream for information dumping
+     */
+    virtual void dump(::std::ostream& os = std::cout) const override;
+
+#ifdef MCPAT
+    /**
+     * \brief Dump runtime statistics for McPAT simulation
+     *
+     * \details
+     * The statistics are written per PE, VirtualChannel, Synchronizer (and
+     * FeedbackRegisters) with the component names of VCGRA.
+     *
+     * \param os Define used outstream [default: std::cout]
+     */
+    void dumpMcpatStatistics(std::ostream& os = ::std::cout) const;
+#endif
+
+    /*!
+     * \brief Update all registers of the VCGRA
+     *
+     * \details
+     * The process also runs once at initialization, like the VirtualChannels
+     * and the Synchronizer of VCGRA. Processing_Elements only change their
+     * state on rising clock edges.
+     */
+    void update();
+
+    /*!
+     * \brief Decode the operations and immediate operands of changed PE configurations
+     *
+     * \details
+     * Like a Processing_Element, only a PE whose part of the configuration
+     * changed clears its MAC accumulator.
+     */
+    void decode_pe_configuration();
+
+    /*!
+     * \brief Decode the select tables of all VirtualChannels and the Synchronizer mask
+     */
+    void decode_ch_configuration();
+
+    /*!
+     * \brief Destructor
+     */
+    ~MonolithicVCGRA() = default;
+
+private:
+    //Forbidden Constructors
+    MonolithicVCGRA() = delete;
+    MonolithicVCGRA(const MonolithicVCGRA& src) = delete;               //!< \brief because sc_module could not be copied
+    MonolithicVCGRA& operator=(const MonolithicVCGRA& src) = delete;    //!< \brief because sc_module could not be copied
+    MonolithicVCGRA(MonolithicVCGRA&& src) = delete;                    //!< \brief because move not implemented for sc_module
+    MonolithicVCGRA& operator=(MonolithicVCGRA&& src) = delete;         //!< \brief because move not implemented for sc_module
+
+    typedef typename pe_datapath_type_t::operand_type_t operand_type_t;
+    //!< \brief Type of PE operands
+    typedef typename pe_datapath_type_t::result_type_t result_type_t;
+    //!< \brief Type of MAC accumulators
+
+#ifndef PIPELINED_PE
+    //! \enum STATE
+    //! \brief States of a Processing_Element's state machine
+    enum STATE
+    {
+        AWAIT_DATA,     //!< \brief Await both input data values
+        PROCESS_DATA,   //!< \brief Perform configured operation on input values
+        VALID_DATA      //!< \brief Set current result valid for one clock cycle
+    };
+#endif
+
+    static constexpr uint32_t cNumOfInnerPe{cgra::cNumOfPe - cgra::cPeLevels.back()};
+    //!< \brief Number of PEs whose results are inputs of a VirtualChannel
+    static constexpr uint32_t cNumOfSamples{cgra::cInputChannel_NumOfChannelInputs + cNumOfInnerPe};
+    //!< \brief Inputs of all VirtualChannels: input channel inputs followed by PE results
+    static constexpr uint32_t cUnusedSample{cNumOfSamples};
+    //!< \brief Constantly zero and invalid sample of VirtualChannel inputs without a preceding PE
+    static constexpr bool cImmediates{cgra::cPeConfigLvSize >=
+        cgra::cPeOperationBitwidth + cgra::cPeModeBitwidth + cgra::cPeDataBitwidth};
+    //!< \brief PE configurations contain an operand mode and an immediate operand
+
+    /*!
+     * \brief Perform the configured operation of a PE on its operands
+     *
+     * \param[in] peA Index of the PE
+     * \return False if the operation code is unknown and no result was written
+     */
+    bool execute(const uint32_t peA);
+
+    /*!
+     * \brief Sample the data inputs and feedback registers of the input channel
+     *
+     * \param[in] resetA Clear the samples
+     */
+    void sample_inputs(const bool resetA);
+
+    /*!
+     * \brief Channel phase of a partition of the PE array
+     *
+     * \details
+     * Routes the samples of the previous clock edge to the channel outputs in
+     * front of the PEs and samples the results of the PEs for the succeeding
+     * channel. Both are written into the next register set.
+     *
+     * \param[in] firstPeA First PE of the partition
+     * \param[in] endPeA   PE behind the partition
+     * \param[in] resetA   Clear the samples
+     */
+    void update_channels(const uint32_t firstPeA, const uint32_t endPeA, const bool resetA);
+
+    /*!
+     * \brief PE phase of a partition of the PE array
+     *
+     * \param[in] firstPeA First PE of the partition
+     * \param[in] endPeA   PE behind the partition
+     */
+    void update_pes(const uint32_t firstPeA, const uint32_t endPeA);
+
+    /*!
+     * \brief Execute a phase for all partitions of the PE array
+     *
+     * \param[in] phaseA Phase which is called with the first PE and the PE behind a partition
+     */
+    template <typename F>
+    void for_each_partition(F&& phaseA);
+
+    std::array<uint32_t, cgra::cNumOfLevels> m_levelOffsets;
+    //!< \brief Index of the first PE of each level
+
+    //Processing_Element registers
+    std::array<pe_config_part_type_t, cgra::cNumOfPe> m_peConfigs;
+    //!< \brief Last decoded configuration part of each PE
+    std::array<uint32_t, cgra::cNumOfPe> m_operations;
+    //!< \brief Decoded operation code of each PE
+    std::array<bool, cgra::cNumOfPe> m_immediateModes;
+    //!< \brief In2 of a PE is replaced by its immediate operand
+    std::array<operand_type_t, cgra::cNumOfPe> m_immediates;
+    //!< \brief Immediate operand of each PE
+    std::array<operand_type_t, 2 * cgra::cNumOfPe> m_operands;
+    //!< \brief Input buffers of the PEs, index 2 * PE + input
+    std::array<result_type_t, cgra::cNumOfPe> m_accumulators;
+    //!< \brief Accumulators of MAC operations
+#ifdef PIPELINED_PE
+    std::array<bool, cgra::cNumOfPe> m_sampled;
+    //!< \brief SAMPLE stage of a PE holds valid operands
+#else
+    std::array<STATE, cgra::cNumOfPe> m_states;
+    //!< \brief State of each PE
+#endif
+    std::array<data_output_type_t, cgra::cNumOfPe> m_results;
+    //!< \brief Result of each PE
+    std::array<bool, cgra::cNumOfPe> m_valids;
+    //!< \brief Valid output of each PE
+
+    //VirtualChannel registers (current and next register set)
+    uint32_t m_current{0};
+    //!< \brief Register set written at the previous clock edge
+    std::array<std::array<data_input_type_t, cNumOfSamples + 1>, 2> m_samples;
+    //!< \brief Channel inputs sampled on the previous clock edge, followed by cUnusedSample
+    std::array<std::array<bool, cNumOfSamples + 1>, 2> m_sampledValids;
+    //!< \brief Channel valid inputs sampled on the previous clock edge
+    std::array<uint32_t, 2 * cgra::cNumOfPe> m_selects;
+    //!< \brief Sample routed to each PE input, decoded from ch_config
+    std::array<std::array<data_input_type_t, 2 * cgra::cNumOfPe>, 2> m_channelOutputs;
+    //!< \brief Channel outputs, index 2 * PE + input
+    std::array<std::array<bool, 2 * cgra::cNumOfPe>, 2> m_enables;
+    //!< \brief Channel enable outputs, index 2 * PE + input
+
+    //Synchronizer register
+    std::array<bool, cgra::cPeLevels.back()> m_syncMask;
+    //!< \brief Data outputs which are ignored by the Synchronizer
+#ifdef FEEDBACK_REGISTERS
+    std::array<data_output_type_t, cgra::cNumOfFeedbackRegisters> m_feedback;
+    //!< \brief Results of previous invocations, index age * cPeLevels.back() + output
+    std::array<data_output_type_t, cgra::cPeLevels.back()> m_sampledOutputs;
+    //!< \brief Data outputs at the previous clock edge
+    bool m_readyBefore{true};
+    //!< \brief Ready at the previous clock edge
+#endif
+    std::unique_ptr<cgra::ThreadPool> m_threadPool;
+    //!< \brief Worker threads for the partitions of the PE array (only for cNumOfThreads > 1)
+
+#ifdef MCPAT
+    //McPAT dynamic statistic counters:
+    uint32_t m_totalCycles{0U};     //!< \brief Count process activations of channels and Synchronizer
+    std::array<uint32_t, cgra::cNumOfPe> m_idleCycles{};    //!< \brief Count number of idle cycles per PE
+    std::array<uint32_t, cgra::cNumOfPe> m_busyCycles{};    //!< \brief Count number of working cycles per PE
+    std::array<uint32_t, cgra::cNumOfPe> m_ialuAccesses{};  //!< \brief Count number of integer ALU operations per PE
+    std::array<uint32_t, cgra::cNumOfPe> m_mulAccesses{};   //!< \brief Count number of multiplier/divider operations per PE
+#ifdef FEEDBACK_REGISTERS
+    uint32_t m_feedbackWrites{0U};  //!< \brief Count number of stored invocations
+#endif
+#endif
+};
+
+#if defined(MONOLITHIC_VCGRA) && !defined(GSYSC)
+typedef MonolithicVCGRA vcgra_type_t;
+//!< \brief VCGRA model of the architectures (selected by MONOLITHIC_VCGRA)
+#else
+typedef VCGRA vcgra_type_t;
+//!< \brief VCGRA model of the architectures
+#endif
+
+} /* end namespace cgra */
+
+#endif /* MONOLITHIC_VCGRA_H_ */
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <array>
+#include "Typedef.h"
 
 #ifdef GSYSC
 #include <gsysc.h>
@@ -38,7 +39,7 @@ public:
     //!< \brief Type of multiplexed data
     typedef bool valid_type_t;
     //!< \brief Valid signal type
-    typedef sc_dt::sc_lv<L> select_type_t;
+    typedef cgra::config_vector_t<L> select_type_t;
     //!< \brief Select type for Multiplexer input signals
 
 #ifndef GSYSC
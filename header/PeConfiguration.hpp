@@ -0,0 +1,145 @@
+/*
+ * PeConfiguration.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PE_CONFIGURATION_H_
+#define PE_CONFIGURATION_H_
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include "Typedef.h"
+#include "PeDatapath.h"
+
+namespace cgra
+{
+
+/*!
+ * \brief Extract a bit field from a configuration byte stream
+ *
+ * \details
+ * The byte stream is interpreted like a logic vector of bitwidthA bits which
+ * was filled by shifting in the bytes one after another. Bits which are not
+ * covered by the byte stream are zero.
+ *
+ * \param[in] configA   Configuration byte stream, most significant byte first
+ * \param[in] bitwidthA Length of the configuration vector
+ * \param[in] offsetA   Start of the field counted from the most significant bit
+ * \param[in] lengthA   Length of the field (<= 32)
+ * \return Unsigned value of the field
+ */
+inline uint32_t extractConfigField(const std::vector<uint8_t>& configA, const uint32_t bitwidthA,
+                                   const uint32_t offsetA, const uint32_t lengthA)
+{
+    uint32_t t_value{0};
+
+    for (uint32_t t_bit = bitwidthA - offsetA; t_bit-- > bitwidthA - offsetA - lengthA;) {
+        const std::size_t t_byte = t_bit / 8;
+        t_value <<= 1;
+        if (t_byte < configA.size()) {
+            t_value |= (configA[configA.size() - 1 - t_byte] >> (t_bit % 8)) & 0x1U;
+        }
+    }
+
+    return t_value;
+}
+
+/*!
+ * \brief Write a bit field into a configuration byte stream
+ *
+ * \details
+ * Counterpart of extractConfigField(). The byte stream needs to cover the
+ * whole field.
+ *
+ * \param[in,out] configA   Configuration byte stream, most significant byte first
+ * \param[in] bitwidthA     Length of the configuration vector
+ * \param[in] offsetA       Start of the field counted from the most significant bit
+ * \param[in] lengthA       Length of the field (<= 32)
+ * \param[in] valueA        New value of the field
+ */
+inline void insertConfigField(std::vector<uint8_t>& configA, const uint32_t bitwidthA, const uint32_t offsetA,
+                              const uint32_t lengthA, const uint32_t valueA)
+{
+    for (uint32_t t_index = 0; lengthA > t_index; ++t_index) {
+        const uint32_t t_bit = bitwidthA - offsetA - lengthA + t_index;
+        const std::size_t t_byte = configA.size() - 1 - t_bit / 8;
+        const uint8_t t_mask = static_cast<uint8_t>(0x1U << (t_bit % 8));
+
+        if ((valueA >> t_index) & 0x1U)
+            configA.at(t_byte) |= t_mask;
+        else
+            configA.at(t_byte) &= static_cast<uint8_t>(~t_mask);
+    }
+}
+
+/*!
+ * \brief Expand a PE configuration with operation codes only to the PE configuration of this build
+ *
+ * \details
+ * The input contains cPeOperationBitwidth bits per PE like the PE
+ * configurations without PE_IMMEDIATES. Operand modes and immediate
+ * operands of the result are zero, i.e. both operands are data inputs.
+ * Without PE_IMMEDIATES, the configuration is returned unchanged.
+ *
+ * \param[in] configA Operation codes of all PEs as byte stream
+ * \return PE configuration with calc_numOfBytes(cPeConfigBitWidth) bytes
+ */
+inline std::vector<uint8_t> expandPeConfiguration(const std::vector<uint8_t>& configA)
+{
+    constexpr uint32_t t_opConfigBitwidth{cNumOfPe * cPeOperationBitwidth};
+
+    std::vector<uint8_t> t_config(calc_numOfBytes(cPeConfigBitWidth), 0);
+    for (uint32_t t_pe = 0; cNumOfPe > t_pe; ++t_pe) {
+        insertConfigField(t_config, cPeConfigBitWidth, t_pe * cPeConfigLvSize, cPeOperationBitwidth,
+                          extractConfigField(configA, t_opConfigBitwidth, t_pe * cPeOperationBitwidth,
+                                             cPeOperationBitwidth));
+    }
+
+    return t_config;
+}
+
+/*!
+ * \brief Replace the operation of a PE
+ *
+ * \param[in,out] configA   PE configuration with calc_numOfBytes(cPeConfigBitWidth) bytes
+ * \param[in] peA           Index of the PE
+ * \param[in] operationA    New operation code, see PeOperations::OP
+ *
+ * \throw std::out_of_range if the PE or the configuration does not exist
+ */
+inline void setPeOperation(std::vector<uint8_t>& configA, const uint32_t peA, const PeOperations::OP operationA)
+{
+    if (cNumOfPe <= peA)
+        throw std::out_of_range("PE " + std::to_string(peA) + " does not exist.");
+
+    insertConfigField(configA, cPeConfigBitWidth, peA * cPeConfigLvSize, cPeOperationBitwidth, operationA);
+}
+
+#ifdef PE_IMMEDIATES
+/*!
+ * \brief Replace In2 of a PE by an immediate operand
+ *
+ * \param[in,out] configA   PE configuration with calc_numOfBytes(cPeConfigBitWidth) bytes
+ * \param[in] peA           Index of the PE
+ * \param[in] immediateA    Immediate operand (truncated to cPeImmediateBitwidth bits)
+ *
+ * \throw std::out_of_range if the PE or the configuration does not exist
+ */
+inline void setPeImmediate(std::vector<uint8_t>& configA, const uint32_t peA, const int32_t immediateA)
+{
+    if (cNumOfPe <= peA)
+        throw std::out_of_range("PE " + std::to_string(peA) + " does not exist.");
+
+    const uint32_t t_offset{peA * cPeConfigLvSize + cPeOperationBitwidth};
+    insertConfigField(configA, cPeConfigBitWidth, t_offset, cPeModeBitwidth, PeOperations::IMMEDIATE);
+    insertConfigField(configA, cPeConfigBitWidth, t_offset + cPeModeBitwidth, cPeImmediateBitwidth,
+                      static_cast<uint32_t>(immediateA) & ((1U << cPeImmediateBitwidth) - 1U));
+}
+#endif
+
+} // namespace cgra
+
+#endif // PE_CONFIGURATION_H_
@@ -0,0 +1,743 @@
+/*
+ * PeDatapath.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef HEADER_PEDATAPATH_H_
+#define HEADER_PEDATAPATH_H_
+
+#include <systemc>
+#include <cstdint>
+#include <type_traits>
+
+namespace cgra
+{
+
+/*!
+ * \struct PeOperations
+ *
+ * \brief Operation codes of a Processing_Element
+ *
+ * \details
+ * The operation code is the value of the configuration part of a PE.
+ * All 16 codes of the 4 bit configuration part are in use.
+ *
+ * Shift operations use In2 modulo the operand bitwidth as shift amount.
+ * Saturating operations clamp the result to the range of the result
+ * bitwidth instead of wrapping around. MAC adds the product of both inputs
+ * to an accumulator of the PE and returns the new accumulator value. The
+ * accumulator is cleared if the configuration of the PE changes.
+ *
+ * With PE_IMMEDIATES, the operation code is followed by an operand mode and
+ * an immediate operand within the configuration part of a PE. If the mode
+ * is IMMEDIATE, In2 is replaced by the immediate operand and the PE only
+ * waits for In1.
+ */
+struct PeOperations
+{
+    //! \enum OP
+    //! \brief Operations of a processing element
+    enum OP
+    {
+        NONE = 0,       //!< \brief PE will not perform any operation on data inputs
+        ADD,            //!< \brief Add two integers
+        SUB,            //!< \brief Subtract two integers
+        MUL,            //!< \brief Multiply two integers
+        IDIV,           //!< \brief Integer division of two integers
+        MDL,            //!< \brief Modulo operation
+        GRE,            //!< \brief Return greater value of In1 and In2
+        EQU,            //!< \brief True if both inputs are equal
+        BUF,            //!< \brief Buffer Input one for one clock cycle
+        MAC,            //!< \brief Multiply two integers and accumulate the product
+        ABS,            //!< \brief Absolute value of In1
+        MIN,            //!< \brief Return smaller value of In1 and In2
+        SHL,            //!< \brief Shift In1 left by In2 bits
+        SHR,            //!< \brief Arithmetic shift of In1 right by In2 bits
+        SADD,           //!< \brief Add two integers with saturation
+        SSUB,           //!< \brief Subtract two integers with saturation
+        LAST = SSUB     //!< \brief Last valid operation code
+    };
+
+    //! \enum MODE
+    //! \brief Operand modes of a processing element (PE_IMMEDIATES)
+    enum MODE
+    {
+        REGISTER = 0,   //!< \brief Both operands are data inputs
+        IMMEDIATE = 1   //!< \brief In2 is the immediate operand of the configuration
+    };
+
+    /*!
+     * \brief Operation uses the multiplier/divider instead of the integer ALU
+     *
+     * \param[in] opA Operation code
+     * \return true for MUL, IDIV, MDL and MAC
+     */
+    static inline bool usesMultiplier(const uint32_t opA)
+    {
+        return MUL == opA || IDIV == opA || MDL == opA || MAC == opA;
+    }
+};
+
+/*!
+ * \brief Smallest native signed integer type which holds W bits
+ *
+ * \tparam W Bitwidth of the integer value
+ */
+template <uint16_t W>
+struct native_int
+{
+    typedef typename std::conditional<(W <= 8), int8_t,
+            typename std::conditional<(W <= 16), int16_t,
+            typename std::conditional<(W <= 32), int32_t, int64_t>::type>::type>::type type;
+    //!< \brief Native integer type
+};
+
+/*!
+ * \brief Smallest native unsigned integer type which holds W bits
+ *
+ * \tparam W Bitwidth of the integer value
+ */
+template <uint16_t W>
+struct native_uint
+{
+    typedef typename std::conditional<(W <= 8), uint8_t,
+            typename std::conditional<(W <= 16), uint16_t,
+            typename std::conditional<(W <= 32), uint32_t, uint64_t>::type>::type>::type type;
+    //!< \brief Native integer type
+};
+
+/*!
+ * \brief Truncate a value to W bits and sign extend it again
+ *
+ * \details
+ * Same two's complement wrap-around as an assignment to sc_dt::sc_int<W>.
+ *
+ * \tparam W Bitwidth of the result
+ * \param[in] valueA Value to wrap
+ * \return Wrapped value
+ */
+template <uint16_t W>
+inline constexpr int64_t wrap_to_bitwidth(const int64_t valueA)
+{
+    return (W >= 64) ? valueA : static_cast<int64_t>(
+        ((static_cast<uint64_t>(valueA) & ((1ULL << (W % 64)) - 1ULL)) ^ (1ULL << ((W - 1) % 64)))
+            - (1ULL << ((W - 1) % 64)));
+}
+
+/*!
+ * \brief Clamp a value to the range of a W bit signed integer
+ *
+ * \tparam W Bitwidth of the result
+ * \param[in] valueA Value to saturate
+ * \return Saturated value
+ */
+template <uint16_t W>
+inline constexpr int64_t saturate_to_bitwidth(const int64_t valueA)
+{
+    return (W >= 64) ? valueA
+        : (valueA > static_cast<int64_t>((1ULL << ((W - 1) % 64)) - 1ULL))
+            ? static_cast<int64_t>((1ULL << ((W - 1) % 64)) - 1ULL)
+        : (valueA < -static_cast<int64_t>(1ULL << ((W - 1) % 64)))
+            ? -static_cast<int64_t>(1ULL << ((W - 1) % 64))
+        : valueA;
+}
+
+/*!
+ * \brief Clamp a value to the range of a W bit unsigned integer
+ *
+ * \tparam W Bitwidth of the result (< 64)
+ * \param[in] valueA Value to saturate
+ * \return Saturated value
+ */
+template <uint16_t W>
+inline constexpr int64_t saturate_to_unsigned_bitwidth(const int64_t valueA)
+{
+    return (0 > valueA) ? 0
+        : (valueA > static_cast<int64_t>((1ULL << (W % 64)) - 1ULL))
+            ? static_cast<int64_t>((1ULL << (W % 64)) - 1ULL)
+        : valueA;
+}
+
+/************************************************************************/
+// SystemC integer datapath
+//!
+//! \class ScIntDatapath
+//! \brief Processing_Element datapath which calculates with sc_int
+//!
+//! \details
+//! Reference datapath of a Processing_Element. Operands and results are
+//! SystemC integers and the arithmetic is performed by the SystemC
+//! datatypes library.
+//!
+//! \tparam N Bitwidth of incoming data
+//! \tparam K Bitwidth of outgoing data
+/************************************************************************/
+template <uint16_t N, uint16_t K>
+struct ScIntDatapath
+{
+    typedef sc_dt::sc_int<N> operand_type_t;
+    //!< \brief Type of buffered operands
+    typedef sc_dt::sc_int<K> result_type_t;
+    //!< \brief Type of operation results
+
+    //! \brief Convert a port value into an operand
+    static inline operand_type_t load(const sc_dt::sc_int<N>& valueA) { return valueA; }
+    //! \brief Convert a result into a port value
+    static inline sc_dt::sc_int<K> store(const result_type_t& valueA) { return valueA; }
+
+    //! \brief Add the two operands
+    static inline result_type_t add(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return aA + bA;
+    }
+
+    //! \brief Subtract bA from aA
+    static inline result_type_t sub(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return aA - bA;
+    }
+
+    /*!
+     * \brief Multiply the two operands
+     *
+     * \details
+     * Internally, SystemC Integer data type is managed as int64.
+     * Thus, input data bitwidth is limited to 32 bit, each.
+     */
+    static inline result_type_t mul(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        sc_assert(aA.length() <= 32 || bA.length() <= 32);
+        return aA * bA;
+    }
+
+    //! \brief Integer division aA / bA
+    static inline result_type_t idiv(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return static_cast<sc_dt::int64>(aA.to_int() / bA.to_int());
+    }
+
+    //! \brief Modulo operation aA % bA
+    static inline result_type_t mdl(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return aA % bA;
+    }
+
+    //! \brief Return the greater operand
+    static inline result_type_t gre(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return (aA >= bA) ? aA : bA;
+    }
+
+    //! \brief Return 1 if both operands are value-equal or 0 otherwise
+    static inline result_type_t equ(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return (aA == bA) ? 1 : 0;
+    }
+
+    //! \brief Pass through the first operand
+    static inline result_type_t buf(const operand_type_t& aA)
+    {
+        return aA;
+    }
+
+    //! \brief Add the product of both operands to the accumulator accA
+    static inline result_type_t mac(const result_type_t& accA, const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return accA + aA * bA;
+    }
+
+    //! \brief Absolute value of the first operand
+    static inline result_type_t abs(const operand_type_t& aA)
+    {
+        const sc_dt::int64 t_a{aA.to_int64()};
+        return (0 > t_a) ? -t_a : t_a;
+    }
+
+    //! \brief Return the smaller operand
+    static inline result_type_t min(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return (aA <= bA) ? aA : bA;
+    }
+
+    //! \brief Shift aA left by bA modulo N bits
+    static inline result_type_t shl(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return static_cast<sc_dt::int64>(static_cast<sc_dt::uint64>(aA.to_int64()) << (bA.to_uint() % N));
+    }
+
+    //! \brief Arithmetic shift of aA right by bA modulo N bits
+    static inline result_type_t shr(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return aA.to_int64() >> (bA.to_uint() % N);
+    }
+
+    //! \brief Add the two operands with saturation to K bits
+    static inline result_type_t sadd(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return saturate_to_bitwidth<K>(aA.to_int64() + bA.to_int64());
+    }
+
+    //! \brief Subtract bA from aA with saturation to K bits
+    static inline result_type_t ssub(const operand_type_t& aA, const operand_type_t& bA)
+    {
+        return saturate_to_bitwidth<K>(aA.to_int64() - bA.to_int64());
+    }
+};
+
+/************************************************************************/
+// Native integer datapath
+//!
+//! \class NativeDatapath
+//! \brief Processing_Element datapath which calculates with native integers
+//!
+//! \details
+//! Operands and results are stored as the smallest fitting native integer
+//! type. Every result is explicitly wrapped to K bits, thus the results are
+//! bit-identical to the ScIntDatapath. SystemC datatypes are only used to
+//! convert from and to the port values of a Processing_Element.
+//!
+//! \tparam N Bitwidth of incoming data
+//! \tparam K Bitwidth of outgoing data
+/************************************************************************/
+template <uint16_t N, uint16_t K>
+struct NativeDatapath
+{
+    static_assert(N <= 32 && K <= 64, "Native datapath is limited to 32 bit operands");
+
+    typedef typename native_int<N>::type operand_type_t;
+    //!< \brief Type of buffered operands
+    typedef typename native_int<K>::type result_type_t;
+    //!< \brief Type of operation results
+
+    //! \brief Convert a port value into an operand
+    static inline operand_type_t load(const sc_dt::sc_int<N>& valueA)
+    {
+        return static_cast<operand_type_t>(valueA.to_int64());
+    }
+    //! \brief Convert a result into a port value
+    static inline sc_dt::sc_int<K> store(const result_type_t valueA) { return valueA; }
+
+    //! \brief Add the two operands
+    static inline result_type_t add(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(aA) + bA);
+    }
+
+    //! \brief Subtract bA from aA
+    static inline result_type_t sub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(aA) - bA);
+    }
+
+    //! \brief Multiply the two operands
+    static inline result_type_t mul(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(aA) * bA);
+    }
+
+    //! \brief Integer division aA / bA
+    static inline result_type_t idiv(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int32_t>(aA) / static_cast<int32_t>(bA));
+    }
+
+    //! \brief Modulo operation aA % bA
+    static inline result_type_t mdl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(aA) % bA);
+    }
+
+    //! \brief Return the greater operand
+    static inline result_type_t gre(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap((aA >= bA) ? aA : bA);
+    }
+
+    //! \brief Return 1 if both operands are value-equal or 0 otherwise
+    static inline result_type_t equ(const operand_type_t aA, const operand_type_t bA)
+    {
+        return (aA == bA) ? 1 : 0;
+    }
+
+    //! \brief Pass through the first operand
+    static inline result_type_t buf(const operand_type_t aA)
+    {
+        return wrap(aA);
+    }
+
+    //! \brief Add the product of both operands to the accumulator accA
+    static inline result_type_t mac(const result_type_t accA, const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(accA) + static_cast<int64_t>(aA) * bA);
+    }
+
+    //! \brief Absolute value of the first operand
+    static inline result_type_t abs(const operand_type_t aA)
+    {
+        return wrap((0 > aA) ? -static_cast<int64_t>(aA) : static_cast<int64_t>(aA));
+    }
+
+    //! \brief Return the smaller operand
+    static inline result_type_t min(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap((aA <= bA) ? aA : bA);
+    }
+
+    //! \brief Shift aA left by bA modulo N bits
+    static inline result_type_t shl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(static_cast<uint64_t>(static_cast<int64_t>(aA)) << shift(bA)));
+    }
+
+    //! \brief Arithmetic shift of aA right by bA modulo N bits
+    static inline result_type_t shr(const operand_type_t aA, const operand_type_t bA)
+    {
+        return wrap(static_cast<int64_t>(aA) >> shift(bA));
+    }
+
+    //! \brief Add the two operands with saturation to K bits
+    static inline result_type_t sadd(const operand_type_t aA, const operand_type_t bA)
+    {
+        return static_cast<result_type_t>(saturate_to_bitwidth<K>(static_cast<int64_t>(aA) + bA));
+    }
+
+    //! \brief Subtract bA from aA with saturation to K bits
+    static inline result_type_t ssub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return static_cast<result_type_t>(saturate_to_bitwidth<K>(static_cast<int64_t>(aA) - bA));
+    }
+
+  private:
+    //! \brief Shift amount of an operand (same as sc_int::to_uint() modulo N)
+    static inline uint32_t shift(const operand_type_t bA)
+    {
+        return static_cast<uint32_t>(bA) % N;
+    }
+
+    //! \brief Wrap an intermediate result to the result bitwidth K
+    static inline result_type_t wrap(const int64_t valueA)
+    {
+        return static_cast<result_type_t>(wrap_to_bitwidth<K>(valueA));
+    }
+};
+
+/************************************************************************/
+// Unsigned saturating datapath
+//!
+//! \class UnsignedSaturatingDatapath
+//! \brief Datapath for unsigned values which saturates every result
+//!
+//! \details
+//! Operands are zero extended and every result is clamped to the range
+//! 0 to 2^K - 1 instead of wrapping around, like the saturating byte
+//! arithmetic of media instruction sets. Thus, ADD (SUB) is the same as
+//! SADD (SSUB), ABS passes In1 and SHR is a logical shift. Used for the
+//! lanes of a PackedDatapath with PACKED_UNSIGNED, e.g. for 8 bit pixels.
+//!
+//! \tparam N Bitwidth of incoming data
+//! \tparam K Bitwidth of outgoing data
+/************************************************************************/
+template <uint16_t N, uint16_t K>
+struct UnsignedSaturatingDatapath
+{
+    static_assert(N <= 16 && K <= 16, "Unsigned saturating datapath is limited to 16 bit values");
+
+    typedef typename native_uint<N>::type operand_type_t;
+    //!< \brief Type of buffered operands
+    typedef typename native_uint<K>::type result_type_t;
+    //!< \brief Type of operation results
+
+    //! \brief Add the two operands
+    static inline result_type_t add(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) + bA);
+    }
+
+    //! \brief Subtract bA from aA
+    static inline result_type_t sub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) - bA);
+    }
+
+    //! \brief Multiply the two operands
+    static inline result_type_t mul(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) * bA);
+    }
+
+    //! \brief Integer division aA / bA
+    static inline result_type_t idiv(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) / bA);
+    }
+
+    //! \brief Modulo operation aA % bA
+    static inline result_type_t mdl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) % bA);
+    }
+
+    //! \brief Return the greater operand
+    static inline result_type_t gre(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate((aA >= bA) ? aA : bA);
+    }
+
+    //! \brief Return 1 if both operands are value-equal or 0 otherwise
+    static inline result_type_t equ(const operand_type_t aA, const operand_type_t bA)
+    {
+        return (aA == bA) ? 1 : 0;
+    }
+
+    //! \brief Pass through the first operand
+    static inline result_type_t buf(const operand_type_t aA)
+    {
+        return saturate(aA);
+    }
+
+    //! \brief Add the product of both operands to the accumulator accA
+    static inline result_type_t mac(const result_type_t accA, const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(accA) + static_cast<int64_t>(aA) * bA);
+    }
+
+    //! \brief Absolute value of the first operand
+    static inline result_type_t abs(const operand_type_t aA)
+    {
+        return saturate(aA);
+    }
+
+    //! \brief Return the smaller operand
+    static inline result_type_t min(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate((aA <= bA) ? aA : bA);
+    }
+
+    //! \brief Shift aA left by bA modulo N bits
+    static inline result_type_t shl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) << (bA % N));
+    }
+
+    //! \brief Logical shift of aA right by bA modulo N bits
+    static inline result_type_t shr(const operand_type_t aA, const operand_type_t bA)
+    {
+        return saturate(static_cast<int64_t>(aA) >> (bA % N));
+    }
+
+    //! \brief Add the two operands with saturation to K bits
+    static inline result_type_t sadd(const operand_type_t aA, const operand_type_t bA)
+    {
+        return add(aA, bA);
+    }
+
+    //! \brief Subtract bA from aA with saturation to K bits
+    static inline result_type_t ssub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return sub(aA, bA);
+    }
+
+  private:
+    //! \brief Clamp an intermediate result to the result range
+    static inline result_type_t saturate(const int64_t valueA)
+    {
+        return static_cast<result_type_t>(saturate_to_unsigned_bitwidth<K>(valueA));
+    }
+};
+
+/************************************************************************/
+// Packed sub-word datapath
+//!
+//! \class PackedDatapath
+//! \brief Processing_Element datapath which calculates on L sub-word lanes
+//!
+//! \details
+//! A data value is split into L lanes of N / L (K / L) bit. Lane l occupies
+//! the bits (l + 1) * N / L - 1 downto l * N / L. Each operation is applied
+//! to all lanes independently with the semantics of the NativeDatapath of
+//! the lane bitwidth, i.e. carries, saturation and shift amounts never cross
+//! a lane boundary. VirtualChannels route the packed values unchanged.
+//!
+//! Signed lanes are sign extended and wrap around like the NativeDatapath.
+//! Unsigned lanes are zero extended and every lane result saturates, see
+//! UnsignedSaturatingDatapath. Thus, 8 bit pixels keep their values and
+//! sums which exceed a lane are clamped instead of wrapping into a
+//! neighbouring range.
+//!
+//! \tparam N Bitwidth of incoming data
+//! \tparam K Bitwidth of outgoing data
+//! \tparam L Number of lanes
+//! \tparam U Lanes are unsigned and saturating
+/************************************************************************/
+template <uint16_t N, uint16_t K, uint16_t L, bool U = false>
+struct PackedDatapath
+{
+    static_assert(0 == N % L && 0 == K % L, "Data bitwidths need to be multiples of the number of lanes");
+    static_assert(N <= 32 && K <= 32, "Packed datapath is limited to 32 bit values");
+
+    typedef typename std::conditional<U, UnsignedSaturatingDatapath<N / L, K / L>,
+                                      NativeDatapath<N / L, K / L>>::type lane_datapath_type_t;
+    //!< \brief Datapath of a single lane
+    typedef typename lane_datapath_type_t::operand_type_t lane_operand_type_t;
+    //!< \brief Type of a lane operand
+    typedef typename lane_datapath_type_t::result_type_t lane_result_type_t;
+    //!< \brief Type of a lane result
+    typedef typename native_int<N>::type operand_type_t;
+    //!< \brief Type of buffered operands
+    typedef typename native_int<K>::type result_type_t;
+    //!< \brief Type of operation results
+
+    //! \brief Convert a port value into an operand
+    static inline operand_type_t load(const sc_dt::sc_int<N>& valueA)
+    {
+        return static_cast<operand_type_t>(valueA.to_int64());
+    }
+    //! \brief Convert a result into a port value
+    static inline sc_dt::sc_int<K> store(const result_type_t valueA) { return valueA; }
+
+    /*!
+     * \brief Sign (zero) extended lane of a packed value
+     *
+     * \tparam W Bitwidth of the packed value
+     * \param[in] valueA Packed value
+     * \param[in] laneA  Index of the lane
+     */
+    template <uint16_t W>
+    static inline int64_t lane(const int64_t valueA, const uint16_t laneA)
+    {
+        return U ? static_cast<int64_t>((static_cast<uint64_t>(valueA) >> (laneA * (W / L))) & ((1ULL << (W / L)) - 1ULL))
+                 : wrap_to_bitwidth<W / L>(valueA >> (laneA * (W / L)));
+    }
+
+    /*!
+     * \brief Place a lane value into a packed value
+     *
+     * \tparam W Bitwidth of the packed value
+     * \param[in] valueA     Packed value
+     * \param[in] laneA      Index of the lane
+     * \param[in] laneValueA New value of the lane (truncated to W / L bit)
+     * \return Packed value with replaced lane
+     */
+    template <uint16_t W>
+    static inline int64_t insert(const int64_t valueA, const uint16_t laneA, const int64_t laneValueA)
+    {
+        const uint64_t t_mask{((1ULL << (W / L)) - 1ULL) << (laneA * (W / L))};
+        return wrap_to_bitwidth<W>(static_cast<int64_t>((static_cast<uint64_t>(valueA) & ~t_mask) |
+            ((static_cast<uint64_t>(laneValueA) << (laneA * (W / L))) & t_mask)));
+    }
+
+    //! \brief Add the two operands
+    static inline result_type_t add(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::add(a, b); });
+    }
+
+    //! \brief Subtract bA from aA
+    static inline result_type_t sub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::sub(a, b); });
+    }
+
+    //! \brief Multiply the two operands
+    static inline result_type_t mul(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::mul(a, b); });
+    }
+
+    //! \brief Integer division aA / bA
+    static inline result_type_t idiv(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::idiv(a, b); });
+    }
+
+    //! \brief Modulo operation aA % bA
+    static inline result_type_t mdl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::mdl(a, b); });
+    }
+
+    //! \brief Return the greater operand
+    static inline result_type_t gre(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::gre(a, b); });
+    }
+
+    //! \brief Return 1 if both operands are value-equal or 0 otherwise
+    static inline result_type_t equ(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::equ(a, b); });
+    }
+
+    //! \brief Pass through the first operand
+    static inline result_type_t buf(const operand_type_t aA)
+    {
+        return lanewise(aA, aA, [](lane_operand_type_t a, lane_operand_type_t) { return lane_datapath_type_t::buf(a); });
+    }
+
+    //! \brief Add the product of both operands to the accumulator accA
+    static inline result_type_t mac(const result_type_t accA, const operand_type_t aA, const operand_type_t bA)
+    {
+        int64_t t_result{0};
+        for (uint16_t t_lane = 0; L > t_lane; ++t_lane) {
+            t_result = insert<K>(t_result, t_lane, lane_datapath_type_t::mac(
+                static_cast<lane_result_type_t>(lane<K>(accA, t_lane)),
+                static_cast<lane_operand_type_t>(lane<N>(aA, t_lane)),
+                static_cast<lane_operand_type_t>(lane<N>(bA, t_lane))));
+        }
+        return static_cast<result_type_t>(t_result);
+    }
+
+    //! \brief Absolute value of the first operand
+    static inline result_type_t abs(const operand_type_t aA)
+    {
+        return lanewise(aA, aA, [](lane_operand_type_t a, lane_operand_type_t) { return lane_datapath_type_t::abs(a); });
+    }
+
+    //! \brief Return the smaller operand
+    static inline result_type_t min(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::min(a, b); });
+    }
+
+    //! \brief Shift aA left by bA modulo N / L bits
+    static inline result_type_t shl(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::shl(a, b); });
+    }
+
+    //! \brief Arithmetic (logical for unsigned lanes) shift of aA right by bA modulo N / L bits
+    static inline result_type_t shr(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::shr(a, b); });
+    }
+
+    //! \brief Add the two operands with saturation to K / L bits
+    static inline result_type_t sadd(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::sadd(a, b); });
+    }
+
+    //! \brief Subtract bA from aA with saturation to K / L bits
+    static inline result_type_t ssub(const operand_type_t aA, const operand_type_t bA)
+    {
+        return lanewise(aA, bA, [](lane_operand_type_t a, lane_operand_type_t b) { return lane_datapath_type_t::ssub(a, b); });
+    }
+
+  private:
+    //! \brief Apply a lane operation to all lanes of both operands
+    template <typename F>
+    static inline result_type_t lanewise(const operand_type_t aA, const operand_type_t bA, F opA)
+    {
+        int64_t t_result{0};
+        for (uint16_t t_lane = 0; L > t_lane; ++t_lane) {
+            t_result = insert<K>(t_result, t_lane, opA(static_cast<lane_operand_type_t>(lane<N>(aA, t_lane)),
+                                                       static_cast<lane_operand_type_t>(lane<N>(bA, t_lane))));
+        }
+        return static_cast<result_type_t>(t_result);
+    }
+};
+
+} /* namespace cgra */
+
+#endif /* HEADER_PEDATAPATH_H_ */
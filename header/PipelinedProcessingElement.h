@@ -0,0 +1,448 @@
+/*
+ * PipelinedProcessingElement.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef HEADER_PIPELINEDPROCESSINGELEMENT_H_
+#define HEADER_PIPELINEDPROCESSINGELEMENT_H_
+
+#include <systemc>
+#include <cstdint>
+#include <array>
+#include <string>
+#include <iomanip>
+#include "Typedef.h"
+#include "PeDatapath.h"
+
+#ifdef ACTIVITY_GATING
+#include "ClockEdgeTracker.hpp"
+#endif
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+namespace cgra
+{
+
+/************************************************************************/
+// Pipelined Processing Element
+//!
+//! \class PipelinedProcessing_Element
+//! \brief Processing element with an initiation interval of one clock cycle
+//!
+//! \details
+//! The interface equals Processing_Element. Instead of a state machine the
+//! PE consists of two pipeline stages which are updated on every rising
+//! clock edge:
+//!  1. SAMPLE: Operands are registered together with the AND of both enables.
+//!  2. EXECUTE: The configured operation is applied to the registered operands.
+//!     Result and valid are written together.
+//!
+//! Thus, a PE accepts a new operand pair every clock cycle and its result is
+//! valid at the clock edge after the operands were sampled (one clock cycle
+//! earlier than the result of a Processing_Element). The configuration is
+//! read in the EXECUTE stage.
+//!
+//! \tparam N Bitwidth of incoming data
+//! \tparam K Bitwidth of outgoing data
+//! \tparam L Bitwidth of configuration data
+//! \tparam D Datapath policy which performs the operations (ScIntDatapath, NativeDatapath or PackedDatapath)
+/************************************************************************/
+template <uint16_t N = 8, uint16_t K = 8, uint16_t L = 4, typename D = cgra::ScIntDatapath<N, K>>
+class PipelinedProcessing_Element : public sc_core::sc_module
+{
+  public:
+	typedef sc_dt::sc_int<N> input_type_t;
+	//!< \brief Type of Processing_Elements data inputs
+	typedef cgra::config_vector_t<L> config_type_t;
+	//!< \brief Type of Processing_Elements configuration input
+	typedef sc_dt::sc_int<K> output_type_t;
+	//!< \brief Type of Processing_Elements data output
+	typedef cgra::start_type_t enable_type_t;
+	//!< \brief Type of Processing_Elements enable inputs
+	typedef cgra::clock_type_t clock_type_t;
+	//!< \brief Clock type
+	typedef bool valid_type_t;
+	//!< \brief Valid type
+	typedef D datapath_type_t;
+	//!< \brief Datapath policy which performs the operations
+
+	typedef cgra::PeOperations::OP OP;
+	//!< \brief Operations of a processing element
+
+	static constexpr uint32_t cLatency{2};
+	//!< \brief Clock edges from sampled enables to a valid result
+
+#ifndef GSYSC
+	//interfaces
+	sc_core::sc_in<input_type_t> in1{"In1"};  			//!< \brief input one
+	sc_core::sc_in<input_type_t> in2{"In2"};   			//!< \brief input two
+	sc_core::sc_in<config_type_t> conf{"conf"};   		//!< \brief configuration of PE (operation)
+	sc_core::sc_in<clock_type_t> clk{"clk"};			//!< \brief clock
+	std::array<sc_core::sc_in<enable_type_t>,2> enable; //!< \brief synchronization of inputs
+	sc_core::sc_out<output_type_t> res{"res"}; 			//!< \brief operation result
+	sc_core::sc_out<valid_type_t> valid{"valid"};		//!< \brief synchronization of output
+#else
+	//interfaces
+	sc_in<input_type_t> in1{"In1"};  			//!< \brief input one
+	sc_in<input_type_t> in2{"In2"};   			//!< \brief input two
+	sc_in<config_type_t> conf{"conf"};   		//!< \brief configuration of PE (operation)
+	sc_in<clock_type_t> clk{"clk"};			    //!< \brief clock
+	std::array<sc_in<enable_type_t>,2> enable;  //!< \brief synchronization of inputs
+	sc_out<output_type_t> res{"res"}; 			//!< \brief operation result
+	sc_out<valid_type_t> valid{"valid"};		//!< \brief synchronization of output
+#endif
+
+	//Constructor
+	SC_HAS_PROCESS(PipelinedProcessing_Element);
+	/*!
+	 * \brief General Constructor
+	 *
+	 * \param[in] nameA			Name of ProcessingElement instance
+	 * \param[in] pe_numberA 	Unique ID of a ProcessingElement instance
+	 */
+	PipelinedProcessing_Element(const sc_core::sc_module_name& nameA, const uint32_t pe_numberA) : sc_module(nameA), m_peId{pe_numberA}
+#ifdef MCPAT
+	,m_totalCycles{0U}, m_idleCycles{0U}, m_busyCycles{0U}, m_ialuAccesses{0U}, m_mulAccesses{0U}
+#endif
+	{
+		SC_METHOD(perform);
+		sensitive << clk.pos();
+
+		SC_METHOD(decode_configuration);
+		sensitive << conf;
+		dont_initialize();
+	}
+
+
+	//callback
+	/*!
+	 * \brief SystemC Module callback after port bindings to initialize outputs
+	 */
+	virtual void end_of_elaboration() override
+	{
+		valid.write(false);
+
+		m_invalues[0] = 0;
+		m_invalues[1] = 0;
+		m_accumulator = 0;
+
+#ifdef ACTIVITY_GATING
+		m_enableActivity |= enable[0].value_changed_event();
+		m_enableActivity |= enable[1].value_changed_event();
+		//A new operand mode may complete the enables of an immediate operand
+		m_enableActivity |= conf.value_changed_event();
+		m_edgeTracker.init(clk);
+#endif
+	}
+
+	/*!
+	 * \brief Print kind of SystemC-module
+	 */
+	virtual const char* kind() const override {
+		return "Pipelined Processing Element";
+	}
+
+	/*!
+	 *  \brief Print PE name
+	 *
+	 * \param[out] os Define used outstream [default: std::cout]
+	 */
+	virtual void print(std::ostream& os = ::std::cout) const override
+	{
+		os << name();
+	}
+
+#ifdef MCPAT
+	/**
+	 * \brief Dump runtime statistics for McPAT simulation
+	 *
+	 * \param os Define used outstream [default: std::cout]
+	 */
+	void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
+	{
+#ifdef ACTIVITY_GATING
+		//A suspended PE has empty pipeline stages, thus it is idle for all missed cycles
+		const uint32_t t_pending = m_suspended ? m_edgeTracker.pending() : 0U;
+#else
+		const uint32_t t_pending = 0U;
+#endif
+		os << name() << "\t\t" << kind() << "\tID: " << std::setw(3) <<  m_peId << "\n";
+		os << "total cycles: " << m_totalCycles + t_pending << "\n";
+		os << "idle cycles: " << m_idleCycles + t_pending << "\n";
+		os << "busy cycles: " << m_busyCycles << "\n";
+		os << "ialu accesses: " << m_ialuAccesses << "\n";
+		os << "mul accesses: " << m_mulAccesses << "\n";
+		os << std::endl;
+	}
+#endif
+
+	/*!
+	 * \brief Dump PE information
+	 *
+	 * \param[out] os Define used outstream [default: std::cout]
+	 */
+	virtual void dump(std::ostream& os = ::std::cout) const override
+	{
+		os << name() << "\t\t" << kind() << "\tID: " << std::setw(3) <<  m_peId << std::endl;
+		os << "Input bitwidth:\t\t" << std::setw(3) << N << "\n";
+		os << "Output bitwidth:\t" << std::setw(3) << K << "\n";
+		os << "Sample stage:\t\t" << (m_sampled ? "VALID" : "EMPTY") << "\n";
+
+		os << "Current Operation:\t";
+		if(conf.size()) //Check for port-binding status?
+		{
+			switch (m_operation)
+			{
+			case OP::NONE:
+				os << "NONE";
+				break;
+			case OP::ADD:
+				os << "ADD";
+				break;
+			case OP::SUB:
+				os << "SUB";
+				break;
+			case OP::MUL:
+				os << "MUL";
+				break;
+			case OP::IDIV:
+				os << "IDIV";
+				break;
+			case OP::MDL:
+				os << "MDL";
+				break;
+			case OP::GRE:
+				os << "GRE";
+				break;
+			case OP::EQU:
+				os << "EQU";
+				break;
+			case OP::BUF:
+				os << "BUF";
+				break;
+			case OP::MAC:
+				os << "MAC";
+				break;
+			case OP::ABS:
+				os << "ABS";
+				break;
+			case OP::MIN:
+				os << "MIN";
+				break;
+			case OP::SHL:
+				os << "SHL";
+				break;
+			case OP::SHR:
+				os << "SHR";
+				break;
+			case OP::SADD:
+				os << "SADD";
+				break;
+			case OP::SSUB:
+				os << "SSUB";
+				break;
+			default:
+				os << "ERROR";
+			}
+			os << std::endl;
+			if (m_immediateMode)
+				os << "Immediate In2:\t\t" << m_immediate << std::endl;
+		}
+		else
+			os << "NONE" << std::endl;
+	}
+
+	//process
+	/*!
+	 * \brief PE process method
+	 *
+	 * \details
+	 * On every positive clock edge the EXECUTE stage processes the operands
+	 * of the SAMPLE stage, before the SAMPLE stage registers the current
+	 * inputs. With ACTIVITY_GATING, a PE with empty pipeline stages suspends
+	 * itself until one of its enable inputs or its configuration changes.
+	 */
+	void perform()
+	{
+#ifdef ACTIVITY_GATING
+		if (m_suspended)
+		{
+			//Woken up by an enable input or the configuration, continue on the next clock edge
+			m_suspended = false;
+			if (!clk.posedge())
+				return;
+		}
+#ifdef MCPAT
+		//Pipeline stages of a suspended PE are empty, thus all missed cycles are idle
+		const uint32_t t_missedCycles{m_edgeTracker.observe()};
+		m_totalCycles += t_missedCycles;
+		m_idleCycles += t_missedCycles;
+#endif
+#endif
+#ifdef MCPAT
+		++m_totalCycles;
+		if (m_sampled)
+			++m_busyCycles;
+		else
+			++m_idleCycles;
+#endif
+
+		//EXECUTE stage: unknown operations do not produce a valid result
+		bool t_valid{false};
+		if (m_sampled)
+		{
+			t_valid = true;
+			switch (m_operation)
+			{
+			case OP::ADD:
+				res.write(D::store(D::add(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::SUB:
+				res.write(D::store(D::sub(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::MUL:
+				res.write(D::store(D::mul(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::IDIV:
+				res.write(D::store(D::idiv(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::MDL:
+				res.write(D::store(D::mdl(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::GRE:
+				res.write(D::store(D::gre(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::EQU:
+				res.write(D::store(D::equ(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::BUF:
+				res.write(D::store(D::buf(m_invalues[0])));
+				break;
+			case OP::MAC:
+				m_accumulator = D::mac(m_accumulator, m_invalues[0], m_invalues[1]);
+				res.write(D::store(m_accumulator));
+				break;
+			case OP::ABS:
+				res.write(D::store(D::abs(m_invalues[0])));
+				break;
+			case OP::MIN:
+				res.write(D::store(D::min(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::SHL:
+				res.write(D::store(D::shl(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::SHR:
+				res.write(D::store(D::shr(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::SADD:
+				res.write(D::store(D::sadd(m_invalues[0], m_invalues[1])));
+				break;
+			case OP::SSUB:
+				res.write(D::store(D::ssub(m_invalues[0], m_invalues[1])));
+				break;
+			default:
+				t_valid = false;
+			}
+#ifdef MCPAT
+			if (t_valid)
+			{
+				if (cgra::PeOperations::usesMultiplier(m_operation))
+					++m_mulAccesses;
+				else
+					++m_ialuAccesses;
+			}
+#endif
+		}
+		valid.write(t_valid);
+
+		//SAMPLE stage
+		m_sampled = enable[0].read() && (enable[1].read() || m_immediateMode);
+		if (m_sampled)
+		{
+			m_invalues[0] = D::load(in1.read());
+			m_invalues[1] = m_immediateMode ? m_immediate : D::load(in2.read());
+		}
+
+#ifdef ACTIVITY_GATING
+		//Both stages are empty and valid is low, nothing changes until an enable input or the configuration changes
+		if (!m_sampled && !t_valid)
+		{
+			next_trigger(m_enableActivity);
+			m_suspended = true;
+		}
+#endif
+	}
+
+	/*!
+	 * \brief Decode a new configuration and clear the MAC accumulator
+	 *
+	 * \details
+	 * The operation code is located in the most significant bits of the
+	 * configuration. If the configuration is wide enough (PE_IMMEDIATES),
+	 * it is followed by the operand mode and the immediate operand.
+	 */
+	void decode_configuration()
+	{
+		const config_type_t t_config{conf.read()};
+
+		m_operation = t_config.range(L - 1, L - cOperationBitwidth).to_uint();
+		if (cImmediates)
+		{
+			const uint32_t t_mode{t_config.range(cImmediateBitwidth + cgra::cPeModeBitwidth - 1, cImmediateBitwidth).to_uint()};
+			input_type_t t_immediate;
+			t_immediate = t_config.range(cImmediateBitwidth - 1, 0).to_uint();
+
+			m_immediateMode = 0 != (t_mode & cgra::PeOperations::IMMEDIATE);
+			m_immediate = D::load(t_immediate);
+		}
+		m_accumulator = 0;
+	}
+
+	//Destructor
+	virtual ~PipelinedProcessing_Element() = default;
+
+  private:
+	static constexpr uint16_t cOperationBitwidth{L < cgra::cPeOperationBitwidth ? L : cgra::cPeOperationBitwidth};
+	//!< \brief Bitwidth of the operation code within the configuration
+	static constexpr uint16_t cImmediateBitwidth{N};
+	//!< \brief Bitwidth of the immediate operand within the configuration
+	static constexpr bool cImmediates{L >= cgra::cPeOperationBitwidth + cgra::cPeModeBitwidth + cImmediateBitwidth};
+	//!< \brief Configuration contains an operand mode and an immediate operand
+
+	//private member:
+	std::array<typename D::operand_type_t, 2> m_invalues; 			//!< \brief Operand registers of the SAMPLE stage
+	bool m_sampled{false};											//!< \brief SAMPLE stage holds valid operands
+	typename D::result_type_t m_accumulator;						//!< \brief Accumulator of MAC operations
+	uint32_t m_operation{OP::NONE};									//!< \brief Decoded operation code
+	bool m_immediateMode{false};									//!< \brief In2 is replaced by the immediate operand
+	typename D::operand_type_t m_immediate{0};						//!< \brief Immediate operand of the configuration
+	const uint32_t m_peId;											//!< \brief A processing element's unique ID
+#ifdef ACTIVITY_GATING
+	sc_core::sc_event_or_list m_enableActivity;						//!< \brief Value changes of the enable inputs and the configuration
+	cgra::ClockEdgeTracker m_edgeTracker;							//!< \brief Reconstructs clock cycles while suspended
+	bool m_suspended{false};										//!< \brief PE waits for an enable input or configuration change
+#endif
+
+	//forbidden constructor
+	PipelinedProcessing_Element() = delete;
+	PipelinedProcessing_Element(const PipelinedProcessing_Element &source) = delete;			  //!< \brief because sc_module could not be copied
+	PipelinedProcessing_Element(PipelinedProcessing_Element &&source) = delete;				  //!< \brief because move not implemented for sc_module
+	PipelinedProcessing_Element &operator=(const PipelinedProcessing_Element &source) = delete; //!< \brief because sc_module could not be copied
+	PipelinedProcessing_Element &operator=(PipelinedProcessing_Element &&source) = delete;	  //!< \brief because move not implemented for sc_module
+
+#ifdef MCPAT
+	//McPAT dynamic statistic counters:
+	uint32_t m_totalCycles;   //!< \brief Count total number of executed cycles
+	uint32_t m_idleCycles;    //!< \brief Count number of idle cycles
+	uint32_t m_busyCycles;    //!< \brief Count number of working cycles
+	uint32_t m_ialuAccesses;  //!< \brief Count number of integer ALU operations
+	uint32_t m_mulAccesses;   //!< \brief Count number of multiplier/divider operations
+#endif
+};
+
+} /* namespace cgra */
+
+#endif /* HEADER_PIPELINEDPROCESSINGELEMENT_H_ */
@@ -14,6 +14,11 @@
 #include <string>
 #include <iomanip>
 #include "Typedef.h"
+#include "PeDatapath.h"
+
+#ifdef ACTIVITY_GATING
+#include "ClockEdgeTracker.hpp"
+#endif
 
 #ifdef GSYSC
 #include <gsysc.h>
@@ -35,14 +40,15 @@ namespace cgra
 //! \tparam N Bitwidth of incoming data
 //! \tparam K Bitwidth of outgoing data
 //! \tparam L Bitwidth of configuration data
+//! \tparam D Datapath policy which performs the operations (ScIntDatapath, NativeDatapath or PackedDatapath)
 /************************************************************************/
-template <uint16_t N = 8, uint16_t K = 8, uint16_t L = 4>
+template <uint16_t N = 8, uint16_t K = 8, uint16_t L = 4, typename D = cgra::ScIntDatapath<N, K>>
 class Processing_Element : public sc_core::sc_module
 {
   public:
 	typedef sc_dt::sc_int<N> input_type_t;
 	//!< \brief Type of Processing_Elements data inputs
-	typedef sc_dt::sc_lv<L> config_type_t;
+	typedef cgra::config_vector_t<L> config_type_t;
 	//!< \brief Type of Processing_Elements configuration input
 	typedef sc_dt::sc_int<K> output_type_t;
 	//!< \brief Type of Processing_Elements data output
@@ -52,21 +58,11 @@ class Processing_Element : public sc_core::sc_module
 	//!< \brief Clock type
 	typedef bool valid_type_t;
 	//!< \brief Valid type
+	typedef D datapath_type_t;
+	//!< \brief Datapath policy which performs the operations
 
-	//! \enum OP
-	//! \brief Operations of a processing element
-	enum OP
-	{
-		NONE = 0,		//!< \brief PE will not perform any operation on data inputs
-		ADD,			//!< \brief Add two integers
-		SUB,			//!< \brief Subtract two integers
-		MUL,			//!< \brief Multiply two integers
-		IDIV,			//!< \brief Integer division of two integers
-		MDL,			//!< \brief Modulo operation
-		GRE,			//!< \brief Return greater value of In1 and In2
-		EQU,			//!< \brief True if both inputs are equal
-		BUF				//!< \brief Buffer Input one for one clock cycle
-	};
+	typedef cgra::PeOperations::OP OP;
+	//!< \brief Operations of a processing element
 
 #ifndef GSYSC
 	//interfaces
@@ -98,11 +94,15 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	Processing_Element(const sc_core::sc_module_name& nameA, const uint32_t pe_numberA) : sc_module(nameA), m_peId{pe_numberA}
 #ifdef MCPAT
-	,m_totalCycles{0U}, m_idleCycles{0U}, m_busyCycles{0U}
+	,m_totalCycles{0U}, m_idleCycles{0U}, m_busyCycles{0U}, m_ialuAccesses{0U}, m_mulAccesses{0U}
 #endif
 	{
 		SC_METHOD(perform);
 		sensitive << clk;
+
+		SC_METHOD(decode_configuration);
+		sensitive << conf;
+		dont_initialize();
 	}
 
 
@@ -114,8 +114,17 @@ class Processing_Element : public sc_core::sc_module
 	{
 		valid.write(false);
 
-		m_invalues[0].write(0);
-		m_invalues[1].write(0);
+		m_invalues[0] = 0;
+		m_invalues[1] = 0;
+		m_accumulator = 0;
+
+#ifdef ACTIVITY_GATING
+		m_enableActivity |= enable[0].value_changed_event();
+		m_enableActivity |= enable[1].value_changed_event();
+		//A new operand mode may complete the enables of an immediate operand
+		m_enableActivity |= conf.value_changed_event();
+		m_edgeTracker.init(clk);
+#endif
 	}
 
 	/*!
@@ -143,10 +152,18 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
 	{
+#ifdef ACTIVITY_GATING
+		//A suspended PE is idle for all clock cycles it did not observe
+		const uint32_t t_pending = m_suspended ? m_edgeTracker.pending() : 0U;
+#else
+		const uint32_t t_pending = 0U;
+#endif
 		os << name() << "\t\t" << kind() << "\tID: " << std::setw(3) <<  m_peId << "\n";
-		os << "total cycles: " << m_totalCycles << "\n";
-		os << "idle cycles: " << m_idleCycles << "\n";
+		os << "total cycles: " << m_totalCycles + t_pending << "\n";
+		os << "idle cycles: " << m_idleCycles + t_pending << "\n";
 		os << "busy cycles: " << m_busyCycles << "\n";
+		os << "ialu accesses: " << m_ialuAccesses << "\n";
+		os << "mul accesses: " << m_mulAccesses << "\n";
 		os << std::endl;
 	}
 #endif
@@ -180,7 +197,7 @@ class Processing_Element : public sc_core::sc_module
 		os << "Current Operation:\t";
 		if(conf.size()) //Check for port-binding status?
 		{
-			switch (conf.read().to_uint())
+			switch (m_operation)
 			{
 			case OP::NONE:
 				os << "NONE";
@@ -209,10 +226,33 @@ class Processing_Element : public sc_core::sc_module
 			case OP::BUF:
 				os << "BUF";
 				break;
+			case OP::MAC:
+				os << "MAC";
+				break;
+			case OP::ABS:
+				os << "ABS";
+				break;
+			case OP::MIN:
+				os << "MIN";
+				break;
+			case OP::SHL:
+				os << "SHL";
+				break;
+			case OP::SHR:
+				os << "SHR";
+				break;
+			case OP::SADD:
+				os << "SADD";
+				break;
+			case OP::SSUB:
+				os << "SSUB";
+				break;
 			default:
 				os << "ERROR";
 			}
 			os << std::endl;
+			if (m_immediateMode)
+				os << "Immediate In2:\t\t" << m_immediate << std::endl;
 		}
 		else
 			os << "NONE" << std::endl;
@@ -226,19 +266,36 @@ class Processing_Element : public sc_core::sc_module
 	 * on every positive clock cycle depending on the internal state
 	 * an operation is processed, outputs are set to valid or the PE
 	 * waits for new values.
+	 * With ACTIVITY_GATING, an idle PE suspends itself until one of its
+	 * enable inputs or its configuration changes instead of waking up on
+	 * every clock edge.
 	 */
 	void perform()
 	{
+#ifdef ACTIVITY_GATING
+		if (m_suspended)
+		{
+			//Woken up by an enable input or the configuration, continue on the next clock edge
+			m_suspended = false;
+			if (!clk.posedge())
+				return;
+		}
+#endif
 		if (clk.posedge())
 		{
+#ifdef ACTIVITY_GATING
+			const STATE t_previousState{m_current_state};
+#ifdef MCPAT
+			//A suspended PE stays in AWAIT_DATA, thus all missed cycles are idle
+			const uint32_t t_missedCycles{m_edgeTracker.observe()};
+			m_totalCycles += t_missedCycles;
+			m_idleCycles += t_missedCycles;
+#endif
+#endif
 #ifdef MCPAT
 			++m_totalCycles;
 #endif
 
-			//save current signals in internal buffers
-			this->m_invalues[0].write(in1.read());
-			this->m_invalues[1].write(in2.read());
-
 			//state machine of a processing element
 			switch (this->m_current_state)
 			{
@@ -252,7 +309,7 @@ class Processing_Element : public sc_core::sc_module
 
 				this->valid.write(false);
 
-				if (this->enable[0] == true && this->enable[1] == true)
+				if (this->enable[0] == true && (this->enable[1] == true || m_immediateMode))
 					this->m_current_state = STATE::PROCESS_DATA;
 				else
 					this->m_current_state = STATE::AWAIT_DATA;
@@ -266,9 +323,10 @@ class Processing_Element : public sc_core::sc_module
 
 #ifdef MCPAT
 				++m_busyCycles;
+				countAccess(m_operation);
 #endif
 
-				switch (this->conf.read().to_uint())
+				switch (m_operation)
 				{
 				case OP::ADD: //ADD
 					addition();
@@ -302,6 +360,27 @@ class Processing_Element : public sc_core::sc_module
 					buffer();
 //					std::cout << "@ " << sc_core::sc_time_stamp() << " OP=BUF" << std::endl;
 					break;
+				case OP::MAC: //MULTIPLY-ACCUMULATE
+					multiply_accumulate();
+					break;
+				case OP::ABS: //ABSOLUTE VALUE
+					absolute();
+					break;
+				case OP::MIN: //MINIMUM
+					minimum();
+					break;
+				case OP::SHL: //SHIFT LEFT
+					shift_left();
+					break;
+				case OP::SHR: //ARITHMETIC SHIFT RIGHT
+					shift_right();
+					break;
+				case OP::SADD: //SATURATING ADD
+					saturating_addition();
+					break;
+				case OP::SSUB: //SATURATING SUBTRACT
+					saturating_subtraction();
+					break;
 				default:
 //					std::cout << "@ " << sc_core::sc_time_stamp() << "default stage" << std::endl;
 					this->m_current_state = STATE::AWAIT_DATA;
@@ -320,7 +399,46 @@ class Processing_Element : public sc_core::sc_module
 			default:
 				this->m_current_state = STATE::AWAIT_DATA;
 			};
+
+			//save current signals in internal buffers, they are the operands
+			//if the state machine enters PROCESS_DATA in the next clock cycle
+			this->m_invalues[0] = D::load(in1.read());
+			this->m_invalues[1] = m_immediateMode ? m_immediate : D::load(in2.read());
+
+#ifdef ACTIVITY_GATING
+			//valid is already low, nothing changes until an enable input or the configuration changes
+			if (STATE::AWAIT_DATA == t_previousState && STATE::AWAIT_DATA == m_current_state)
+			{
+				next_trigger(m_enableActivity);
+				m_suspended = true;
+			}
+#endif
+		}
+	}
+
+	/*!
+	 * \brief Decode a new configuration and clear the MAC accumulator
+	 *
+	 * \details
+	 * The operation code is located in the most significant bits of the
+	 * configuration. If the configuration is wide enough (PE_IMMEDIATES),
+	 * it is followed by the operand mode and the immediate operand.
+	 */
+	void decode_configuration()
+	{
+		const config_type_t t_config{conf.read()};
+
+		m_operation = t_config.range(L - 1, L - cOperationBitwidth).to_uint();
+		if (cImmediates)
+		{
+			const uint32_t t_mode{t_config.range(cImmediateBitwidth + cgra::cPeModeBitwidth - 1, cImmediateBitwidth).to_uint()};
+			input_type_t t_immediate;
+			t_immediate = t_config.range(cImmediateBitwidth - 1, 0).to_uint();
+
+			m_immediateMode = 0 != (t_mode & cgra::PeOperations::IMMEDIATE);
+			m_immediate = D::load(t_immediate);
 		}
+		m_accumulator = 0;
 	}
 
 	//Destructor
@@ -337,10 +455,26 @@ class Processing_Element : public sc_core::sc_module
 		VALID_DATA		//!< \brief Set current result valid for one clock cycle
 	};
 
+	static constexpr uint16_t cOperationBitwidth{L < cgra::cPeOperationBitwidth ? L : cgra::cPeOperationBitwidth};
+	//!< \brief Bitwidth of the operation code within the configuration
+	static constexpr uint16_t cImmediateBitwidth{N};
+	//!< \brief Bitwidth of the immediate operand within the configuration
+	static constexpr bool cImmediates{L >= cgra::cPeOperationBitwidth + cgra::cPeModeBitwidth + cImmediateBitwidth};
+	//!< \brief Configuration contains an operand mode and an immediate operand
+
 	//private member:
-	std::array<sc_core::sc_buffer<input_type_t>, 2> m_invalues; 	//!< \brief Input buffers
+	std::array<typename D::operand_type_t, 2> m_invalues; 			//!< \brief Input buffers
+	typename D::result_type_t m_accumulator;						//!< \brief Accumulator of MAC operations
+	uint32_t m_operation{OP::NONE};									//!< \brief Decoded operation code
+	bool m_immediateMode{false};									//!< \brief In2 is replaced by the immediate operand
+	typename D::operand_type_t m_immediate{0};						//!< \brief Immediate operand of the configuration
 	const uint32_t m_peId;											//!< \brief A processing element's unique ID
 	STATE m_current_state{STATE::AWAIT_DATA};						//!< \brief The internal state of the processing element
+#ifdef ACTIVITY_GATING
+	sc_core::sc_event_or_list m_enableActivity;						//!< \brief Value changes of the enable inputs and the configuration
+	cgra::ClockEdgeTracker m_edgeTracker;							//!< \brief Reconstructs clock cycles while suspended
+	bool m_suspended{false};										//!< \brief PE waits for an enable input or configuration change
+#endif
 
 	//forbidden constructor
 	Processing_Element() = delete;
@@ -358,6 +492,21 @@ class Processing_Element : public sc_core::sc_module
 	uint32_t m_totalCycles;   //!< \brief Count total number of executed cycles
 	uint32_t m_idleCycles;    //!< \brief Count number of idle cycles
 	uint32_t m_busyCycles;    //!< \brief Count number of working cycles
+	uint32_t m_ialuAccesses;  //!< \brief Count number of integer ALU operations
+	uint32_t m_mulAccesses;   //!< \brief Count number of multiplier/divider operations
+
+	/*!
+	 * \brief Count the functional unit access of an operation
+	 */
+	inline void countAccess(const uint32_t opA)
+	{
+		if (OP::NONE == opA || OP::LAST < opA)
+			return;
+		if (cgra::PeOperations::usesMultiplier(opA))
+			++m_mulAccesses;
+		else
+			++m_ialuAccesses;
+	}
 #endif
 	//a processing element's operations
 	/*!
@@ -365,7 +514,7 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void addition()
 	{
-		res.write(m_invalues[0].read() + m_invalues[1].read());
+		res.write(D::store(D::add(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -373,20 +522,15 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void subtraction()
 	{
-		res.write(m_invalues[0].read() - m_invalues[1].read());
+		res.write(D::store(D::sub(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
 	 * \brief Multiplies the two inputs
-	 *
-	 * \details
-	 * Internally, SystemC Integer data type is managed as int64.
-	 * Thus, input data bitwidth is limited to 32 bit, each.
 	 */
 	inline void multiplication()
 	{
-		sc_assert(m_invalues[0].read().length() <= 32 || m_invalues[1].read().length() <= 32);
-		res.write(m_invalues[0].read() * m_invalues[1].read());
+		res.write(D::store(D::mul(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -394,9 +538,7 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void idivide()
 	{
-		sc_dt::int64 temp_res = 0;
-		temp_res = static_cast<sc_dt::int64>(m_invalues[0].read().to_int() / m_invalues[1].read().to_int());
-		res.write(temp_res);
+		res.write(D::store(D::idiv(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -404,8 +546,7 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void modulo()
 	{
-		res.write(m_invalues[0].read() % m_invalues[1].read());
-
+		res.write(D::store(D::mdl(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -413,7 +554,7 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void greater()
 	{
-		res.write((m_invalues[0].read() >= m_invalues[1].read()) ? m_invalues[0].read() : m_invalues[1].read());
+		res.write(D::store(D::gre(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -421,7 +562,7 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void equal()
 	{
-		res.write((m_invalues[0].read() == m_invalues[1].read()) ? 1 : 0);
+		res.write(D::store(D::equ(m_invalues[0], m_invalues[1])));
 	}
 
 	/*!
@@ -429,7 +570,64 @@ class Processing_Element : public sc_core::sc_module
 	 */
 	inline void buffer()
 	{
-		res.write(m_invalues[0].read());
+		res.write(D::store(D::buf(m_invalues[0])));
+	}
+
+	/*!
+	 * \brief Adds the product of in1 and in2 to the accumulator and returns it
+	 */
+	inline void multiply_accumulate()
+	{
+		m_accumulator = D::mac(m_accumulator, m_invalues[0], m_invalues[1]);
+		res.write(D::store(m_accumulator));
+	}
+
+	/*!
+	 * \brief Returns the absolute value of in1
+	 */
+	inline void absolute()
+	{
+		res.write(D::store(D::abs(m_invalues[0])));
+	}
+
+	/*!
+	 * \brief Returns the smaller input of in1 and in2
+	 */
+	inline void minimum()
+	{
+		res.write(D::store(D::min(m_invalues[0], m_invalues[1])));
+	}
+
+	/*!
+	 * \brief Shifts in1 left by in2 bits
+	 */
+	inline void shift_left()
+	{
+		res.write(D::store(D::shl(m_invalues[0], m_invalues[1])));
+	}
+
+	/*!
+	 * \brief Shifts in1 arithmetically right by in2 bits
+	 */
+	inline void shift_right()
+	{
+		res.write(D::store(D::shr(m_invalues[0], m_invalues[1])));
+	}
+
+	/*!
+	 * \brief Adds the two inputs with saturation
+	 */
+	inline void saturating_addition()
+	{
+		res.write(D::store(D::sadd(m_invalues[0], m_invalues[1])));
+	}
+
+	/*!
+	 * \brief Subtracts in2 from in1 with saturation
+	 */
+	inline void saturating_subtraction()
+	{
+		res.write(D::store(D::ssub(m_invalues[0], m_invalues[1])));
 	}
 
 };
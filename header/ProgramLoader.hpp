@@ -0,0 +1,105 @@
+/*
+ * ProgramLoader.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PROGRAM_LOADER_H_
+#define PROGRAM_LOADER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cgra
+{
+
+/*!
+ * \class ProgramLoader
+ *
+ * \brief Load a binary assembler program for the ManagementUnit
+ *
+ * \details
+ * A binary program file consists of packed 32 bit assembler commands in
+ * little-endian byte order without any header, i.e. the file size is a
+ * multiple of four bytes.
+ *
+ * On POSIX systems with a little-endian host the file is memory-mapped and
+ * the commands are read directly from the mapping. Otherwise, the file is
+ * read into a local buffer.
+ */
+class ProgramLoader
+{
+public:
+    /*!
+     * \brief Create an empty loader
+     */
+    ProgramLoader() = default;
+
+    /*!
+     * \brief Unmap or release a loaded program
+     */
+    ~ProgramLoader();
+
+    /*!
+     * \brief Load a binary program file
+     *
+     * \param[in] pathA Path to binary program file
+     *
+     * \return true: Program loaded successfully
+     * \return false: File does not exist or its size is no multiple of four bytes
+     */
+    bool load(const std::string& pathA);
+
+    /*!
+     * \brief Write assembler commands as binary program file
+     *
+     * \param[in] pathA     Path to binary program file
+     * \param[in] programA  Pointer to assembler commands
+     * \param[in] sizeA     Number of assembler commands
+     *
+     * \return true: Program written successfully
+     * \return false: File could not be written
+     */
+    static bool save(const std::string& pathA, const uint32_t* programA, std::size_t sizeA);
+
+    /*!
+     * \brief Pointer to the first assembler command
+     */
+    const uint32_t* data() const { return m_data; }
+
+    /*!
+     * \brief Number of loaded assembler commands
+     */
+    std::size_t size() const { return m_size; }
+
+    /*!
+     * \brief True if the program is read from a memory-mapped file
+     */
+    bool mapped() const { return nullptr != m_mapping; }
+
+private:
+    /*!
+     * \brief Release a previously loaded program
+     */
+    void release();
+
+    const uint32_t* m_data{nullptr};
+    //!< \brief Assembler commands in host byte order
+    std::size_t m_size{0};
+    //!< \brief Number of assembler commands
+    void* m_mapping{nullptr};
+    //!< \brief Start of memory-mapped file
+    std::size_t m_mappingLength{0};
+    //!< \brief Length of memory-mapped file in bytes
+    std::vector<uint32_t> m_buffer;
+    //!< \brief Local program buffer if the file is not memory-mapped
+
+    ProgramLoader(const ProgramLoader& src) = delete;
+    ProgramLoader& operator=(const ProgramLoader& src) = delete;
+};
+
+} // namespace cgra
+
+#endif // PROGRAM_LOADER_H_
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <array>
+#include "Typedef.h"
 
 #ifdef GSYSC
 #include <gsysc.h>
@@ -55,7 +56,7 @@ private:
 public:
     typedef T config_type_t;
     //!< \brief Type of input configuration vector
-    typedef sc_dt::sc_lv<M> configpart_type_t;
+    typedef cgra::config_vector_t<M> configpart_type_t;
     //!< \brief Select type for Selector input signals
 
 #ifndef GSYSC
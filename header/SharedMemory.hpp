@@ -0,0 +1,174 @@
+/*
+ * SharedMemory.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SHARED_MEMORY_H_
+#define SHARED_MEMORY_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <memory>
+
+namespace cgra {
+
+/*!
+ * \class SharedMemory
+ *
+ * \brief Byte addressed memory which allocates its pages on the first write
+ *
+ * \details
+ * The memory is divided into pages of cPageSize bytes. A page is allocated
+ * and cleared when it is written for the first time. Pages which were
+ * never written read as zero. Thus, a large address space (up to 4 GiB)
+ * only occupies host memory for the regions which are used by a
+ * simulation, e.g. an image and its results.
+ *
+ * Accesses beyond the memory size are ignored (write) or read as zero.
+ */
+class SharedMemory
+{
+public:
+    typedef uint8_t value_type_t;
+    //!< \brief Type of a memory cell
+
+    static constexpr uint32_t cPageBitwidth{16};
+    //!< \brief Number of address bits within a page
+    static constexpr uint64_t cPageSize{uint64_t{1} << cPageBitwidth};
+    //!< \brief Size of a page in bytes
+
+    /*!
+     * \brief Create a memory without any allocated page
+     *
+     * \param[in] sizeA Size of the memory in bytes
+     */
+    explicit SharedMemory(const uint64_t sizeA) : m_size{sizeA}, m_pages((sizeA + cPageSize - 1) >> cPageBitwidth)
+    {}
+
+    /*!
+     * \brief Size of the memory in bytes
+     */
+    uint64_t size() const { return m_size; }
+
+    /*!
+     * \brief Number of allocated pages
+     */
+    std::size_t allocatedPages() const { return m_allocatedPages; }
+
+    /*!
+     * \brief Read a single byte
+     *
+     * \param[in] addressA Address of the byte
+     */
+    value_type_t operator[](const uint64_t addressA) const
+    {
+        value_type_t t_value{0};
+        read(addressA, &t_value, 1);
+        return t_value;
+    }
+
+    /*!
+     * \brief Copy a memory block to host memory
+     *
+     * \param[in] addressA  Start address of the block
+     * \param[out] dataA    Destination in host memory
+     * \param[in] lengthA   Number of bytes
+     */
+    void read(uint64_t addressA, void* dataA, std::size_t lengthA) const
+    {
+        uint8_t* t_data{static_cast<uint8_t*>(dataA)};
+
+        while (0 < lengthA)
+        {
+            const std::size_t t_length{chunk(addressA, lengthA)};
+            if (0 == t_length)
+            {
+                memset(t_data, 0, lengthA);
+                return;
+            }
+
+            const auto& t_page = m_pages[addressA >> cPageBitwidth];
+            if (t_page)
+                memcpy(t_data, t_page.get() + (addressA & (cPageSize - 1)), t_length);
+            else
+                memset(t_data, 0, t_length);
+
+            addressA += t_length;
+            t_data += t_length;
+            lengthA -= t_length;
+        }
+    }
+
+    /*!
+     * \brief Copy a block from host memory to the memory
+     *
+     * \param[in] addressA  Start address of the block
+     * \param[in] dataA     Source in host memory
+     * \param[in] lengthA   Number of bytes
+     * \return False if the block exceeds the memory
+     */
+    bool write(uint64_t addressA, const void* dataA, std::size_t lengthA)
+    {
+        const uint8_t* t_data{static_cast<const uint8_t*>(dataA)};
+
+        while (0 < lengthA)
+        {
+            const std::size_t t_length{chunk(addressA, lengthA)};
+            if (0 == t_length)
+                return false;
+
+            auto& t_page = m_pages[addressA >> cPageBitwidth];
+            if (!t_page)
+            {
+                t_page.reset(new value_type_t[cPageSize]());
+                ++m_allocatedPages;
+            }
+            memcpy(t_page.get() + (addressA & (cPageSize - 1)), t_data, t_length);
+
+            addressA += t_length;
+            t_data += t_length;
+            lengthA -= t_length;
+        }
+
+        return true;
+    }
+
+private:
+    //Forbidden Constructors
+    SharedMemory() = delete;
+    SharedMemory(const SharedMemory& src) = delete;
+    SharedMemory& operator=(const SharedMemory& src) = delete;
+    SharedMemory(SharedMemory&& src) = delete;
+    SharedMemory& operator=(SharedMemory&& src) = delete;
+
+    /*!
+     * \brief Number of bytes of an access which are located in the page of addressA
+     *
+     * \return Zero if addressA is beyond the memory
+     */
+    std::size_t chunk(const uint64_t addressA, const std::size_t lengthA) const
+    {
+        if (m_size <= addressA)
+            return 0;
+
+        uint64_t t_length{cPageSize - (addressA & (cPageSize - 1))};
+        if (m_size - addressA < t_length)
+            t_length = m_size - addressA;
+
+        return static_cast<std::size_t>(lengthA < t_length ? lengthA : t_length);
+    }
+
+    const uint64_t m_size;
+    //!< \brief Size of the memory in bytes
+    std::vector<std::unique_ptr<value_type_t[]>> m_pages;
+    //!< \brief Pages of the memory, nullptr if a page was never written
+    std::size_t m_allocatedPages{0};
+    //!< \brief Number of allocated pages
+};
+
+} // namespace cgra
+
+#endif // SHARED_MEMORY_H_
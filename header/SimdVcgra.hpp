@@ -0,0 +1,141 @@
+/*
+ * SimdVcgra.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SIMD_VCGRA_H_
+#define SIMD_VCGRA_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include "FunctionalVcgra.hpp"
+
+namespace cgra
+{
+
+/*!
+ * \class SimdVcgra
+ *
+ * \brief Vectorized execution of a decoded VCGRA configuration
+ *
+ * \details
+ * The engine executes the dataflow graph of a FunctionalVcgra for many input
+ * vectors at once, e.g. all pixel windows of an image row or tile. Each PE
+ * result is calculated for 16 (AVX2) or 8 (SSE2) input vectors with one
+ * instruction. Remaining vectors and builds without SIMD support use the
+ * scalar operations of FunctionalVcgra. IDIV, MDL and the shifts by a
+ * variable amount have no 16 bit SIMD instruction and are always calculated
+ * lane by lane. Configurations with MAC operations are processed vector by
+ * vector, because an accumulator depends on all previous input vectors.
+ * The same applies to configurations which read feedback registers.
+ *
+ * With PACKED_DATAPATH, every value holds cPackedLanes sub-words. Lanes of
+ * 8 bit use (unsigned saturating with PACKED_UNSIGNED) byte instructions
+ * where available, all other operations are calculated value by value with
+ * the PackedDatapath.
+ *
+ * Input and output values are stored as structure of arrays: all values of
+ * one VCGRA data input (output) are stored consecutively, i.e. value v of
+ * input i is located at index i * numVectors + v.
+ *
+ * The results are bit-identical to FunctionalVcgra::evaluateBatch(). Like
+ * the functional model, evaluateTile() changes the accumulators and feedback
+ * registers, thus each thread needs its own engine.
+ */
+class SimdVcgra
+{
+public:
+    typedef FunctionalVcgra::value_type_t value_type_t;
+    //!< \brief Type of input and output values
+
+    static constexpr uint32_t cNumOfInputs{FunctionalVcgra::cNumOfInputs};
+    //!< \brief Number of VCGRA data inputs
+    static constexpr uint32_t cNumOfOutputs{FunctionalVcgra::cNumOfOutputs};
+    //!< \brief Number of VCGRA data outputs
+#ifdef PIPELINED_PE
+    static constexpr uint32_t cCyclesPerLevel{4};
+    //!< \brief Clock cycles of one PE level and its VirtualChannel (sample, buffer, sample, execute)
+#else
+    static constexpr uint32_t cCyclesPerLevel{5};
+    //!< \brief Clock cycles of one PE level and its VirtualChannel (sample, await, process, valid, buffer)
+#endif
+    static constexpr uint32_t cCyclesPerInvocation{cNumOfLevels * cCyclesPerLevel + 1};
+    //!< \brief Clock cycles from valid input data to ready of the Synchronizer
+
+    /*!
+     * \brief Create an execution engine for a decoded configuration
+     *
+     * \param[in] modelA Configured functional model
+     */
+    explicit SimdVcgra(const FunctionalVcgra& modelA);
+
+    /*!
+     * \brief Process a tile of input vectors
+     *
+     * \param[in] inputsA       cNumOfInputs x numVectorsA input values (structure of arrays)
+     * \param[out] outputsA     cNumOfOutputs x numVectorsA result values (structure of arrays)
+     * \param[in] numVectorsA   Number of input vectors
+     */
+    void evaluateTile(const value_type_t* inputsA, value_type_t* outputsA, std::size_t numVectorsA);
+
+    /*!
+     * \brief Number of vectors processed with one SIMD instruction
+     */
+    static uint32_t laneWidth();
+
+    /*!
+     * \brief Name of the used instruction set (AVX2, SSE2 or scalar)
+     */
+    static const char* instructionSet();
+
+    /*!
+     * \brief Access the feedback registers
+     */
+    const FunctionalVcgra::feedback_registers_t& feedbackRegisters() const { return m_feedback; }
+
+    /*!
+     * \brief Upper bound of VCGRA throughput for this configuration
+     *
+     * \details
+     * The Processing_Elements of a VCGRA are not pipelined. Thus, a new input
+     * vector can be applied after the previous one passed all PE levels.
+     * With PIPELINED_PE, every PE level accepts a new input vector each clock
+     * cycle and the latency of cCyclesPerInvocation is paid only once.
+     * With PACKED_DATAPATH, an input vector carries cPackedLanes sub-word
+     * vectors, which are counted separately.
+     *
+     * \param[in] clockFrequencyA Clock frequency of the VCGRA in Hz
+     * \return Input vectors per second
+     */
+    static double throughputUpperBound(double clockFrequencyA)
+    {
+#ifdef PIPELINED_PE
+        return clockFrequencyA * cPackedLanes;
+#else
+        return clockFrequencyA * cPackedLanes / cCyclesPerInvocation;
+#endif
+    }
+
+private:
+    std::vector<FunctionalVcgra::Node> m_nodes;
+    //!< \brief PEs which produce valid results in topological order
+    std::vector<int32_t> m_outputs;
+    //!< \brief Index of each VCGRA data output within the value vector or -1 if the output is invalid
+    std::array<value_type_t, cNumOfPe> m_constants;
+    //!< \brief Immediate operands, indexed by PE
+    bool m_sequential{false};
+    //!< \brief Configuration contains MAC operations or reads feedback registers
+    bool m_ready{false};
+    //!< \brief Synchronizer raises ready, results are stored in the feedback registers
+    FunctionalVcgra::feedback_registers_t m_feedback;
+    //!< \brief Feedback registers, initialized with the registers of the functional model
+    std::array<value_type_t, cNumOfPe> m_accumulators{};
+    //!< \brief Accumulators of MAC operations, indexed by PE
+};
+
+} // namespace cgra
+
+#endif // SIMD_VCGRA_H_
@@ -0,0 +1,333 @@
+/*
+ * SobelProgram.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SOBEL_PROGRAM_H_
+#define SOBEL_PROGRAM_H_
+
+#include <cstdint>
+#include <array>
+#include <utility>
+#include <vector>
+#include "Typedef.h"
+
+namespace cgra
+{
+
+// Blocks, partial sums and the result output are arranged for the Sobel configurations
+// of full_architecture, which address the data inputs and outputs of the default topology
+static_assert(calc_isTopology(cPeLevels, cDefaultTopology),
+              "The Sobel program needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
+
+/*!
+ * \brief Assemble a command of the ManagementUnit
+ *
+ * \param[in] commandA Command number (bits 5..0)
+ * \param[in] addressA Shared memory address or argument of the command (bits 31..16)
+ * \param[in] lineA    Cache line (bits 15..13)
+ * \param[in] placeA   Place within the cache line, 127 for a whole line (bits 12..6)
+ * \return Assembler command
+ */
+inline uint32_t assembleCommand(const uint32_t commandA, const uint32_t addressA = 0, const uint32_t lineA = 0,
+                                const uint32_t placeA = 0)
+{
+    return (addressA & 0xFFFF) << 16 | (lineA & 0x7) << 13 | (placeA & 0x7F) << 6 | (commandA & 0x3F);
+}
+
+/*!
+ * \brief Segments in which two configurations differ
+ *
+ * \param[in] fromA Configuration byte stream in a cache line
+ * \param[in] toA   Configuration byte stream of the same length, which replaces fromA
+ * \return Maximal runs of differing bytes (first byte, number of bytes)
+ */
+inline std::vector<std::pair<uint32_t, uint32_t>> configurationSegments(const std::vector<uint8_t>& fromA,
+                                                                       const std::vector<uint8_t>& toA)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> t_segments{};
+
+    for (uint32_t t_byte = 0; toA.size() > t_byte && fromA.size() > t_byte; ++t_byte)
+    {
+        if (fromA[t_byte] == toA[t_byte])
+            continue;
+        if (!t_segments.empty() && t_segments.back().first + t_segments.back().second == t_byte)
+            ++t_segments.back().second;
+        else
+            t_segments.emplace_back(t_byte, 1);
+    }
+
+    return t_segments;
+}
+
+/*!
+ * \struct SobelProgram
+ *
+ * \brief Assembler program of a 3x3 filter in three VCGRA passes
+ *
+ * \details
+ * The program applies the Sobel configurations of full_architecture to data
+ * blocks, which are prepared in shared memory. Every block fills a
+ * DataInCache line, coefficients at the even places and pixels at the odd
+ * places:
+ *   - upper block: coefficients 0..3, pixels (y-1,x-1), (y-1,x), (y-1,x+1), (y,x-1)
+ *   - lower block: coefficients 4..7, pixels (y,x), (y,x+1), (y+1,x-1), (y+1,x)
+ *   - final block: coefficient 8 and pixel (y+1,x+1) at places 0 and 1,
+ *     the remaining places like the lower block
+ *
+ * All upper blocks and then all lower blocks are processed with the first
+ * PE and VirtualChannel configuration. Their DataOutCache lines are stored
+ * as partial sums. The final pass loads output 2 of both partial sums into
+ * places 2 and 3 of the final block and stores output 2 as filter result.
+ *
+ * Without streams, every block and partial sum is transferred by LOADDA and
+ * STOREDA between two VCGRA runs. With streams, the prefetch engine of the
+ * ManagementUnit transfers them while the VCGRA is processing.
+ *
+ * The final configurations are loaded into cache line 1. If segments are
+ * given for a configuration cache, only these segments of the final
+ * configuration are loaded into cache line 0 after the partial sum passes
+ * (SET_SEGMENT, needs PARTIAL_RECONFIGURATION).
+ *
+ * Configurations can be loaded from compressed copies (LOADPCZ, LOADCCZ,
+ * needs COMPRESSED_CONFIG). Segments are loaded from uncompressed
+ * configurations only.
+ *
+ * Configurations are located in the first 64 KiB of shared memory. Blocks,
+ * partial sums, results and scratch value are located in the 64 KiB region
+ * selected by addressHigh (SET_ADDR_HIGH, needs MMU_ADDRESS_WIDTH > 16).
+ */
+struct SobelProgram
+{
+    /*!
+     * \brief Command numbers of the ManagementUnit
+     */
+    enum COMMAND : uint32_t
+    {
+        WAIT_READY = 4,
+        LOADD = 5,
+        LOADDA = 6,
+        STORED = 7,
+        STOREDA = 8,
+        LOADPC = 9,
+        LOADCC = 10,
+        START = 11,
+        FINISH = 12,
+        SLCT_DIC_LINE = 15,
+        SLCT_DOC_LINE = 16,
+        SLCT_PECC_LINE = 17,
+        SLCT_CHCC_LINE = 18,
+        SET_STREAM = 19,
+        STOP_STREAM = 20,
+        SET_LINE_BANK = 23,
+        SET_SEGMENT = 24,
+        LOADPCZ = 25,
+        LOADCCZ = 26,
+        SET_ADDR_HIGH = 27
+    };
+
+    static constexpr uint32_t cBlockSize{2 * cPeLevels.front() * sizeof(int16_t)};
+    //!< \brief Number of bytes of a block (one DataInCache line)
+    static constexpr uint32_t cSumSize{cPeLevels.back() * sizeof(int16_t)};
+    //!< \brief Number of bytes of a partial sum (one DataOutCache line)
+    static constexpr uint32_t cResultOutput{2};
+    //!< \brief Data output of the partial sums and of the filter result
+
+    std::array<uint16_t, 2> peConfigs{};
+    //!< \brief Shared memory addresses of the PE configurations of the partial sum passes and of the final pass
+    std::array<uint16_t, 2> chConfigs{};
+    //!< \brief Shared memory addresses of the VirtualChannel configurations of the partial sum passes and of the final pass
+    std::array<bool, 2> peCompressed{};
+    //!< \brief The PE configuration at the same index of peConfigs is a compressed copy
+    std::array<bool, 2> chCompressed{};
+    //!< \brief The VirtualChannel configuration at the same index of chConfigs is a compressed copy
+    uint16_t upperBlocks{0};
+    //!< \brief Shared memory address of the first upper block
+    uint16_t lowerBlocks{0};
+    //!< \brief Shared memory address of the first lower block
+    uint16_t finalBlocks{0};
+    //!< \brief Shared memory address of the first final block
+    uint16_t upperSums{0};
+    //!< \brief Shared memory address of the first partial sum of the upper blocks
+    uint16_t lowerSums{0};
+    //!< \brief Shared memory address of the first partial sum of the lower blocks
+    uint16_t results{0};
+    //!< \brief Shared memory address of the first filter result (int16)
+    uint16_t scratch{0};
+    //!< \brief Shared memory address of one int16 value, which the program may overwrite
+    uint32_t numOfPixels{0};
+    //!< \brief Number of filtered pixels (blocks per pass)
+    bool streamed{false};
+    //!< \brief The prefetch engine transfers blocks and partial sums of the partial sum passes
+    std::vector<std::pair<uint32_t, uint32_t>> peSegments{};
+    //!< \brief Segments of the final PE configuration which differ from the first one (see configurationSegments())
+    std::vector<std::pair<uint32_t, uint32_t>> chSegments{};
+    //!< \brief Segments of the final VirtualChannel configuration which differ from the first one
+    uint16_t addressHigh{0};
+    //!< \brief Upper address bits of blocks, partial sums, results and scratch value
+
+    /*!
+     * \brief Assemble the program
+     *
+     * \return Assembler commands
+     */
+    std::vector<uint32_t> assemble() const
+    {
+        std::vector<uint32_t> t_program{};
+
+        //Selected lines of a former program are unknown. A configuration cache
+        //line can only be loaded if the VCGRA uses the other one.
+        t_program.push_back(assembleCommand(SET_LINE_BANK));
+        t_program.push_back(assembleCommand(SLCT_PECC_LINE, 0, 1));
+        t_program.push_back(assembleCommand(SLCT_CHCC_LINE, 0, 1));
+        t_program.push_back(assembleCommand(peCompressed[0] ? LOADPCZ : LOADPC, peConfigs[0], 0, 127));
+        t_program.push_back(assembleCommand(chCompressed[0] ? LOADCCZ : LOADCC, chConfigs[0], 0, 127));
+        t_program.push_back(assembleCommand(SLCT_PECC_LINE, 0, 0));
+        t_program.push_back(assembleCommand(SLCT_CHCC_LINE, 0, 0));
+        if (peSegments.empty())
+            t_program.push_back(assembleCommand(peCompressed[1] ? LOADPCZ : LOADPC, peConfigs[1], 1, 127));
+        if (chSegments.empty())
+            t_program.push_back(assembleCommand(chCompressed[1] ? LOADCCZ : LOADCC, chConfigs[1], 1, 127));
+
+        if (0 != addressHigh)
+            t_program.push_back(assembleCommand(SET_ADDR_HIGH, addressHigh));
+
+        if (streamed)
+        {
+            streamPartialSums(t_program, upperBlocks, upperSums);
+            streamPartialSums(t_program, lowerBlocks, lowerSums);
+        }
+        else
+        {
+            loadPartialSums(t_program, upperBlocks, upperSums);
+            loadPartialSums(t_program, lowerBlocks, lowerSums);
+        }
+
+        const bool t_segmented{!peSegments.empty() || !chSegments.empty()};
+        t_program.push_back(assembleCommand(SLCT_PECC_LINE, 0, 1));
+        t_program.push_back(assembleCommand(SLCT_CHCC_LINE, 0, 1));
+        if (0 != addressHigh && t_segmented)
+            t_program.push_back(assembleCommand(SET_ADDR_HIGH, 0));
+        if (!peSegments.empty())
+        {
+            loadSegments(t_program, LOADPC, peConfigs[1], peSegments);
+            t_program.push_back(assembleCommand(SLCT_PECC_LINE, 0, 0));
+        }
+        if (!chSegments.empty())
+        {
+            loadSegments(t_program, LOADCC, chConfigs[1], chSegments);
+            t_program.push_back(assembleCommand(SLCT_CHCC_LINE, 0, 0));
+        }
+        if (0 != addressHigh && t_segmented)
+            t_program.push_back(assembleCommand(SET_ADDR_HIGH, addressHigh));
+        finalPass(t_program);
+
+        //Following programs expect the default segment length and the first 64 KiB region
+        if (t_segmented)
+            t_program.push_back(assembleCommand(SET_SEGMENT, 1));
+        if (0 != addressHigh)
+            t_program.push_back(assembleCommand(SET_ADDR_HIGH, 0));
+        t_program.push_back(assembleCommand(FINISH));
+
+        return t_program;
+    }
+
+private:
+    /*!
+     * \brief Load segments of a configuration into cache line 0
+     *
+     * \param[out] programA  Program the commands are appended to
+     * \param[in] commandA   LOADPC or LOADCC
+     * \param[in] configA    Shared memory address of the configuration
+     * \param[in] segmentsA  Segments of the configuration (first byte, number of bytes)
+     */
+    static void loadSegments(std::vector<uint32_t>& programA, const COMMAND commandA, const uint32_t configA,
+                             const std::vector<std::pair<uint32_t, uint32_t>>& segmentsA)
+    {
+        for (const auto& segment : segmentsA)
+        {
+            programA.push_back(assembleCommand(SET_SEGMENT, segment.second));
+            programA.push_back(assembleCommand(commandA, configA + segment.first, 0, segment.first));
+        }
+    }
+
+    /*!
+     * \brief Process blocks one after another with LOADDA and STOREDA
+     *
+     * \param[out] programA Program the commands are appended to
+     * \param[in] blocksA   Shared memory address of the first block
+     * \param[in] sumsA     Shared memory address of the first partial sum
+     */
+    void loadPartialSums(std::vector<uint32_t>& programA, const uint32_t blocksA, const uint32_t sumsA) const
+    {
+        //A DataInCache line can only be loaded if the VCGRA uses the other one
+        programA.push_back(assembleCommand(SLCT_DIC_LINE, 0, 1));
+        programA.push_back(assembleCommand(SLCT_DOC_LINE, 0, 0));
+        for (uint32_t t_pixel = 0; numOfPixels > t_pixel; ++t_pixel)
+        {
+            const uint32_t t_line{t_pixel % 2};
+            programA.push_back(assembleCommand(LOADDA, blocksA + t_pixel * cBlockSize, t_line, 127));
+            programA.push_back(assembleCommand(SLCT_DIC_LINE, 0, t_line));
+            programA.push_back(assembleCommand(START));
+            programA.push_back(assembleCommand(WAIT_READY));
+            programA.push_back(assembleCommand(STOREDA, sumsA + t_pixel * cSumSize, 0, 127));
+        }
+    }
+
+    /*!
+     * \brief Process blocks with the prefetch engine
+     *
+     * \param[out] programA Program the commands are appended to
+     * \param[in] blocksA   Shared memory address of the first block
+     * \param[in] sumsA     Shared memory address of the first partial sum
+     */
+    void streamPartialSums(std::vector<uint32_t>& programA, const uint32_t blocksA, const uint32_t sumsA) const
+    {
+        //The prefetch engine swaps the lines of the VCGRA and the MMU, thus they
+        //need to differ. LOADD and STORED select the lines of the MMU.
+        programA.push_back(assembleCommand(SLCT_DIC_LINE, 0, 1));
+        programA.push_back(assembleCommand(LOADD, blocksA, 0, 0));
+        programA.push_back(assembleCommand(SLCT_DOC_LINE, 0, 0));
+        programA.push_back(assembleCommand(STORED, scratch, 1, 0));
+
+        programA.push_back(assembleCommand(SET_STREAM, cBlockSize, 1));
+        programA.push_back(assembleCommand(SET_STREAM, cSumSize, 3));
+        programA.push_back(assembleCommand(SET_STREAM, sumsA, 2));
+        programA.push_back(assembleCommand(SET_STREAM, blocksA, 0));
+        for (uint32_t t_pixel = 0; numOfPixels > t_pixel; ++t_pixel)
+        {
+            programA.push_back(assembleCommand(START));
+            programA.push_back(assembleCommand(WAIT_READY));
+        }
+        programA.push_back(assembleCommand(STOP_STREAM));
+    }
+
+    /*!
+     * \brief Add the partial sums of each pixel within the final pass
+     *
+     * \param[out] programA Program the commands are appended to
+     */
+    void finalPass(std::vector<uint32_t>& programA) const
+    {
+        constexpr uint32_t t_sumOffset{cResultOutput * sizeof(int16_t)};
+
+        programA.push_back(assembleCommand(SLCT_DIC_LINE, 0, 1));
+        programA.push_back(assembleCommand(SLCT_DOC_LINE, 0, 0));
+        for (uint32_t t_pixel = 0; numOfPixels > t_pixel; ++t_pixel)
+        {
+            const uint32_t t_line{t_pixel % 2};
+            programA.push_back(assembleCommand(LOADDA, finalBlocks + t_pixel * cBlockSize, t_line, 127));
+            programA.push_back(assembleCommand(LOADD, upperSums + t_pixel * cSumSize + t_sumOffset, t_line, 2));
+            programA.push_back(assembleCommand(LOADD, lowerSums + t_pixel * cSumSize + t_sumOffset, t_line, 3));
+            programA.push_back(assembleCommand(SLCT_DIC_LINE, 0, t_line));
+            programA.push_back(assembleCommand(START));
+            programA.push_back(assembleCommand(WAIT_READY));
+            programA.push_back(assembleCommand(STORED, results + t_pixel * sizeof(int16_t), 0, cResultOutput));
+        }
+    }
+};
+
+} // namespace cgra
+
+#endif // SOBEL_PROGRAM_H_
@@ -0,0 +1,240 @@
+/*
+ * StreamingVCGRA.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef STREAMING_VCGRA_H_
+#define STREAMING_VCGRA_H_
+
+#include <systemc>
+#include <cstdint>
+#include <array>
+#include <deque>
+#include "VCGRA.h"
+#include "MonolithicVCGRA.h"
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+namespace cgra {
+
+/*!
+ * \class StreamingVCGRA
+ *
+ * \brief VCGRA with valid/ready stream interfaces instead of start/ready pulses
+ *
+ * \details
+ * Every data input is a lane with its own valid/ready handshake. A value is
+ * transferred at a positive clock edge if valid and ready of its lane are
+ * high. Each lane holds one value. As soon as all lanes hold a value, the
+ * input vector is applied to the VCGRA with a start pulse of one clock cycle.
+ * Thus, several input vectors are processed by the VCGRA at the same time.
+ *
+ * The VCGRA itself cannot stall. Therefore, the number of input vectors within
+ * the VCGRA and the output buffer is limited to cOutputBufferDepth (credits).
+ * An input vector is only applied if a place in the output buffer is reserved
+ * for its result. Results leave the output buffer in order by a valid/ready
+ * handshake of all data outputs.
+ *
+ * A new input vector is applied every cInitiationInterval clock cycles at most,
+ * i.e. every cycle with PIPELINED_PE and every third cycle otherwise.
+ */
+class StreamingVCGRA : public sc_core::sc_module
+{
+public:
+    typedef VCGRA::data_input_type_t data_input_type_t;
+    //!< \brief Stream data input type
+    typedef VCGRA::data_output_type_t data_output_type_t;
+    //!< \brief Stream data output type
+    typedef bool handshake_type_t;
+    //!< \brief Type of valid and ready signals of the streams
+
+    static constexpr uint32_t cNumOfInputs{cgra::cInputChannel_NumOfInputs};
+    //!< \brief Number of input lanes
+    static constexpr uint32_t cNumOfOutputs{cgra::cPeLevels.back()};
+    //!< \brief Number of data outputs
+    static constexpr uint32_t cOutputBufferDepth{32};
+    //!< \brief Maximum number of input vectors in the VCGRA and the output buffer
+#ifdef PIPELINED_PE
+    static constexpr uint32_t cInitiationInterval{1};
+#else
+    static constexpr uint32_t cInitiationInterval{3};
+#endif
+    //!< \brief Minimum number of clock cycles between two input vectors (AWAIT, PROCESS, VALID of a Processing_Element)
+
+    typedef std::array<data_output_type_t, cNumOfOutputs> result_type_t;
+    //!< \brief Results of one input vector
+
+#ifndef GSYSC
+    //Entity ports
+    sc_core::sc_in<cgra::clock_type_t> clk{"clk"};
+    //!< \brief Clock port
+    sc_core::sc_in<cgra::reset_type_t> rst{"rst"};
+    //!< \brief Reset port (active low)
+    sc_core::sc_in<cgra::pe_config_type_t> pe_config{"pe_config"};
+    //!< \brief VCGRA PE configuration port
+    sc_core::sc_in<cgra::ch_config_type_t> ch_config{"ch_config"};
+    //!< \brief VCGRA VirtualChannel configuration port
+    std::array<sc_core::sc_in<data_input_type_t>, cNumOfInputs> data_inputs;
+    //!< \brief Data of input lanes
+    std::array<sc_core::sc_in<handshake_type_t>, cNumOfInputs> in_valids;
+    //!< \brief Data of an input lane is valid
+    std::array<sc_core::sc_out<handshake_type_t>, cNumOfInputs> in_readys;
+    //!< \brief Input lane accepts data
+    std::array<sc_core::sc_out<data_output_type_t>, cNumOfOutputs> data_outputs;
+    //!< \brief Results of the oldest input vector
+    sc_core::sc_out<handshake_type_t> out_valid{"out_valid"};
+    //!< \brief Data outputs are valid
+    sc_core::sc_in<handshake_type_t> out_ready{"out_ready"};
+    //!< \brief Receiver accepts data outputs
+#else
+    //Entity ports
+    sc_in<cgra::clock_type_t> clk{"clk"};
+    //!< \brief Clock port
+    sc_in<cgra::reset_type_t> rst{"rst"};
+    //!< \brief Reset port (active low)
+    sc_in<cgra::pe_config_type_t> pe_config{"pe_config"};
+    //!< \brief VCGRA PE configuration port
+    sc_in<cgra::ch_config_type_t> ch_config{"ch_config"};
+    //!< \brief VCGRA VirtualChannel configuration port
+    std::array<sc_in<data_input_type_t>, cNumOfInputs> data_inputs;
+    //!< \brief Data of input lanes
+    std::array<sc_in<handshake_type_t>, cNumOfInputs> in_valids;
+    //!< \brief Data of an input lane is valid
+    std::array<sc_out<handshake_type_t>, cNumOfInputs> in_readys;
+    //!< \brief Input lane accepts data
+    std::array<sc_out<data_output_type_t>, cNumOfOutputs> data_outputs;
+    //!< \brief Results of the oldest input vector
+    sc_out<handshake_type_t> out_valid{"out_valid"};
+    //!< \brief Data outputs are valid
+    sc_in<handshake_type_t> out_ready{"out_ready"};
+    //!< \brief Receiver accepts data outputs
+#endif
+
+    //Member functions
+    //------------------
+    SC_HAS_PROCESS(StreamingVCGRA);
+    /*!
+     * \brief General constructor
+     *
+     * \param[in] nameA Name of the StreamingVCGRA as a SystemC module
+     */
+    StreamingVCGRA(const sc_core::sc_module_name& nameA);
+
+    /*!
+     * \brief Initialize output signals
+     */
+    virtual void end_of_elaboration() override;
+
+    /*!
+     * \brief Print sc_module type
+     *
+     * \return Module kind.
+     */
+    const char * kind() const override
+    { return "Streaming VCGRA"; }
+
+    /*!
+     * \brief Print StreamingVCGRA instance name
+     *
+     * \param[out] os Outstream for string of sc_module instance name
+     */
+    virtual void print(::std::ostream& os = std::cout) const override
+    { os << name(); }
+
+    /*!
+     * \brief Dump sc_module internal information
+     *
+     * \param[out] os Outstream for information dumping
+     */
+    virtual void dump(::std::ostream& os = std::cout) const override;
+
+#ifdef MCPAT
+    /**
+     * \brief Dump runtime statistics for McPAT simulation
+     *
+     * \param os Define used outstream [default: std::cout]
+     */
+    void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
+    { m_vcgra.dumpMcpatStatistics(os); }
+#endif
+
+    /*!
+     * \brief Update input lanes, credits and output buffer
+     *
+     * \details
+     * On every positive clock edge:
+     *  1. The oldest result is removed if out_valid and out_ready were high.
+     *  2. The result of the VCGRA is stored in the output buffer if the
+     *     Synchronizer signaled ready. The data outputs are registered one
+     *     cycle earlier, because a pipelined PE may already present the next
+     *     result.
+     *  3. A complete input vector is applied to the VCGRA if a credit is left.
+     *  4. Input lanes with valid and ready high store their data.
+     */
+    void stream();
+
+    /*!
+     * \brief Destructor
+     */
+    virtual ~StreamingVCGRA() = default;
+
+private:
+    //Forbidden Constructors
+    StreamingVCGRA() = delete;
+    StreamingVCGRA(const StreamingVCGRA& src) = delete;             //!< \brief because sc_module could not be copied
+    StreamingVCGRA& operator=(const StreamingVCGRA& src) = delete;  //!< \brief because move not implemented for sc_module
+    StreamingVCGRA(StreamingVCGRA&& src) = delete;                  //!< \brief because sc_module could not be copied
+    StreamingVCGRA& operator=(StreamingVCGRA&& src) = delete;       //!< \brief because move not implemented for sc_module
+
+    /*!
+     * \brief Clear input lanes, credits and output buffer
+     */
+    void reset();
+
+    vcgra_type_t m_vcgra{"VCGRA"};
+    //!< \brief Wrapped VCGRA instance
+
+#ifndef GSYSC
+    sc_core::sc_signal<cgra::start_type_t> s_start{"s_start"};
+    //!< \brief Start pulse of an input vector
+    sc_core::sc_signal<cgra::ready_type_t> s_ready{"s_ready"};
+    //!< \brief Ready of the VCGRA Synchronizer
+    std::array<sc_core::sc_signal<data_input_type_t>, cNumOfInputs> s_data_inputs;
+    //!< \brief Data inputs of the VCGRA
+    std::array<sc_core::sc_signal<data_output_type_t>, cNumOfOutputs> s_data_outputs;
+    //!< \brief Data outputs of the VCGRA
+#else
+    sc_signal<cgra::start_type_t> s_start{"s_start"};
+    //!< \brief Start pulse of an input vector
+    sc_signal<cgra::ready_type_t> s_ready{"s_ready"};
+    //!< \brief Ready of the VCGRA Synchronizer
+    std::array<sc_signal<data_input_type_t>, cNumOfInputs> s_data_inputs;
+    //!< \brief Data inputs of the VCGRA
+    std::array<sc_signal<data_output_type_t>, cNumOfOutputs> s_data_outputs;
+    //!< \brief Data outputs of the VCGRA
+#endif
+
+    std::array<data_input_type_t, cNumOfInputs> m_lanes;
+    //!< \brief Data of the input lanes
+    std::array<bool, cNumOfInputs> m_laneFull;
+    //!< \brief Input lane holds data
+    std::array<bool, cNumOfInputs> m_laneReady;
+    //!< \brief Ready of the input lanes since the previous clock edge
+    result_type_t m_sampledOutputs;
+    //!< \brief Data outputs of the VCGRA at the previous clock edge
+    std::deque<result_type_t> m_outputBuffer;
+    //!< \brief Results in order of their input vectors
+    uint32_t m_inFlight{0};
+    //!< \brief Number of input vectors within the VCGRA
+    uint32_t m_cyclesSinceStart{cInitiationInterval};
+    //!< \brief Clock cycles since the last input vector was applied
+    bool m_outValid{false};
+    //!< \brief Oldest result is presented at the data outputs
+};
+
+} // namespace cgra
+
+#endif // STREAMING_VCGRA_H_
@@ -7,6 +7,10 @@
 #include <array>
 #include "Typedef.h"
 
+#ifdef ACTIVITY_GATING
+#include "ClockEdgeTracker.hpp"
+#endif
+
 namespace cgra {
 
 /*!
@@ -31,7 +35,7 @@ public:
     //!< \brief Type of output ready signal
     typedef cgra::clock_type_t clock_type_t;
     //!< \brief Type of clock signal
-    typedef sc_dt::sc_lv<N> config_type_t;
+    typedef cgra::config_vector_t<N> config_type_t;
     //!< \brief Type of configuration input signal
 
 #ifndef GSYSC
@@ -77,6 +81,13 @@ public:
     virtual void end_of_elaboration() override
     {
         ready.write(0);
+
+#ifdef ACTIVITY_GATING
+        m_inputActivity |= conf.value_changed_event();
+        for (auto& valid : valid_inputs)
+            m_inputActivity |= valid.value_changed_event();
+        m_edgeTracker.init(clk);
+#endif
     }
 
     /*!
@@ -99,10 +110,16 @@ public:
      */
     void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
     {
+#ifdef ACTIVITY_GATING
+        //A synchronizer is busy for all clock cycles it did not observe
+        const uint32_t t_pending = m_suspended ? m_edgeTracker.pending() : 0U;
+#else
+        const uint32_t t_pending = 0U;
+#endif
         os << name() << "\t\t" << kind() << "\n";
-        os << "total cycles: " << m_totalCycles << "\n";
+        os << "total cycles: " << m_totalCycles + t_pending << "\n";
         os << "idle cycles: " << m_idleCycles << "\n";
-        os << "busy cycles: " << m_busyCycles << "\n";
+        os << "busy cycles: " << m_busyCycles + t_pending << "\n";
         os << std::endl;
     }
 #endif
@@ -119,9 +136,35 @@ public:
      *
      * Afterwards, all bits of the vector are sequentially ANDed
      * and the result is the status of the ready signal.
+     *
+     * With PIPELINED_PE, a PE raises valid for one clock cycle per result
+     * and accepts new operands in every cycle. Thus, ready is a per-vector
+     * valid: every clock cycle with ready high marks one result vector,
+     * also if vectors are streamed back to back. A configuration which
+     * masks all valid signals does not produce result vectors.
+     *
+     * With ACTIVITY_GATING, the process suspends itself until a valid
+     * input or the configuration changes.
      */
     void sync()
     {
+#ifdef ACTIVITY_GATING
+        if (m_suspended)
+        {
+            //Woken up by an input change, evaluate it on the next clock edge
+            m_suspended = false;
+            if (!clk.posedge())
+                return;
+        }
+#ifdef MCPAT
+        if (clk.posedge())
+        {
+            const uint32_t t_missedCycles{m_edgeTracker.observe()};
+            m_totalCycles += t_missedCycles;
+            m_busyCycles += t_missedCycles;
+        }
+#endif
+#endif
 #ifdef MCPAT
         /* A synchronizer always updates its input and output buffer states.
          * Thus the component is always busy and has no idle state.
@@ -138,7 +181,19 @@ public:
         m_status_word |= conf.read();
 
         //And all bits in current status word. If positive, ready signal raises high.
+#ifdef PIPELINED_PE
+        ready.write(m_status_word.and_reduce() && !conf.read().and_reduce());
+#else
         ready.write(m_status_word.and_reduce());
+#endif
+
+#ifdef ACTIVITY_GATING
+        if (clk.posedge())
+        {
+            next_trigger(m_inputActivity);
+            m_suspended = true;
+        }
+#endif
     }
 
 private:
@@ -152,6 +207,14 @@ private:
     //Internal properties
     config_type_t m_status_word{0};
     //!< \brief Helper variable which temporary saves current status of valid signals
+#ifdef ACTIVITY_GATING
+    sc_core::sc_event_or_list m_inputActivity;
+    //!< \brief Value changes which wake up a suspended synchronizer
+    cgra::ClockEdgeTracker m_edgeTracker;
+    //!< \brief Reconstructs clock cycles while suspended
+    bool m_suspended{false};
+    //!< \brief Synchronizer waits for an input change
+#endif
 #ifdef MCPAT
     //McPAT dynamic statistic counters:
     uint32_t m_totalCycles;   //!< \brief Count total number of executed cycles
@@ -20,6 +20,7 @@
 #define TESTBENCH_TOPLEVEL_H
 
 #include <systemc>
+#include <vector>
 #include "Typedef.h"
 #include "TopLevel.h"
 
@@ -67,8 +68,12 @@ public:
     SC_HAS_PROCESS(Testbench_TopLevel);
     /*! 
      * \brief Standard constructor for Testbench_TopLevel
+     *
+     * \param[in] nameA Module name
+     * \param[in] mmuA  MMU of the architecture to access its shared memory
+     * \param[in] muA   ManagementUnit of the architecture to load the programs of the Sobel program variants
      */
-    Testbench_TopLevel(const sc_core::sc_module_name& nameA, cgra::MMU& mmuA);
+    Testbench_TopLevel(const sc_core::sc_module_name& nameA, cgra::MMU& mmuA, cgra::ManagementUnit& muA);
     
     /*!
      * \brief Destructor
@@ -105,7 +110,27 @@ public:
     
 private: 
     
+    /*!
+     * \brief Run variants of a generated Sobel program and compare their results
+     *
+     * \details
+     * A section of the image in shared memory is prepared as data blocks of a
+     * SobelProgram. The program without streams is checked against a Sobel
+     * filter on the host; the other variants need to match its results. The
+     * clock cycles of all variants are reported.
+     */
+    void sobelProgramVariants();
+
+    /*!
+     * \brief Run an assembler program until the ManagementUnit finishes
+     *
+     * \param[in] programA Assembler commands
+     * \return Number of clock cycles until finish
+     */
+    uint64_t runProgram(const std::vector<uint32_t>& programA);
+
     cgra::MMU& m_mmu;
+    cgra::ManagementUnit& m_mu;
     
     //Forbidden Constructors
     Testbench_TopLevel() = delete;                                          //!< \brief Every component needs a unique module name.
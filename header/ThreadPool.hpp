@@ -0,0 +1,158 @@
+/*
+ * ThreadPool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace cgra {
+
+/*!
+ * \class ThreadPool
+ *
+ * \brief Fixed set of worker threads which execute one partition of a task each
+ *
+ * \details
+ * The pool is made for short tasks which are issued at a high rate, e.g. one
+ * simulation phase per clock cycle. run() hands the task to all workers,
+ * executes partition 0 on the calling thread and returns after all partitions
+ * finished, i.e. every call is a barrier. Idle workers poll for a new task
+ * for a short time before they block on a condition variable.
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void(uint32_t)> task_type_t;
+    //!< \brief Task which is called with the index of a partition
+
+    /*!
+     * \brief Start the worker threads
+     *
+     * \param[in] numOfThreadsA Number of partitions of a task including the calling thread
+     */
+    explicit ThreadPool(const uint32_t numOfThreadsA) : m_size{numOfThreadsA ? numOfThreadsA : 1U}
+    {
+        for (uint32_t i = 1; m_size > i; ++i)
+            m_workers.emplace_back(&ThreadPool::work, this, i);
+    }
+
+    /*!
+     * \brief Stop and join the worker threads
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> t_lock{m_mutex};
+            m_stop.store(true, std::memory_order_release);
+        }
+        m_wakeup.notify_all();
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+
+    /*!
+     * \brief Number of partitions of a task
+     */
+    uint32_t size() const { return m_size; }
+
+    /*!
+     * \brief Execute all partitions of a task
+     *
+     * \details
+     * Results of all partitions are visible to the caller after return.
+     *
+     * \param[in] taskA Task which is called once per partition index [0, size())
+     */
+    void run(const task_type_t& taskA)
+    {
+        m_task = &taskA;
+        m_pending.store(m_size - 1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> t_lock{m_mutex};
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+        m_wakeup.notify_all();
+
+        taskA(0);
+
+        while (m_pending.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+private:
+    //Forbidden Constructors
+    ThreadPool(const ThreadPool& src) = delete;
+    ThreadPool& operator=(const ThreadPool& src) = delete;
+    ThreadPool(ThreadPool&& src) = delete;
+    ThreadPool& operator=(ThreadPool&& src) = delete;
+
+    static constexpr uint32_t cSpinCount{4096};
+    //!< \brief Number of polls for a new task before a worker blocks
+
+    /*!
+     * \brief Main loop of a worker thread
+     *
+     * \param[in] partitionA Index of the partition executed by the worker
+     */
+    void work(const uint32_t partitionA)
+    {
+        uint64_t t_seen{0};
+
+        for (;;)
+        {
+            uint64_t t_generation{m_generation.load(std::memory_order_acquire)};
+            for (uint32_t t_spin = 0; t_generation == t_seen && !m_stop.load(std::memory_order_acquire); ++t_spin)
+            {
+                if (cSpinCount > t_spin) {
+                    std::this_thread::yield();
+                }
+                else {
+                    std::unique_lock<std::mutex> t_lock{m_mutex};
+                    m_wakeup.wait(t_lock, [this, t_seen]() {
+                        return m_generation.load(std::memory_order_acquire) != t_seen ||
+                               m_stop.load(std::memory_order_acquire);
+                    });
+                }
+                t_generation = m_generation.load(std::memory_order_acquire);
+            }
+
+            if (t_generation == t_seen)
+                return;
+
+            t_seen = t_generation;
+            (*m_task)(partitionA);
+            m_pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    const uint32_t m_size;
+    //!< \brief Number of partitions of a task
+    std::vector<std::thread> m_workers;
+    //!< \brief Worker threads for the partitions 1 ... size() - 1
+    std::mutex m_mutex;
+    //!< \brief Protects the wakeup of blocked workers
+    std::condition_variable m_wakeup;
+    //!< \brief Signals a new task or the end of the pool
+    const task_type_t* m_task{nullptr};
+    //!< \brief Current task
+    std::atomic<uint64_t> m_generation{0};
+    //!< \brief Incremented for every task
+    std::atomic<uint32_t> m_pending{0};
+    //!< \brief Number of worker partitions of the current task which did not finish
+    std::atomic<bool> m_stop{false};
+    //!< \brief Worker threads terminate
+};
+
+} // namespace cgra
+
+#endif // THREAD_POOL_H_
@@ -12,7 +12,11 @@
 #include <iostream>
 #include "Typedef.h"
 #include "VCGRA.h"
+#include "MonolithicVCGRA.h"
 #include "ConfigurationCache.h"
+#ifdef COMPRESSED_CONFIG
+#include "ConfigurationDecompressor.h"
+#endif
 #include "DataInCache.h"
 #include "DataOutCache.h"
 #include "MMU.h"
@@ -122,7 +126,7 @@ public:
      * These signals and Components are public to ease their tracing.
     */ 
     //Components
-    cgra::VCGRA vcgra{"vcgra"};
+    cgra::vcgra_type_t vcgra{"vcgra"};
     //!< \brief VCGRA instance within the architecture
     cgra::data_input_cache_type_t data_in_cache{"dic"};
     //!< \brief VCGRA data value input cache.
@@ -132,6 +136,12 @@ public:
     //!< \brief ConfigurationCache instance for ProcessingElement configuration.
     cgra::ch_config_cache_type_t ch_confCache{"ch_cc", cgra::cVChConfigBitWidth};
     //!< \brief ConfigurationCache instance for VirtualChannel and Synchronizer configuration.
+#ifdef COMPRESSED_CONFIG
+    cgra::pe_config_decompressor_type_t pe_decompressor{"pe_dec", cgra::cPeConfigBitWidth};
+    //!< \brief Decompresses configuration streams in front of PE ConfigurationCache.
+    cgra::ch_config_decompressor_type_t ch_decompressor{"ch_dec", cgra::cVChConfigBitWidth};
+    //!< \brief Decompresses configuration streams in front of VCH ConfigurationCache.
+#endif
     cgra::MMU mmu{"mmu", cgra::cCacheFeatures};
     //!< \brief MMU instance within the architecture.
     cgra::ManagementUnit mu;
@@ -177,6 +187,10 @@ public:
     //!< \brief Selection signals for DataOutCache (first=slt_in, second=slt_out).
     sc_core::sc_signal<data_cache_place_type_t> s_cache_place{"data_cache_place"};
     //!< \brief Select a place for a value or result in one of the data caches.
+#ifdef MMU_BURST_WIDTH
+    sc_core::sc_signal<bool> s_burst{"burst"};
+    //!< \brief Data caches use all values of a data stream (MMU block transmission).
+#endif
     sc_core::sc_signal<mmu_start_type_t> s_mmu_start{"mmu_start"};
     //!< \brief Start signal from ManagementUnit for MMU.
     sc_core::sc_signal<mmu_ready_type_t> s_mmu_ready{"mmu_ready"};
@@ -185,6 +199,24 @@ public:
     //!< \brief Shared memory address for MMU to access data.
     sc_core::sc_signal<place_type_t> s_place{"place"};
     //!< \brief Value place in target cache of current selected line.
+#ifdef PARTIAL_RECONFIGURATION
+    sc_core::sc_signal<place_type_t> s_segment{"segment"};
+    //!< \brief Number of bytes of a partial configuration load.
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_core::sc_signal<bool> s_compressed{"compressed"};
+    //!< \brief MMU loads a compressed configuration.
+    std::pair<sc_core::sc_signal<config_cache_stream_type_t>, sc_core::sc_signal<config_cache_stream_type_t>> s_decompressed_streams;
+    //!< \brief Configuration streams from decompressors to configuration caches (first=PE, second=VCH).
+    std::pair<sc_core::sc_signal<write_enable_type_t>, sc_core::sc_signal<write_enable_type_t>> s_decompressed_write_enables;
+    //!< \brief Write enables from decompressors to configuration caches (first=PE, second=VCH).
+    std::pair<sc_core::sc_signal<ack_type_t>, sc_core::sc_signal<ack_type_t>> s_decompressed_acknowledges;
+    //!< \brief Acknowledges from configuration caches to decompressors (first=PE, second=VCH).
+#ifdef PARTIAL_RECONFIGURATION
+    std::pair<sc_core::sc_signal<data_cache_place_type_t>, sc_core::sc_signal<data_cache_place_type_t>> s_decompressed_places;
+    //!< \brief Places from decompressors to configuration caches (first=PE, second=VCH).
+#endif
+#endif
 #else
     //Signals
     sc_signal<start_type_t> s_vcgra_start{"vcgra_start"};
@@ -221,6 +253,10 @@ public:
     //!< \brief Selection signals for DataOutCache (first=slt_in, second=slt_out).
     sc_signal<data_cache_place_type_t> s_cache_place{"data_cache_place"};
     //!< \brief Select a place for a value or result in one of the data caches.
+#ifdef MMU_BURST_WIDTH
+    sc_signal<bool> s_burst{"burst"};
+    //!< \brief Data caches use all values of a data stream (MMU block transmission).
+#endif
     sc_signal<mmu_start_type_t> s_mmu_start{"mmu_start"};
     //!< \brief Start signal from ManagementUnit for MMU.
     sc_signal<mmu_ready_type_t> s_mmu_ready{"mmu_ready"};
@@ -229,6 +265,24 @@ public:
     //!< \brief Shared memory address for MMU to access data.
     sc_signal<place_type_t> s_place{"place"};
     //!< \brief Value place in target cache of current selected line.
+#ifdef PARTIAL_RECONFIGURATION
+    sc_signal<place_type_t> s_segment{"segment"};
+    //!< \brief Number of bytes of a partial configuration load.
+#endif
+#ifdef COMPRESSED_CONFIG
+    sc_signal<bool> s_compressed{"compressed"};
+    //!< \brief MMU loads a compressed configuration.
+    std::pair<sc_signal<config_cache_stream_type_t>, sc_signal<config_cache_stream_type_t>> s_decompressed_streams;
+    //!< \brief Configuration streams from decompressors to configuration caches (first=PE, second=VCH).
+    std::pair<sc_signal<write_enable_type_t>, sc_signal<write_enable_type_t>> s_decompressed_write_enables;
+    //!< \brief Write enables from decompressors to configuration caches (first=PE, second=VCH).
+    std::pair<sc_signal<ack_type_t>, sc_signal<ack_type_t>> s_decompressed_acknowledges;
+    //!< \brief Acknowledges from configuration caches to decompressors (first=PE, second=VCH).
+#ifdef PARTIAL_RECONFIGURATION
+    std::pair<sc_signal<data_cache_place_type_t>, sc_signal<data_cache_place_type_t>> s_decompressed_places;
+    //!< \brief Places from decompressors to configuration caches (first=PE, second=VCH).
+#endif
+#endif
 #endif
     
     /*!
@@ -15,6 +15,7 @@
 #include "ConfigurationCache.h"
 #include "Typedef.h"
 #include "VCGRA.h"
+#include "MonolithicVCGRA.h"
 #include <systemc>
 
 #ifdef GSYSC
@@ -223,7 +224,7 @@ private:
 public:
     // Components:
     // -----------
-    cgra::VCGRA vcgra{"vcgra"};
+    cgra::vcgra_type_t vcgra{"vcgra"};
     //!< VCGRA instance
     cgra::pe_config_cache_type_t pe_config_prefetcher{"pe_prefetcher", cgra::cPeConfigBitWidth};
     //!< PE configuration pre-fetcher instance
@@ -10,6 +10,7 @@
 
 #include <systemc>
 #include <cstdint>
+#include <cstddef>
 #include <array>
 
 /*!
@@ -26,17 +27,17 @@ namespace cgra {
  * \param[in] numOfCacheLinesA Number of available cache lines to address
  * 
  * \details
- * Currently its implemented over a simple lookup table, because the 
- * binary logarithm function is not defined for const expression. 
- * Valid inputs for numOfCacheLinesA is ]0, 17].
+ * The result is round-up{log2(numOfCacheLinesA)}, but at least one bit
+ * for a single cache line. Zero cache lines need zero bits.
  */
 constexpr uint16_t calc_bitwidth(const uint16_t numOfCacheLinesA)
 {
-    //Simple look-up table for bitwitdh of select lines
-    constexpr std::array<uint16_t, 17> cBitwidth{
-        0, 1, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 5};
-    
-    return cBitwidth.at(numOfCacheLinesA);
+    uint16_t t_bitwidth{0 < numOfCacheLinesA ? uint16_t{1} : uint16_t{0}};
+
+    while((1UL << t_bitwidth) < numOfCacheLinesA)
+        ++t_bitwidth;
+
+    return t_bitwidth;
 }
 
 /*!
@@ -49,6 +50,76 @@ constexpr uint32_t calc_numOfBytes(const uint32_t numOfBitsA)
     return (numOfBitsA % 8) ? (numOfBitsA / 8 + 1) : (numOfBitsA / 8);
 }
 
+/*!
+ * \brief Calculate number of PEs of a VCGRA topology
+ *
+ * \param[in] peLevelsA Number of PEs for each VCGRA level
+ */
+template <std::size_t N>
+constexpr uint32_t calc_numOfPe(const std::array<uint16_t, N>& peLevelsA)
+{
+    uint32_t t_numOfPe{0};
+
+    for (std::size_t i = 0; N > i; ++i)
+        t_numOfPe += peLevelsA[i];
+
+    return t_numOfPe;
+}
+
+/*!
+ * \brief Calculate the largest number of PEs within a range of VCGRA levels
+ *
+ * \param[in] peLevelsA Number of PEs for each VCGRA level
+ * \param[in] firstA    First level of the range
+ * \param[in] lastA     Last level of the range (included)
+ */
+template <std::size_t N>
+constexpr uint16_t calc_maxPeLevel(const std::array<uint16_t, N>& peLevelsA, const std::size_t firstA,
+                                   const std::size_t lastA)
+{
+    uint16_t t_max{0};
+
+    for (std::size_t i = firstA; lastA >= i && N > i; ++i)
+        t_max = (peLevelsA[i] > t_max) ? peLevelsA[i] : t_max;
+
+    return t_max;
+}
+
+/*!
+ * \brief Calculate the smallest number of PEs of all VCGRA levels
+ *
+ * \param[in] peLevelsA Number of PEs for each VCGRA level
+ */
+template <std::size_t N>
+constexpr uint16_t calc_minPeLevel(const std::array<uint16_t, N>& peLevelsA)
+{
+    uint16_t t_min{UINT16_MAX};
+
+    for (std::size_t i = 0; N > i; ++i)
+        t_min = (peLevelsA[i] < t_min) ? peLevelsA[i] : t_min;
+
+    return t_min;
+}
+
+/*!
+ * \brief Check whether a VCGRA topology has the given number of PEs for each level
+ *
+ * \param[in] peLevelsA    Number of PEs for each VCGRA level
+ * \param[in] topologyA    Expected number of PEs for each VCGRA level
+ */
+template <std::size_t N, std::size_t M>
+constexpr bool calc_isTopology(const std::array<uint16_t, N>& peLevelsA, const std::array<uint16_t, M>& topologyA)
+{
+    if (N != M)
+        return false;
+
+    for (std::size_t i = 0; N > i; ++i)
+        if (peLevelsA[i] != topologyA[i])
+            return false;
+
+    return true;
+}
+
 
 //Global type definitions
 //=======================
@@ -62,46 +133,120 @@ typedef bool ready_type_t;
 //!< \brief Architecture ready signal type from VCGRA
 typedef bool start_type_t;
 //!< \brief Architecture start signal type for VCGRA
+#ifdef TWO_VALUED_CONFIG
+template <int W>
+using config_vector_t = sc_dt::sc_bv<W>;
+//!< \brief Two-valued vector type of configurations and select lines (selected by TWO_VALUED_CONFIG)
+#else
+template <int W>
+using config_vector_t = sc_dt::sc_lv<W>;
+//!< \brief Vector type of configurations and select lines
+#endif
 
 //VCGRA properties
 //-------------------
-static constexpr uint32_t cNumOfLevels{4};
-//!< \brief Number of PEs in the VCGRA instance
-static constexpr uint32_t cNumOfPe{16};
-//!< \brief Number of PEs in the VCGRA instance
-static constexpr std::array<uint16_t, cNumOfLevels> cPeLevels{4, 4, 4, 4}; 
+/*
+ * The topology of a VCGRA is described by the number of PEs of each level,
+ * starting with the level behind the input channel, e.g. -DVCGRA_PE_LEVELS=8,8,8,8,8,8,8,8
+ * for an 8x8 array. All other properties of the array (data inputs and outputs,
+ * VirtualChannels and configuration bitwidths) are derived from it.
+ */
+#ifndef VCGRA_PE_LEVELS
+#define VCGRA_PE_LEVELS 4, 4, 4, 4
+#endif
+static constexpr uint16_t cTopology[]{VCGRA_PE_LEVELS};
+//!< \brief Topology description of the VCGRA instance (number of PEs for each level)
+static constexpr uint32_t cNumOfLevels{sizeof(cTopology) / sizeof(cTopology[0])};
+//!< \brief Number of PE levels in the VCGRA instance
+static constexpr std::array<uint16_t, cNumOfLevels> cPeLevels{VCGRA_PE_LEVELS};
 //!< \brief Number of PEs for each VCGRA level
+static constexpr uint32_t cNumOfPe{calc_numOfPe(cPeLevels)};
+//!< \brief Number of PEs in the VCGRA instance
+
+static constexpr std::array<uint16_t, 4> cDefaultTopology{4, 4, 4, 4};
+//!< \brief Default topology, the hand-written example configurations (e.g. Sobel) are only valid for it
+
+static_assert(2 <= cNumOfLevels, "A VCGRA needs at least two PE levels");
+static_assert(0 < calc_minPeLevel(cPeLevels), "Every VCGRA level needs at least one PE");
+static_assert(32 >= cPeLevels.back(), "The Synchronizer mask of the last VCGRA level is limited to 32 bit");
 
 //Properties PEs
 //-------------------
 static constexpr uint32_t cPeDataBitwidth{16};
 //!< \brief Bitwidth definition for data values of PE instances of a VCGRA
-static constexpr uint32_t cPeConfigLvSize{4};
+static constexpr uint32_t cPeOperationBitwidth{4};
+//!< \brief Bitwidth to decode all available PE operations
+static constexpr uint32_t cPeModeBitwidth{4};
+//!< \brief Bitwidth of the operand mode of a PE with immediate operand
+static constexpr uint32_t cPeImmediateBitwidth{cPeDataBitwidth};
+//!< \brief Bitwidth of the immediate operand of a PE
+#ifdef PACKED_DATAPATH
+#ifndef PACKED_LANES
+#define PACKED_LANES 2
+#endif
+static constexpr uint32_t cPackedLanes{PACKED_LANES};
+//!< \brief Number of sub-word lanes within a PE data value
+#else
+static constexpr uint32_t cPackedLanes{1};
+//!< \brief Number of sub-word lanes within a PE data value
+#endif
+#ifdef PACKED_UNSIGNED
+static constexpr bool cPackedUnsignedLanes{true};
+#else
+static constexpr bool cPackedUnsignedLanes{false};
+#endif
+//!< \brief Sub-word lanes are unsigned and saturate instead of wrapping around
+static constexpr uint32_t cPackedLaneBitwidth{cPeDataBitwidth / cPackedLanes};
+//!< \brief Bitwidth of a sub-word lane
+static_assert(1 <= cPackedLanes && 0 == cPeDataBitwidth % cPackedLanes && 4 <= cPackedLaneBitwidth,
+              "PE data values need to be split into lanes of at least 4 bit");
+#ifdef PE_IMMEDIATES
+static constexpr uint32_t cPeConfigLvSize{cPeOperationBitwidth + cPeModeBitwidth + cPeImmediateBitwidth};
+//!< \brief Bitwidth for logic vector size of a PE configuration (operation | mode | immediate)
+#else
+static constexpr uint32_t cPeConfigLvSize{cPeOperationBitwidth};
 //!< \brief Bitwidth for logic vector size to decode all available PE operations
+#endif
 
 //Properties Virtual Channels
 //---------------------------
-static constexpr uint32_t cInputChannel_NumOfInputs{8};
-//!< \brief Number of inputs for the first layer of a VirtualChannel
+static constexpr uint32_t cInputChannel_NumOfInputs{2U * cPeLevels.front()};
+//!< \brief Number of VCGRA data inputs to the first layer of a VirtualChannel (one per operand of the first level)
+#ifdef FEEDBACK_REGISTERS
+static constexpr uint32_t cFeedbackDepth{2};
+//!< \brief Number of previous invocations whose results are kept in feedback registers
+static constexpr uint32_t cNumOfFeedbackRegisters{cFeedbackDepth * cPeLevels.back()};
+//!< \brief Number of feedback registers which are additional inputs of the first VirtualChannel
+#else
+static constexpr uint32_t cNumOfFeedbackRegisters{0};
+//!< \brief Number of feedback registers which are additional inputs of the first VirtualChannel
+#endif
+static constexpr uint32_t cInputChannel_NumOfChannelInputs{cInputChannel_NumOfInputs + cNumOfFeedbackRegisters};
+//!< \brief Number of inputs for the first layer of a VirtualChannel (data inputs and feedback registers)
 static constexpr uint32_t cInputChannel_InputBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth of inputs for the first layer of a VirtualChannel
-static constexpr uint32_t cInputChannel_NumOfOutputs{8};
+static constexpr uint32_t cInputChannel_NumOfOutputs{2U * cPeLevels.front()};
 //!< \brief Number of outputs for the first layer of a VirtualChannel
 static constexpr uint32_t cInputChannel_OutputBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth of outputs for the first layer of a VirtualChannel
-static constexpr uint32_t cInputChannel_MuxScltBitwidth{3};
+static constexpr uint32_t cInputChannel_MuxScltBitwidth{calc_bitwidth(cInputChannel_NumOfChannelInputs)};
 //!< \brief Bitwidth the internal Multiplexers selection port
 static constexpr uint32_t cInputChannel_InternalBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth the internal connections within the VirtualChannel instance
-static constexpr uint32_t cChannel_NumOfInputs{4};
+/*
+ * All VirtualChannels between two PE levels have the same type. For arrays
+ * with levels of different size, the channels are sized for the largest
+ * levels and the unused inputs and outputs stay unconnected within the VCGRA.
+ */
+static constexpr uint32_t cChannel_NumOfInputs{calc_maxPeLevel(cPeLevels, 0, cNumOfLevels - 2)};
 //!< \brief Number of inputs of a VirtualChannel
 static constexpr uint32_t cChannel_InputBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth of inputs of a VirtualChannel
-static constexpr uint32_t cChannel_NumOfOutputs{8};
+static constexpr uint32_t cChannel_NumOfOutputs{2U * calc_maxPeLevel(cPeLevels, 1, cNumOfLevels - 1)};
 //!< \brief Number of outputs of a VirtualChannel
 static constexpr uint32_t cChannel_OutputBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth of outputs of a VirtualChannel
-static constexpr uint32_t cChannel_MuxScltBitwidth{2};
+static constexpr uint32_t cChannel_MuxScltBitwidth{calc_bitwidth(cChannel_NumOfInputs)};
 //!< \brief Bitwidth the internal Multiplexers selection port
 static constexpr uint32_t cChannel_InternalBitwidth{cPeDataBitwidth};
 //!< \brief Bitwidth the internal connections within the VirtualChannel instance
@@ -114,8 +259,24 @@ static constexpr uint32_t cChannel_InternalBitwidth{cPeDataBitwidth};
  * shared ports at the MMU. Multiplexers are controlled by ManagementUnit to select
  * the necessary connection during runtime.
  */
+#ifndef MMU_BURST_WIDTH
 static constexpr uint16_t cDataStreamBitWidthConfCaches{8};
 //!< \brief Bitwidth for data streams of configuration parts to configuration caches
+static constexpr uint16_t cDataStreamBitWidthDataCaches{cPeDataBitwidth};
+//!< \brief Bitwidth for data streams between MMU and data caches (one data value)
+#else
+static constexpr uint16_t cMmuBurstWidth{MMU_BURST_WIDTH};
+//!< \brief Bitwidth of the MMU bus to all caches in burst mode
+static_assert(0 == cMmuBurstWidth % cPeDataBitwidth && 128 >= cMmuBurstWidth && 16 <= cMmuBurstWidth,
+              "MMU burst width needs to be a multiple of the data value bitwidth between 16 and 128 bit");
+static constexpr uint16_t cDataStreamBitWidthConfCaches{cMmuBurstWidth};
+//!< \brief Bitwidth for data streams of configuration parts to configuration caches
+static constexpr uint16_t cDataStreamBitWidthDataCaches{cMmuBurstWidth};
+//!< \brief Bitwidth for data streams between MMU and data caches (several data values)
+#endif
+#if defined(PARTIAL_RECONFIGURATION) && defined(MMU_BURST_WIDTH)
+#error "Partial reconfiguration writes single bytes into configuration caches and cannot be combined with MMU_BURST_WIDTH"
+#endif
 typedef bool cache_write_type_t;
 //!< \brief Cache type to store streamed input data to a cache location
 typedef bool cache_ack_type_t;
@@ -124,8 +285,16 @@ typedef sc_dt::sc_lv<3> cache_slct_type_t;
 //!< \brief Select type for available cache types (none, data-input, data-output, pe-config, vch-config)
 using cache_load_type_t = cache_write_type_t;
 //!< \brief Alias for cache_write_type_t for data output cache load port of a VCGRA
-static constexpr uint16_t cMemorySize{UINT16_MAX};
+#ifndef MMU_ADDRESS_WIDTH
+#define MMU_ADDRESS_WIDTH 16
+#endif
+static constexpr uint32_t cMemoryAddressBitwidth{MMU_ADDRESS_WIDTH};
+//!< \brief Bitwidth of shared memory addresses
+static_assert(16 <= cMemoryAddressBitwidth && 32 >= cMemoryAddressBitwidth, "Shared memory address width needs to be 16 to 32 bit");
+static constexpr uint64_t cMemorySize{(uint64_t{1} << cMemoryAddressBitwidth) - 1};
 //!< \brief Shared memory size in byte
+typedef sc_dt::sc_lv<cMemoryAddressBitwidth> memory_address_type_t;
+//!< \brief Type of shared memory addresses between ManagementUnit and MMU
 
 
 //Properties for Management Unit
@@ -133,31 +302,52 @@ static constexpr uint16_t cMemorySize{UINT16_MAX};
 constexpr uint32_t cProgramMemorySize{200000};
 //!< \brief Set program memory size for assembler commands
 
+//Number of cache lines (set at build time)
+//--------------------------------------
+#ifndef PE_CONFIG_CACHE_LINES
+#define PE_CONFIG_CACHE_LINES 2
+#endif
+#ifndef CH_CONFIG_CACHE_LINES
+#define CH_CONFIG_CACHE_LINES 2
+#endif
+#ifndef DATA_IN_CACHE_LINES
+#define DATA_IN_CACHE_LINES 2
+#endif
+#ifndef DATA_OUT_CACHE_LINES
+#define DATA_OUT_CACHE_LINES 2
+#endif
+
 //Properties for PE configuration cache
 //--------------------------------------
-static constexpr uint16_t cPeConfigBitWidth{64};
+static constexpr uint16_t cPeConfigBitWidth{cNumOfPe * cPeConfigLvSize};
 //!< \brief Number of bits for whole PE configuration of VCGRA
-static constexpr uint16_t cNumberOfPeCacheLines{2};
+static constexpr uint16_t cNumberOfPeCacheLines{PE_CONFIG_CACHE_LINES};
 //!< \brief Number of cache lines for PE configuration cache
 static constexpr uint16_t cSelectLineBitwidthPeConfCache{calc_bitwidth(cNumberOfPeCacheLines)};
 //!< \brief Bitwidth to select available cache lines round-up{log2(cNumberOfCacheLines)}
 static constexpr uint16_t cBitWidthOfSerialInterfacePeConfCache{cDataStreamBitWidthConfCaches};
 //!< \brief Bitwidth for serial configuration input stream to configuration cache
-typedef sc_dt::sc_lv<cPeConfigBitWidth> pe_config_type_t;
+typedef config_vector_t<cPeConfigBitWidth> pe_config_type_t;
 //!< \brief Signal type for the PE configuration connection between PE configuration cache and VCGRA.
 
 
 //Properties for virtual channel configuration cache
 //--------------------------------------------------
-static constexpr uint16_t cVChConfigBitWidth{80};
-//!< \brief Number of bits for whole vCh configuration of VCGRA
-static constexpr uint16_t cNumberOfVChCacheLines{2};
+static constexpr uint32_t cInputChannelConfigBitwidth{cInputChannel_NumOfOutputs * cInputChannel_MuxScltBitwidth};
+//!< \brief Length of input channel configuration within the VirtualChannel configuration
+static constexpr uint32_t cChannelConfigBitwidth{cChannel_NumOfOutputs * cChannel_MuxScltBitwidth};
+//!< \brief Length of one channel configuration within the VirtualChannel configuration
+static constexpr uint32_t cSyncConfigStart{cInputChannelConfigBitwidth + (cNumOfLevels - 1) * cChannelConfigBitwidth};
+//!< \brief Start of synchronizer configuration within the VirtualChannel configuration
+static constexpr uint16_t cVChConfigBitWidth{static_cast<uint16_t>(8 * calc_numOfBytes(cSyncConfigStart + cPeLevels.back()))};
+//!< \brief Number of bits for whole vCh configuration of VCGRA (80 bit for the default topology without feedback registers)
+static constexpr uint16_t cNumberOfVChCacheLines{CH_CONFIG_CACHE_LINES};
 //!< \brief Number of cache lines for vCh configuration cache
 static constexpr uint16_t cSelectLineBitwidthVChConfCache{calc_bitwidth(cNumberOfVChCacheLines)};
 //!< \brief Bitwidth to select available cache lines round-up{log2(cNumberOfCacheLines)}
 static constexpr uint16_t cBitWidthOfSerialInterfaceVChConfCache{cDataStreamBitWidthConfCaches};
 //!< \brief Bitwidth for serial configuration input stream to configuration cache
-typedef sc_dt::sc_lv<cVChConfigBitWidth> ch_config_type_t;
+typedef config_vector_t<cVChConfigBitWidth> ch_config_type_t;
 //!< \brief Signal type for the VirtualChannel configuration connection between VCH configuration cache and VCGRA.
 
 
@@ -169,11 +359,29 @@ static constexpr uint16_t cDataValueBitwidth{cPeDataBitwidth};
 static constexpr uint16_t cMaxNumberOfValuesPerCacheLine{static_cast<uint16_t>(
     (2*cgra::cPeLevels.front()) >= cgra::cPeLevels.back() ? 2 * cgra::cPeLevels.front() : cPeLevels.back())};
 //!< \brief Number of accessible data values in a cache line
-static constexpr uint16_t cNumberDataInCacheLines{2};
+#ifndef PARTIAL_RECONFIGURATION
+static constexpr uint16_t cMaxNumberOfPlacesPerCacheLine{cMaxNumberOfValuesPerCacheLine};
+//!< \brief Number of places which are addressed by the MMU within a cache line
+#else
+static constexpr uint32_t cMaxNumberOfConfigBytes{calc_numOfBytes(cPeConfigBitWidth) > calc_numOfBytes(cVChConfigBitWidth) ?
+    calc_numOfBytes(cPeConfigBitWidth) : calc_numOfBytes(cVChConfigBitWidth)};
+//!< \brief Number of bytes of the larger configuration cache line
+static constexpr uint16_t cMaxNumberOfPlacesPerCacheLine{static_cast<uint16_t>(
+    cMaxNumberOfConfigBytes > cMaxNumberOfValuesPerCacheLine ? cMaxNumberOfConfigBytes : cMaxNumberOfValuesPerCacheLine)};
+//!< \brief Number of places which are addressed by the MMU within a cache line (values or configuration bytes)
+static_assert(127 > cMaxNumberOfConfigBytes,
+              "Partial reconfiguration addresses configuration bytes with the 7 bit place field of an assembler command");
+#endif
+static constexpr uint16_t cNumberDataInCacheLines{DATA_IN_CACHE_LINES};
 //!< \brief Number of cache lines for data input cache
-static constexpr uint16_t cNumberDataOutCacheLines{2};
+static constexpr uint16_t cNumberDataOutCacheLines{DATA_OUT_CACHE_LINES};
 //!< \brief Number of cache lines for data output cache
 
+static_assert(2 <= cNumberOfPeCacheLines && 255 >= cNumberOfPeCacheLines, "PE configuration cache needs 2 to 255 lines");
+static_assert(2 <= cNumberOfVChCacheLines && 255 >= cNumberOfVChCacheLines, "vCh configuration cache needs 2 to 255 lines");
+static_assert(2 <= cNumberDataInCacheLines && 255 >= cNumberDataInCacheLines, "Data input cache needs 2 to 255 lines");
+static_assert(2 <= cNumberDataOutCacheLines && 255 >= cNumberDataOutCacheLines, "Data output cache needs 2 to 255 lines");
+
 //MMU initializer list
 //--------------------------------------------------
 /*!
@@ -11,10 +11,23 @@
 #include <systemc>
 #include <cstdint>
 #include <array>
+#ifdef CONFIG_DECODE_CACHE
+#include <unordered_map>
+#endif
 #include "Typedef.h"
 #include "ProcessingElement.h"
+#ifdef PIPELINED_PE
+#include "PipelinedProcessingElement.h"
+#endif
+#ifdef CROSSBAR_CHANNELS
+#include "CrossbarVirtualChannel.h"
+#else
 #include "VirtualChannel.h"
+#endif
 #include "Demultiplexer.h"
+#ifdef FEEDBACK_REGISTERS
+#include "FeedbackRegisters.h"
+#endif
 #include "Synchronizer.h"
 #include "Selector.h"
 
@@ -23,6 +36,12 @@
 #endif
 
 namespace cgra {
+
+static_assert(cgra::PeOperations::LAST < (1U << cgra::cPeOperationBitwidth),
+              "PE configuration part is too small for all operation codes");
+static_assert(cgra::cPeOperationBitwidth <= cgra::cPeConfigLvSize,
+              "PE configuration part is too small for the operation code");
+
 /*!
  * \class VCGRA
  *
@@ -33,15 +52,65 @@ namespace cgra {
  * Channels. IT also includes Demultiplexers and Selectors for a the configuration
  * bitstreams loaded from the configuration caches.
  *
+ * With FEEDBACK_REGISTERS, the results of the last cFeedbackDepth invocations
+ * are kept in FeedbackRegisters. They are the inputs cInputChannel_NumOfInputs
+ * and above of the input channel and can be selected by its configuration like
+ * data inputs. Thus, multi-pass kernels can use intermediate results without
+ * transferring them to the host.
+ *
+ * With CONFIG_DECODE_CACHE, the VCGRA decodes its configuration inputs
+ * itself and caches the decoded state keyed by the configuration bitstream.
+ * A configuration change writes the configuration parts of the PEs, the
+ * VirtualChannels and the Synchronizer as well as the select lines of the
+ * VirtualChannels from the cache in one process. The Demultiplexer and the
+ * Selectors are not instantiated and the VirtualChannels do not split their
+ * configuration part again.
  */
 class VCGRA : public sc_core::sc_module
 {
 public:
+#if defined(PACKED_DATAPATH)
+    typedef cgra::PackedDatapath<cgra::cPeDataBitwidth,
+                cgra::cPeDataBitwidth, cgra::cPackedLanes, cgra::cPackedUnsignedLanes> pe_datapath_type_t;
+#elif defined(NATIVE_DATAPATH)
+    typedef cgra::NativeDatapath<cgra::cPeDataBitwidth,
+                cgra::cPeDataBitwidth> pe_datapath_type_t;
+#else
+    typedef cgra::ScIntDatapath<cgra::cPeDataBitwidth,
+                cgra::cPeDataBitwidth> pe_datapath_type_t;
+#endif
+    //!< \brief Datapath policy of the Processing_Elements (selected by PACKED_DATAPATH or NATIVE_DATAPATH)
+#ifdef PIPELINED_PE
+    typedef cgra::PipelinedProcessing_Element<cgra::cPeDataBitwidth,
+                cgra::cPeDataBitwidth, cgra::cPeConfigLvSize,
+                pe_datapath_type_t> pe_type_t;
+    //!< \brief Processing_Element type definition for VCGRA instance (selected by PIPELINED_PE)
+#else
     typedef cgra::Processing_Element<cgra::cPeDataBitwidth,
-                cgra::cPeDataBitwidth, cgra::cPeConfigLvSize> pe_type_t;
+                cgra::cPeDataBitwidth, cgra::cPeConfigLvSize,
+                pe_datapath_type_t> pe_type_t;
     //!< \brief Processing_Element type definition for VCGRA instance
+#endif
+#ifdef CROSSBAR_CHANNELS
+    typedef cgra::CrossbarVirtualChannel<
+                cgra::cInputChannel_NumOfChannelInputs,
+                cgra::cInputChannel_InputBitwidth,
+                cgra::cInputChannel_NumOfOutputs,
+                cgra::cInputChannel_OutputBitwidth,
+                cgra::cInputChannel_MuxScltBitwidth,
+                cgra::cInputChannel_InternalBitwidth> input_channel_type_t;
+    //!< \brief VirtualChannel type for first layer of a VCGRA instance (selected by CROSSBAR_CHANNELS)
+    typedef cgra::CrossbarVirtualChannel<
+                cgra::cChannel_NumOfInputs,
+                cgra::cChannel_InputBitwidth,
+                cgra::cChannel_NumOfOutputs,
+                cgra::cChannel_OutputBitwidth,
+                cgra::cChannel_MuxScltBitwidth,
+                cgra::cChannel_InternalBitwidth> channel_type_t;
+    //!< \brief VirtualChannel type for standard layer of a VCGRA instance (selected by CROSSBAR_CHANNELS)
+#else
     typedef cgra::VirtualChannel<
-                cgra::cInputChannel_NumOfInputs,
+                cgra::cInputChannel_NumOfChannelInputs,
                 cgra::cInputChannel_InputBitwidth,
                 cgra::cInputChannel_NumOfOutputs,
                 cgra::cInputChannel_OutputBitwidth,
@@ -56,16 +125,24 @@ public:
                 cgra::cChannel_MuxScltBitwidth,
                 cgra::cChannel_InternalBitwidth> channel_type_t;
     //!< \brief VirtualChannel type for standard layer of a VCGRA instance
+#endif
     typedef cgra::Demultiplexer<
                 cgra::pe_config_type_t,
                 cgra::cNumOfPe,
                 cgra::cPeConfigBitWidth> demux_type_t;
     //!< \brief Demultiplexer type for distributing PE configuration
-    typedef cgra::Selector<cgra::ch_config_type_t,1,24,24> in_ch_config_selector_type_t;
+    typedef cgra::Selector<cgra::ch_config_type_t,1,
+                cgra::cInputChannelConfigBitwidth,
+                cgra::cInputChannelConfigBitwidth> in_ch_config_selector_type_t;
     //!< \brief Selector type for input channel configuration
-    typedef cgra::Selector<cgra::ch_config_type_t,3,16,48> ch_config_selector_type_t;
+    typedef cgra::Selector<cgra::ch_config_type_t,
+                cgra::cNumOfLevels - 1,
+                cgra::cChannelConfigBitwidth,
+                (cgra::cNumOfLevels - 1) * cgra::cChannelConfigBitwidth> ch_config_selector_type_t;
     //!< \brief Selector type for general channel configurations
-    typedef cgra::Selector<cgra::ch_config_type_t,1,4,4> sync_selector_type_t;
+    typedef cgra::Selector<cgra::ch_config_type_t,1,
+                cgra::cPeLevels.back(),
+                cgra::cPeLevels.back()> sync_selector_type_t;
     //!< \brief Selector type for synchronization configuration
     typedef cgra::Synchronizer<pe_type_t::valid_type_t,
             cgra::cPeLevels.back()> synchronizer_type_t;
@@ -82,6 +159,12 @@ public:
     //!< \brief VCGRA data input type
     typedef pe_type_t::output_type_t data_output_type_t;
     //!< \brief VCGRA data output type
+#ifdef FEEDBACK_REGISTERS
+    typedef cgra::FeedbackRegisters<data_output_type_t,
+            cgra::cPeLevels.back(),
+            cgra::cFeedbackDepth> feedback_type_t;
+    //!< \brief Register file for results of previous invocations
+#endif
 
 
 #ifndef GSYSC
@@ -123,6 +206,7 @@ public:
 
     //Member functions
     //------------------
+    SC_HAS_PROCESS(VCGRA);
     /*!
      * \brief General constructor
      */
@@ -133,6 +217,26 @@ public:
      */
     virtual void end_of_elaboration() override;
 
+#ifdef CONFIG_DECODE_CACHE
+    /*!
+     * \brief Apply the decoded PE configuration to the configuration parts of all PEs
+     *
+     * \details
+     * The bitstream is only sliced if it is not cached.
+     */
+    void decode_pe_configuration();
+
+    /*!
+     * \brief Apply the decoded VirtualChannel configuration
+     *
+     * \details
+     * Writes the configuration parts and select lines of all VirtualChannels
+     * and the Synchronizer mask. The bitstream is only sliced if it is not
+     * cached.
+     */
+    void decode_ch_configuration();
+#endif
+
     /*!
      * \brief Print sc_module type
      *
@@ -180,6 +284,122 @@ private:
     VCGRA(VCGRA&& src) = delete;                    //!< \brief because move not implemented for sc_module
     VCGRA& operator=(VCGRA&& src) = delete;         //!< \brief because move not implemented for sc_module
 
+    static constexpr uint32_t cNumOfUnusedChannelOutputs{
+        (cgra::cNumOfLevels - 1) * cgra::cChannel_NumOfOutputs - 2 * (cgra::cNumOfPe - cgra::cPeLevels.front())};
+    //!< \brief Outputs of general VirtualChannels without a succeeding PE (only for levels of different size)
+
+#ifdef CONFIG_DECODE_CACHE
+    static constexpr std::size_t cNumOfDecodes{64};
+    //!< \brief Maximum number of cached decodes per configuration input
+
+    typedef std::array<uint32_t, (cgra::cPeConfigBitWidth + 31) / 32> pe_config_key_t;
+    //!< \brief PE configuration bitstream as 32 bit words
+    typedef std::array<uint32_t, (cgra::cVChConfigBitWidth + 31) / 32> ch_config_key_t;
+    //!< \brief VirtualChannel configuration bitstream as 32 bit words
+
+    /*!
+     * \struct ConfigKeyHash
+     *
+     * \brief FNV-1a hash of a configuration bitstream
+     */
+    struct ConfigKeyHash
+    {
+        template <std::size_t K>
+        std::size_t operator()(const std::array<uint32_t, K>& keyA) const
+        {
+            uint64_t t_hash{0xcbf29ce484222325ULL};
+            for (const auto t_word : keyA)
+            {
+                t_hash ^= t_word;
+                t_hash *= 0x100000001b3ULL;
+            }
+            return static_cast<std::size_t>(t_hash);
+        }
+    };
+
+    /*!
+     * \struct PeDecode
+     *
+     * \brief Decoded PE configuration, the outputs of the Demultiplexer
+     */
+    struct PeDecode
+    {
+        std::array<demux_type_t::configpart_type_t, cgra::cNumOfPe> parts;
+        //!< \brief Configuration part of each PE
+    };
+
+    /*!
+     * \struct ChDecode
+     *
+     * \brief Decoded VirtualChannel configuration, the outputs of the Selectors and the channel select lines
+     */
+    struct ChDecode
+    {
+        in_ch_config_selector_type_t::configpart_type_t inputChannelPart;
+        //!< \brief Configuration part of the input channel
+        std::array<uint32_t, cgra::cInputChannel_NumOfOutputs> inputChannelSelects;
+        //!< \brief Select lines of the input channel
+        std::array<ch_config_selector_type_t::configpart_type_t, cgra::cNumOfLevels - 1> channelParts;
+        //!< \brief Configuration part of each general VirtualChannel
+        std::array<std::array<uint32_t, cgra::cChannel_NumOfOutputs>, cgra::cNumOfLevels - 1> channelSelects;
+        //!< \brief Select lines of each general VirtualChannel
+        sync_selector_type_t::configpart_type_t syncPart;
+        //!< \brief Synchronizer mask
+    };
+
+    /*!
+     * \brief Copy the words of a configuration bitstream into a cache key
+     *
+     * \details
+     * The key holds the value bits only, configurations are expected to be
+     * free of X and Z.
+     *
+     * \tparam K Key type
+     * \tparam T Configuration vector type
+     * \param[in] configA Configuration bitstream
+     */
+    template <typename K, typename T>
+    static K config_key(const T& configA)
+    {
+        K t_key;
+        for (uint32_t i = 0; t_key.size() > i; ++i)
+            t_key[i] = configA.get_word(i);
+        return t_key;
+    }
+
+    /*!
+     * \brief Check a configuration bitstream for X or Z bits
+     *
+     * \details get_word() reads X and Z as one, thus configurations with
+     * X or Z bits share their key with a defined configuration and are
+     * not cached.
+     *
+     * \param[in] configA Configuration bitstream
+     */
+    template <typename T>
+    static bool has_unknown_bits(const T& configA)
+    {
+        for (int i = 0; configA.size() > i; ++i)
+            if (0 != configA.get_cword(i))
+                return true;
+        return false;
+    }
+
+    /*!
+     * \brief Slice a PE configuration bitstream like the Demultiplexer
+     *
+     * \param[in] configA PE configuration bitstream
+     */
+    static PeDecode decode_pe(const cgra::pe_config_type_t& configA);
+
+    /*!
+     * \brief Slice a VirtualChannel configuration bitstream like the Selectors and VirtualChannels
+     *
+     * \param[in] configA VirtualChannel configuration bitstream
+     */
+    static ChDecode decode_ch(const cgra::ch_config_type_t& configA);
+#endif
+
 #ifndef GSYSC
     //VCGRA component instances
     sc_core::sc_vector<pe_type_t> m_pe_instances{"VCGRA_PEs",};
@@ -198,6 +418,7 @@ private:
     //!< \brief VirtualChannel instance of the first level
     synchronizer_type_t m_sync{"VCGRA_Sync"};
     //!< \brief Synchronizer for VCGRA ready signal generation.
+#ifndef CONFIG_DECODE_CACHE
     demux_type_t m_pe_config_demux{"PE_config_Demux"};
     //!< \brief Distributes PE configuration bitstream to PE instances
     in_ch_config_selector_type_t m_input_channel_selector{
@@ -207,14 +428,28 @@ private:
     //!< \brief Selector to distribute VirtualChannel configuration to input channel.
     ch_config_selector_type_t m_channel_selector{
         "Channel_Selector",
-        24,
+        cgra::cInputChannelConfigBitwidth,
         cgra::cVChConfigBitWidth};
     //!< \brief Selector to distribute VirtualChannel configurations to general channels.
     sync_selector_type_t m_sync_selector{
         "Sync_Selector",
-        72,
+        cgra::cSyncConfigStart,
         cgra::cVChConfigBitWidth};
     //!< \brief Selector to distribute synchronization mask to general Synchronizer.
+#else
+    std::unordered_map<pe_config_key_t, PeDecode, ConfigKeyHash> m_peDecodes;
+    //!< \brief Cached decodes of PE configurations
+    std::unordered_map<ch_config_key_t, ChDecode, ConfigKeyHash> m_chDecodes;
+    //!< \brief Cached decodes of VirtualChannel configurations
+    uint32_t m_decodes{0U};
+    //!< \brief Number of sliced configuration bitstreams
+    uint32_t m_cachedDecodes{0U};
+    //!< \brief Number of configuration changes served by cached decodes
+#endif
+#ifdef FEEDBACK_REGISTERS
+    feedback_type_t m_feedback{"VCGRA_Feedback"};
+    //!< \brief Feedback registers, additional inputs of the input channel
+#endif
 
 #ifndef GSYSC
     //Internal signals
@@ -222,7 +457,7 @@ private:
         s_input_ch_configuration{"S_input_channel_configuration"};
     //!< \brief Configuration part for input channel.
     std::array<sc_core::sc_signal<ch_config_selector_type_t::configpart_type_t>,
-        3> s_ch_configurations;
+        cgra::cNumOfLevels - 1> s_ch_configurations;
     //!< \brief Configuration parts for each VirtualChannel per layer.
     std::array<sc_core::sc_signal<demux_type_t::configpart_type_t>,
         cgra::cNumOfPe> s_pe_configurations;
@@ -242,13 +477,28 @@ private:
     std::array<sc_core::sc_signal<pe_type_t::valid_type_t>,
         cgra::cNumOfPe> s_pe_valid_signals;
     //!< \brief PE valid signals
+#ifdef FEEDBACK_REGISTERS
+    std::array<sc_core::sc_signal<data_output_type_t>,
+        cgra::cNumOfFeedbackRegisters> s_feedback_signals;
+    //!< \brief Feedback register outputs
+#endif
+    sc_core::sc_signal<channel_type_t::input_type_t> s_unused_channel_input{"s_unused_channel_input"};
+    //!< \brief Constant input of VirtualChannel inputs without a preceding PE
+    sc_core::sc_signal<channel_type_t::valid_type_t> s_unused_channel_valid{"s_unused_channel_valid"};
+    //!< \brief Constant (invalid) valid signal of VirtualChannel inputs without a preceding PE
+    std::array<sc_core::sc_signal<channel_type_t::output_type_t>,
+        cNumOfUnusedChannelOutputs> s_unused_channel_outputs;
+    //!< \brief Open VirtualChannel outputs without a succeeding PE
+    std::array<sc_core::sc_signal<channel_type_t::enables_type_t>,
+        cNumOfUnusedChannelOutputs> s_unused_channel_enables;
+    //!< \brief Open VirtualChannel enables without a succeeding PE
 #else
     //Internal signals
     sc_signal<in_ch_config_selector_type_t::configpart_type_t>
         s_input_ch_configuration{"S_input_channel_configuration"};
     //!< \brief Configuration part for input channel.
     std::array<sc_signal<ch_config_selector_type_t::configpart_type_t>,
-        3> s_ch_configurations;
+        cgra::cNumOfLevels - 1> s_ch_configurations;
     //!< \brief Configuration parts for each VirtualChannel per layer.
     std::array<sc_signal<demux_type_t::configpart_type_t>,
         cgra::cNumOfPe> s_pe_configurations;
@@ -268,6 +518,21 @@ private:
     std::array<sc_signal<pe_type_t::valid_type_t>,
         cgra::cNumOfPe> s_pe_valid_signals;
     //!< \brief PE valid signals
+#ifdef FEEDBACK_REGISTERS
+    std::array<sc_signal<data_output_type_t>,
+        cgra::cNumOfFeedbackRegisters> s_feedback_signals;
+    //!< \brief Feedback register outputs
+#endif
+    sc_signal<channel_type_t::input_type_t> s_unused_channel_input{"s_unused_channel_input"};
+    //!< \brief Constant input of VirtualChannel inputs without a preceding PE
+    sc_signal<channel_type_t::valid_type_t> s_unused_channel_valid{"s_unused_channel_valid"};
+    //!< \brief Constant (invalid) valid signal of VirtualChannel inputs without a preceding PE
+    std::array<sc_signal<channel_type_t::output_type_t>,
+        cNumOfUnusedChannelOutputs> s_unused_channel_outputs;
+    //!< \brief Open VirtualChannel outputs without a succeeding PE
+    std::array<sc_signal<channel_type_t::enables_type_t>,
+        cNumOfUnusedChannelOutputs> s_unused_channel_enables;
+    //!< \brief Open VirtualChannel enables without a succeeding PE
 #endif
 
     /*!
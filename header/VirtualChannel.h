@@ -7,6 +7,10 @@
 #include "Multiplexer.h"
 #include "Typedef.h"
 
+#ifdef ACTIVITY_GATING
+#include "ClockEdgeTracker.hpp"
+#endif
+
 #ifdef GSYSC
 #include <gsysc.h>
 #endif
@@ -53,7 +57,7 @@ public:
     //!< \brief Clock type
     typedef cgra::reset_type_t reset_type_t;
     //!< \brief Reset type
-    typedef sc_dt::sc_lv<T * L> conf_type_t;
+    typedef cgra::config_vector_t<T * L> conf_type_t;
     //!< \brief Type of VirtualChannel configuration port
     typedef typename mux_type_t::valid_type_t valid_type_t;
     //!< \brief Type of VirtualChannel valid signals
@@ -207,6 +211,21 @@ public:
             channel_outputs[i].write(0);;
             enables[i].write(0);
         }
+
+#ifdef ACTIVITY_GATING
+        m_inputActivity |= rst.value_changed_event();
+        for (uint32_t i = 0; i < R; ++i)
+        {
+            m_inputActivity |= channel_inputs[i].value_changed_event();
+            m_inputActivity |= valids[i].value_changed_event();
+        }
+        for (uint32_t i = 0; i < T; ++i)
+        {
+            m_outputActivity |= m_outputBuffers[i].value_changed_event();
+            m_outputActivity |= m_enablesBuffer[i].value_changed_event();
+        }
+        m_edgeTracker.init(clk);
+#endif
     }
 
     /*!
@@ -260,10 +279,16 @@ public:
      */
     void dumpMcpatStatistics(std::ostream& os = ::std::cout) const
     {
+#ifdef ACTIVITY_GATING
+        //A VC is busy for all clock cycles it did not observe
+        const uint32_t t_pending = m_inputSuspended ? m_edgeTracker.pending() : 0U;
+#else
+        const uint32_t t_pending = 0U;
+#endif
         os << name() << "\t" << kind() << std::endl;
-        os << "total cycles: " << m_totalCycles << "\n";
+        os << "total cycles: " << m_totalCycles + t_pending << "\n";
         os << "idle cycles: " << m_idleCycles << "\n";
-        os << "busy cycles: " << m_busyCycles << "\n";
+        os << "busy cycles: " << m_busyCycles + t_pending << "\n";
         os << std::endl;
     }
 #endif
@@ -271,9 +296,30 @@ public:
     //Processes
     /*!
      * \brief Buffer VC inputs in internal buffers for one clock cycle
+     *
+     * \details
+     * With ACTIVITY_GATING, the process suspends itself after sampling
+     * until an input, valid or reset signal changes.
      */
     void buffer_input()
     {
+#ifdef ACTIVITY_GATING
+        if (m_inputSuspended)
+        {
+            //Woken up by an input change, sample it on the next clock edge
+            m_inputSuspended = false;
+            if (!clk.posedge())
+                return;
+        }
+#ifdef MCPAT
+        if (clk.posedge())
+        {
+            const uint32_t t_missedCycles{m_edgeTracker.observe()};
+            m_totalCycles += t_missedCycles;
+            m_busyCycles += t_missedCycles;
+        }
+#endif
+#endif
 
 #ifdef MCPAT
         /* A virtual channel always changes its input and output buffer states.
@@ -298,18 +344,48 @@ public:
                 m_validBuffer[i].write(valids[i].read());
             }
         }
+
+#ifdef ACTIVITY_GATING
+        //Sampling unchanged inputs again would not change the internal buffers
+        if (clk.posedge())
+        {
+            next_trigger(m_inputActivity);
+            m_inputSuspended = true;
+        }
+#endif
     }
 
     /*!
      * \brief Buffer VC outputs in internal buffers for one clock cycle
+     *
+     * \details
+     * With ACTIVITY_GATING, the process suspends itself after updating
+     * the outputs until one of the Multiplexer outputs changes.
      */
     void buffer_output()
     {
+#ifdef ACTIVITY_GATING
+        if (m_outputSuspended)
+        {
+            //Woken up by a Multiplexer, forward its output on the next clock edge
+            m_outputSuspended = false;
+            if (!clk.posedge())
+                return;
+        }
+#endif
         for(uint32_t i = 0; i < T; ++i)
         {
             channel_outputs[i].write(m_outputBuffers[i].read().range(U - 1, 0));
             enables[i].write(m_enablesBuffer[i].read());
         }
+
+#ifdef ACTIVITY_GATING
+        if (clk.posedge())
+        {
+            next_trigger(m_outputActivity);
+            m_outputSuspended = true;
+        }
+#endif
     }
 
     /*!
@@ -333,9 +409,36 @@ public:
      *
      */
     void split_select()
+    {
+        if (m_externalSelects)
+            return;
+
+        for(uint32_t i = 0; i < T; ++i)
+            m_selectLines[i].write(conf.read().range(cConfigLength - 1 - i * L, cConfigLength - (i + 1) * L));
+    }
+
+    /*!
+     * \brief Drive the select lines with load_selects() instead of splitting conf
+     *
+     * \details
+     * Needs to be called during elaboration. Afterwards, conf is only
+     * observed and the owner of the channel needs to call load_selects()
+     * for every configuration change.
+     */
+    void use_external_selects()
+    {
+        m_externalSelects = true;
+    }
+
+    /*!
+     * \brief Write pre-decoded select lines to the internal Multiplexers
+     *
+     * \param[in] selectsA Selected input of every output, same values as the fields of conf
+     */
+    void load_selects(const std::array<uint32_t, T>& selectsA)
     {
         for(uint32_t i = 0; i < T; ++i)
-            m_selectLines[i].write(conf.read().range(this->m_config_length - 1 - i * L, this->m_config_length - (i + 1) * L));
+            m_selectLines[i].write(select_type_t(selectsA[i]));
     }
 
 private:
@@ -346,8 +449,22 @@ private:
     VirtualChannel(VirtualChannel&& src) = delete;
     VirtualChannel& operator=(VirtualChannel&& src) = delete;
 
-    uint16_t m_config_length{L * T};
+    static constexpr uint32_t cConfigLength{L * T};
     //!< \brief Bitstream length of configuration for VirtualChannel
+    bool m_externalSelects{false};
+    //!< \brief Select lines are written by load_selects() instead of split_select()
+#ifdef ACTIVITY_GATING
+    sc_core::sc_event_or_list m_inputActivity;
+    //!< \brief Value changes which wake up a suspended buffer_input
+    sc_core::sc_event_or_list m_outputActivity;
+    //!< \brief Value changes which wake up a suspended buffer_output
+    cgra::ClockEdgeTracker m_edgeTracker;
+    //!< \brief Reconstructs clock cycles while buffer_input is suspended
+    bool m_inputSuspended{false};
+    //!< \brief buffer_input waits for an input change
+    bool m_outputSuspended{false};
+    //!< \brief buffer_output waits for a Multiplexer output change
+#endif
 #ifdef MCPAT
     //McPAT dynamic statistic counters:
     uint32_t m_totalCycles;   //!< \brief Count total number of executed cycles
@@ -0,0 +1,90 @@
+/*
+ * WorkloadGenerator.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef WORKLOAD_GENERATOR_H_
+#define WORKLOAD_GENERATOR_H_
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include "Typedef.h"
+#include "PeDatapath.h"
+#include "PeConfiguration.hpp"
+#include "ChConfiguration.hpp"
+
+namespace cgra
+{
+
+/*!
+ * \brief Operations of the PEs behind the first level of the scaling workload
+ *
+ * \details
+ * Only operations without division are used, such that random input vectors
+ * never divide by zero.
+ */
+static constexpr std::array<PeOperations::OP, 4> cScalingOperations{
+    PeOperations::ADD, PeOperations::SUB, PeOperations::GRE, PeOperations::MIN};
+
+/*!
+ * \brief PE configuration of a workload which uses all PEs of the topology
+ *
+ * \details
+ * The PEs of the first level multiply their two data inputs. PE j of level
+ * l > 0 executes cScalingOperations[(l + j) % 4]. Operands and immediate
+ * operands of all PEs are taken from the VirtualChannels.
+ *
+ * \return PE configuration with calc_numOfBytes(cPeConfigBitWidth) bytes
+ */
+inline std::vector<uint8_t> generateScalingPeConfiguration()
+{
+    std::vector<uint8_t> t_config(calc_numOfBytes(cPeConfigBitWidth), 0);
+
+    uint32_t t_pe{0};
+    for (uint32_t t_level = 0; cNumOfLevels > t_level; ++t_level) {
+        for (uint32_t t_index = 0; cPeLevels[t_level] > t_index; ++t_index, ++t_pe) {
+            setPeOperation(t_config, t_pe,
+                           0 == t_level ? PeOperations::MUL
+                                        : cScalingOperations[(t_level + t_index) % cScalingOperations.size()]);
+        }
+    }
+
+    return t_config;
+}
+
+/*!
+ * \brief VirtualChannel configuration of the workload of generateScalingPeConfiguration()
+ *
+ * \details
+ * PE j of the first level reads the data inputs 2 * j and 2 * j + 1. PE j of
+ * level l > 0 reads PE j and PE j + 1 (modulo the level size) of level l - 1,
+ * thus every PE result is used and all data outputs are valid.
+ *
+ * \return VirtualChannel configuration with calc_numOfBytes(cVChConfigBitWidth) bytes
+ */
+inline std::vector<uint8_t> generateScalingChConfiguration()
+{
+    std::vector<uint8_t> t_config(calc_numOfBytes(cVChConfigBitWidth), 0);
+
+    for (uint32_t t_output = 0; cInputChannel_NumOfOutputs > t_output; ++t_output) {
+        setInputSelect(t_config, t_output, t_output);
+    }
+
+    for (uint32_t t_channel = 0; cNumOfLevels - 1 > t_channel; ++t_channel) {
+        const uint32_t t_sources{cPeLevels[t_channel]};
+        for (uint32_t t_index = 0; cPeLevels[t_channel + 1] > t_index; ++t_index) {
+            setChannelSelect(t_config, t_channel, 2 * t_index, t_index % t_sources);
+            setChannelSelect(t_config, t_channel, 2 * t_index + 1, (t_index + 1) % t_sources);
+        }
+    }
+
+    setSyncMask(t_config, 0);
+
+    return t_config;
+}
+
+} // namespace cgra
+
+#endif // WORKLOAD_GENERATOR_H_
@@ -6,9 +6,15 @@
  */
 
 #include "VCGRA.h"
+#include "SimdVcgra.hpp"
+#include "PeConfiguration.hpp"
 #include <systemc>
 #include <vector>
 
+#ifdef STREAMING_VCGRA
+#include "StreamingVCGRA.h"
+#endif
+
 namespace cgra
 {
 
@@ -25,8 +31,10 @@ class Testbench : public sc_core::sc_module
     // Entity ports
     sc_core::sc_in<cgra::clock_type_t> clk{"clk"};
     //!< \brief VCGRA clock port
+#ifndef STREAMING_VCGRA
     sc_core::sc_out<cgra::start_type_t> start{"start"};
     //!< \brief VCGRA start port
+#endif
     sc_core::sc_out<cgra::reset_type_t> rst{"rst"};
     //!< \brief VCGRA reset port
     sc_core::sc_out<cgra::pe_config_type_t> pe_config{"pe_config"};
@@ -35,16 +43,29 @@ class Testbench : public sc_core::sc_module
     //!< \brief VCGRA VirtualChannel configuration port
     std::array<sc_core::sc_out<data_input_type_t>, cgra::cInputChannel_NumOfInputs> data_inputs;
     //!< \brief VCGRA data inputs to first VirtualChannel level
+#ifndef STREAMING_VCGRA
     sc_core::sc_in<cgra::ready_type_t> ready{"ready"};
     //!< \brief VCGRA ready port
+#else
+    std::array<sc_core::sc_out<StreamingVCGRA::handshake_type_t>, cgra::cInputChannel_NumOfInputs> in_valids;
+    //!< \brief Valid of the input lanes
+    std::array<sc_core::sc_in<StreamingVCGRA::handshake_type_t>, cgra::cInputChannel_NumOfInputs> in_readys;
+    //!< \brief Ready of the input lanes
+    sc_core::sc_in<StreamingVCGRA::handshake_type_t> out_valid{"out_valid"};
+    //!< \brief VCGRA data outputs are valid
+    sc_core::sc_out<StreamingVCGRA::handshake_type_t> out_ready{"out_ready"};
+    //!< \brief Testbench accepts VCGRA data outputs
+#endif
     std::array<sc_core::sc_in<data_output_type_t>, cgra::cPeLevels.back()> data_outputs;
     //!< \brief VCGRA data outputs
 #else
     // Entity ports
     sc_in<cgra::clock_type_t> clk{"clk"};
     //!< \brief VCGRA clock port
+#ifndef STREAMING_VCGRA
     sc_out<cgra::start_type_t> start{"start"};
     //!< \brief VCGRA start port
+#endif
     sc_out<cgra::reset_type_t> rst{"rst"};
     //!< \brief VCGRA reset port
     sc_out<cgra::pe_config_type_t> pe_config{"pe_config"};
@@ -53,8 +74,19 @@ class Testbench : public sc_core::sc_module
     //!< \brief VCGRA VirtualChannel configuration port
     std::array<sc_out<data_input_type_t>, cgra::cInputChannel_NumOfInputs> data_inputs;
     //!< \brief VCGRA data inputs to first VirtualChannel level
+#ifndef STREAMING_VCGRA
     sc_in<cgra::ready_type_t> ready{"ready"};
     //!< \brief VCGRA ready port
+#else
+    std::array<sc_out<StreamingVCGRA::handshake_type_t>, cgra::cInputChannel_NumOfInputs> in_valids;
+    //!< \brief Valid of the input lanes
+    std::array<sc_in<StreamingVCGRA::handshake_type_t>, cgra::cInputChannel_NumOfInputs> in_readys;
+    //!< \brief Ready of the input lanes
+    sc_in<StreamingVCGRA::handshake_type_t> out_valid{"out_valid"};
+    //!< \brief VCGRA data outputs are valid
+    sc_out<StreamingVCGRA::handshake_type_t> out_ready{"out_ready"};
+    //!< \brief Testbench accepts VCGRA data outputs
+#endif
     std::array<sc_in<data_output_type_t>, cgra::cPeLevels.back()> data_outputs;
     //!< \brief VCGRA data outputs
 #endif
@@ -133,10 +165,29 @@ class Testbench : public sc_core::sc_module
 
     void dump(::std::ostream &os = ::std::cout) const override;
 
+#ifndef STREAMING_VCGRA
     /**
      * @brief Process the stimulation of the VCGRA instance
      */
     void stimuli();
+#else
+    /**
+     * @brief Stream all pixel windows through the StreamingVCGRA instance
+     *
+     * @details
+     * Each Sobel direction is processed in three passes like the functional
+     * model: upper and lower half of the kernel with the first configuration
+     * and the final sum with the second one. The configuration is only
+     * changed between passes. Within a pass, input vectors are sent back to
+     * back and many of them are processed by the VCGRA at the same time.
+     */
+    void streamStimuli();
+
+    /**
+     * @brief Collect results of the StreamingVCGRA instance
+     */
+    void collectResults();
+#endif
 
     /**
      * @brief Initialize ports before starting simulation
@@ -144,6 +195,115 @@ class Testbench : public sc_core::sc_module
     void end_of_elaboration() override;
 
   private:
+    /**
+     * @brief PE configurations of the three passes of a Sobel direction
+     *
+     * @details
+     * The passes calculate the upper and lower half of the kernel and the
+     * final sum. With PE_IMMEDIATES, the kernel coefficients are immediate
+     * operands of the multiplying PEs. Thus, only the pixels are transmitted
+     * as data values.
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @return PE configurations of the upper half, lower half and final sum
+     */
+    std::array<std::vector<uint8_t>, 3> sobelPeConfigurations(const std::array<int16_t, 3 * 3> &kernelA) const;
+
+    /**
+     * @brief Recalculate a Sobel direction with the functional VCGRA model
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @param resultsA  Results of the cycle-accurate simulation
+     * @return Number of pixels which differ from the functional model
+     */
+    std::size_t verifyWithFunctionalModel(const std::array<int16_t, 3 * 3> &kernelA,
+                                          const std::array<int16_t, 64 * 64> &resultsA) const;
+
+    typedef std::array<data_input_type_t, cgra::cInputChannel_NumOfInputs> input_vector_t;
+    //!< @brief Values of all data inputs
+
+#ifdef PACKED_DATAPATH
+    /**
+     * @brief Kernel indices of the Sobel coefficients with one sign
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @param negativeA Select the negative instead of the positive coefficients
+     * @return Indices of up to four coefficients, one for each multiplying PE
+     */
+    static std::vector<std::size_t> packedSobelTerms(const std::array<int16_t, 3 * 3> &kernelA, bool negativeA);
+
+    /**
+     * @brief Input vectors of the packed Sobel run
+     *
+     * @details
+     * Lane l of input vector v belongs to pixel window v * cPackedLanes + l.
+     * The pixels are quantized by cPackedPixelShift bits. The first (second)
+     * set of vectors multiplies the pixels with the positive coefficients
+     * (magnitudes of the negative coefficients) of the kernel, such that all
+     * lane values are non-negative.
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @return Input vectors of the positive and negative partial sums
+     */
+    std::array<std::vector<input_vector_t>, 2> packedSobelVectors(const std::array<int16_t, 3 * 3> &kernelA) const;
+
+    /**
+     * @brief PE configurations of the packed Sobel run
+     *
+     * @details
+     * Both partial sums use the first configuration of the scalar run. The
+     * difference uses the second configuration with a saturating subtraction
+     * instead of the final addition, i.e. it calculates In3 - In4.
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @return PE configurations of the positive sum, negative sum and difference
+     */
+    std::array<std::vector<uint8_t>, 3> packedSobelPeConfigurations(const std::array<int16_t, 3 * 3> &kernelA) const;
+
+    /**
+     * @brief Store the gradients of all lanes of a packed result
+     *
+     * @param vectorA       Index of the input vector
+     * @param differencesA  Saturated differences of the partial sums (positive minus negative first)
+     * @param resultsA      Gradients of all pixels
+     */
+    static void storePackedSobelResults(std::size_t vectorA, const std::array<int16_t, 2> &differencesA,
+                                        std::array<int16_t, 64 * 64> &resultsA);
+
+    /**
+     * @brief Compare the packed Sobel run against a scalar reference
+     *
+     * @param kernelA   Sobel kernel of the direction
+     * @param resultsA  Results of the packed cycle-accurate simulation
+     * @return Number of pixels which differ from the scalar Sobel filter of the quantized image
+     */
+    std::size_t verifyPackedSobel(const std::array<int16_t, 3 * 3> &kernelA,
+                                  const std::array<int16_t, 64 * 64> &resultsA) const;
+#endif
+
+#ifdef STREAMING_VCGRA
+    /**
+     * @brief Stream input vectors and wait for all results
+     *
+     * @param vectorsA  Input vectors to send
+     * @return Value of data output 2 for each input vector
+     */
+    std::vector<int16_t> streamPass(const std::vector<input_vector_t> &vectorsA);
+
+    std::vector<int16_t> mStreamResults;
+    //!< @brief Results of the current pass
+    std::size_t mExpectedResults{0};
+    //!< @brief Number of results of the current pass
+    sc_core::sc_event mResultsComplete;
+    //!< @brief All results of the current pass were received
+    uint64_t mCycles{0};
+    //!< @brief Clock cycles since simulation start
+    uint64_t mLastResultCycle{0};
+    //!< @brief Clock cycle of the last received result
+    std::size_t mBackToBackResults{0};
+    //!< @brief Results which were received one clock cycle after their predecessor
+#endif
+
     std::string mImagePath;
     //!< @brief Stores the path to the local image to process
 
@@ -154,6 +314,13 @@ class Testbench : public sc_core::sc_module
     const std::array<int16_t, 3 * 3> sobely{1, 2, 1, 0, 0, 0, -1, -2, -1};
     //!< Sobel coefficients in y-direction
 
+#ifdef PE_IMMEDIATES
+    static constexpr std::size_t cPixelInput{0};
+#else
+    static constexpr std::size_t cPixelInput{1};
+#endif
+    //!< Data input 2 * i + cPixelInput holds the pixel of PE i, In1 if the coefficient is an immediate operand
+
     static constexpr uint8_t cInputSize{64};
     //!< Input image dimension
     std::array<uint16_t, cInputSize * cInputSize> mInputValues;
@@ -161,6 +328,21 @@ class Testbench : public sc_core::sc_module
 
     static constexpr uint8_t cOutputSize{64};
     //!< Output image dimension
+
+#ifdef PACKED_DATAPATH
+    static constexpr uint32_t cPackedPixelShift{8 + 2 - cgra::cPackedLaneBitwidth + (cgra::cPackedUnsignedLanes ? 0 : 1)};
+    //!< Pixels are quantized such that four pixels weighted with coefficients up to two fit into a lane
+#ifdef PACKED_UNSIGNED
+    static constexpr std::size_t cPackedDifferences{2};
+#else
+    static constexpr std::size_t cPackedDifferences{1};
+#endif
+    //!< Unsigned lanes clamp negative gradients to zero, thus both differences of the partial sums are calculated
+    static constexpr std::size_t cPackedVectors{((cInputSize - 2) * (cInputSize - 2) + cgra::cPackedLanes - 1) /
+                                                cgra::cPackedLanes};
+    //!< Number of input vectors of a packed Sobel direction
+#endif
+
     std::array<int16_t, cOutputSize * cOutputSize> mSobelxValues;
     //!< Output image values after sobel operation in x direction
     std::array<int16_t, cOutputSize * cOutputSize> mSobelyValues;
@@ -0,0 +1,168 @@
+/*
+ * testbench_vcgra_scaling.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef TESTBENCH_VCGRA_SCALING_H_
+#define TESTBENCH_VCGRA_SCALING_H_
+
+#include "VCGRA.h"
+#include "FunctionalVcgra.hpp"
+#include <systemc>
+#include <vector>
+#include <array>
+
+namespace cgra
+{
+
+/**
+ * @brief Testbench which measures the throughput of a VCGRA of any topology
+ *
+ * @details
+ * The VCGRA is configured once with the workload of WorkloadGenerator.hpp,
+ * which keeps all PEs busy. Afterwards, random input vectors are processed
+ * one after another with the start/ready protocol. All data outputs are
+ * compared against the functional model.
+ */
+class ScalingTestbench : public sc_core::sc_module
+{
+  public:
+    // Type definitions
+    typedef typename VCGRA::data_input_type_t data_input_type_t;
+    //!< \brief VCGRA data input type
+    typedef typename VCGRA::data_output_type_t data_output_type_t;
+    //!< \brief VCGRA data output type
+
+#ifndef GSYSC
+    // Entity ports
+    sc_core::sc_in<cgra::clock_type_t> clk{"clk"};
+    //!< \brief VCGRA clock port
+    sc_core::sc_out<cgra::start_type_t> start{"start"};
+    //!< \brief VCGRA start port
+    sc_core::sc_out<cgra::reset_type_t> rst{"rst"};
+    //!< \brief VCGRA reset port
+    sc_core::sc_out<cgra::pe_config_type_t> pe_config{"pe_config"};
+    //!< \brief VCGRA PE configuration port
+    sc_core::sc_out<cgra::ch_config_type_t> ch_config{"ch_config"};
+    //!< \brief VCGRA VirtualChannel configuration port
+    std::array<sc_core::sc_out<data_input_type_t>, cgra::cInputChannel_NumOfInputs> data_inputs;
+    //!< \brief VCGRA data inputs to first VirtualChannel level
+    sc_core::sc_in<cgra::ready_type_t> ready{"ready"};
+    //!< \brief VCGRA ready port
+    std::array<sc_core::sc_in<data_output_type_t>, cgra::cPeLevels.back()> data_outputs;
+    //!< \brief VCGRA data outputs
+#else
+    // Entity ports
+    sc_in<cgra::clock_type_t> clk{"clk"};
+    //!< \brief VCGRA clock port
+    sc_out<cgra::start_type_t> start{"start"};
+    //!< \brief VCGRA start port
+    sc_out<cgra::reset_type_t> rst{"rst"};
+    //!< \brief VCGRA reset port
+    sc_out<cgra::pe_config_type_t> pe_config{"pe_config"};
+    //!< \brief VCGRA PE configuration port
+    sc_out<cgra::ch_config_type_t> ch_config{"ch_config"};
+    //!< \brief VCGRA VirtualChannel configuration port
+    std::array<sc_out<data_input_type_t>, cgra::cInputChannel_NumOfInputs> data_inputs;
+    //!< \brief VCGRA data inputs to first VirtualChannel level
+    sc_in<cgra::ready_type_t> ready{"ready"};
+    //!< \brief VCGRA ready port
+    std::array<sc_in<data_output_type_t>, cgra::cPeLevels.back()> data_outputs;
+    //!< \brief VCGRA data outputs
+#endif
+
+    // Member functions
+    //-----------------
+
+    SC_HAS_PROCESS(ScalingTestbench);
+    /**
+     * @brief General construtor
+     *
+     * @param nameA         SystemC module name
+     * @param numVectorsA   Number of random input vectors to process
+     */
+    ScalingTestbench(const sc_core::sc_module_name &nameA, std::size_t numVectorsA);
+
+    // Deleted constructors
+    ScalingTestbench() = delete;
+    //!< @brief SystemC requires unique module name
+    ScalingTestbench(const ScalingTestbench &rhs) = delete;
+    //!< @brief sc_module cannot being copied
+    ScalingTestbench(ScalingTestbench &&rhs) = delete;
+    //!< @brief sc_module cannot being moved
+    ScalingTestbench &operator=(const ScalingTestbench &rhs) = delete;
+    //!< @brief sc_module cannot being copied
+    ScalingTestbench &operator=(ScalingTestbench &&rhs) = delete;
+    //!< @brief sc_module cannot being moved
+
+    /**
+     * @brief Destroy the ScalingTestbench object
+     */
+    ~ScalingTestbench() override = default;
+
+    /**
+     * @brief Print kind of SystemC module
+     */
+    const char *kind() const override
+    {
+        return "VCGRA Scaling Testbench";
+    }
+
+    /**
+     * @brief Return name of SystemC module
+     */
+    void print(::std::ostream &os = ::std::cout) const override
+    {
+        os << name();
+    }
+
+    /**
+     * @brief Process the stimulation of the VCGRA instance
+     */
+    void stimuli();
+
+    /**
+     * @brief Count clock cycles of the simulation
+     */
+    void countCycles();
+
+    /**
+     * @brief Initialize ports before starting simulation
+     */
+    void end_of_elaboration() override;
+
+    /**
+     * @brief Number of processed input vectors
+     */
+    std::size_t processedVectors() const { return mProcessedVectors; }
+
+    /**
+     * @brief Clock cycles from the first start to the last ready
+     */
+    uint64_t executionCycles() const { return mExecutionCycles; }
+
+    /**
+     * @brief Number of data outputs which differ from the functional model
+     */
+    std::size_t mismatches() const { return mMismatches; }
+
+  private:
+    typedef cgra::FunctionalVcgra::value_type_t value_type_t;
+    //!< @brief Value type of the functional model
+
+    std::size_t mNumVectors;
+    //!< @brief Number of random input vectors to process
+    std::size_t mProcessedVectors{0};
+    //!< @brief Number of input vectors which were processed so far
+    uint64_t mCycles{0};
+    //!< @brief Clock cycles since simulation start
+    uint64_t mExecutionCycles{0};
+    //!< @brief Clock cycles from the first start to the last ready
+    std::size_t mMismatches{0};
+    //!< @brief Data outputs which differ from the functional model
+};
+
+} // namespace cgra
+
+#endif // TESTBENCH_VCGRA_SCALING_H_
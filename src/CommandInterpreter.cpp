@@ -17,4 +17,17 @@ void CommandInterpreter::separate()
     this->address.write(this->assembler.read()(31,16));
 }
 
+CommandInterpreter::Instruction CommandInterpreter::predecode(const uint32_t assemblerA)
+{
+    Instruction t_instruction;
+
+    t_instruction.assembler = assemblerA;
+    t_instruction.command = static_cast<uint8_t>(assemblerA & 0x3F);
+    t_instruction.place = static_cast<uint8_t>((assemblerA >> 6) & 0x7F);
+    t_instruction.line = static_cast<uint8_t>((assemblerA >> 13) & 0x7);
+    t_instruction.address = static_cast<uint16_t>(assemblerA >> 16);
+
+    return t_instruction;
+}
+
 } // end namespace cgra
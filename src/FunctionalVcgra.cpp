@@ -0,0 +1,196 @@
+/*
+ * FunctionalVcgra.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FunctionalVcgra.hpp"
+#include "PeConfiguration.hpp"
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+namespace cgra
+{
+
+FunctionalVcgra::FunctionalVcgra(const std::vector<uint8_t>& peConfigA, const std::vector<uint8_t>& chConfigA)
+{
+    configure(peConfigA, chConfigA);
+}
+
+void FunctionalVcgra::configure(const std::vector<uint8_t>& peConfigA, const std::vector<uint8_t>& chConfigA)
+{
+    // Value vector: data inputs, results and immediate operands of all PEs and feedback registers
+    std::vector<bool> t_valid(cNumOfValues, false);
+    std::fill_n(t_valid.begin(), cNumOfInputs, true);
+    std::fill(t_valid.begin() + cNumOfInputs + cNumOfPe, t_valid.end(), true);
+
+    m_nodes.clear();
+    m_accumulators.fill(0);
+    m_constants.fill(0);
+    m_readsFeedback = false;
+
+    uint32_t t_firstPe{0};
+    for (uint32_t t_level = 0; cNumOfLevels > t_level; ++t_level) {
+        for (uint32_t t_pe = t_firstPe; t_firstPe + cPeLevels[t_level] > t_pe; ++t_pe) {
+
+            Node t_node{};
+            t_node.operation = static_cast<uint8_t>(
+                extractConfigField(peConfigA, cPeConfigBitWidth, t_pe * cPeConfigLvSize, cPeOperationBitwidth));
+            t_node.result = static_cast<uint16_t>(cNumOfInputs + t_pe);
+
+            for (uint32_t t_operand = 0; 2 > t_operand; ++t_operand) {
+                // Output of the VirtualChannel in front of the PE
+                const uint32_t t_output = 2 * (t_pe - t_firstPe) + t_operand;
+                uint32_t t_select{0};
+
+                if (0 == t_level) {
+                    t_select = extractConfigField(chConfigA, cVChConfigBitWidth, t_output * cInputChannel_MuxScltBitwidth,
+                                            cInputChannel_MuxScltBitwidth);
+                    if (cInputChannel_NumOfChannelInputs <= t_select) {
+                        throw std::invalid_argument("Input channel selects non-existing input " +
+                                                    std::to_string(t_select) + ".");
+                    }
+                    if (cInputChannel_NumOfInputs <= t_select) {
+                        // Feedback registers follow the data inputs
+                        t_select = cFeedbackStart + t_select - cInputChannel_NumOfInputs;
+                        m_readsFeedback = true;
+                    }
+                    t_node.operands[t_operand] = static_cast<uint16_t>(t_select);
+                }
+                else {
+                    const uint32_t t_channelStart = cInputChannelConfigBitwidth + (t_level - 1) * cChannelConfigBitwidth;
+                    const uint32_t t_previousFirstPe = t_firstPe - cPeLevels[t_level - 1];
+
+                    t_select = extractConfigField(chConfigA, cVChConfigBitWidth,
+                                            t_channelStart + t_output * cChannel_MuxScltBitwidth,
+                                            cChannel_MuxScltBitwidth);
+                    if (cPeLevels[t_level - 1] <= t_select) {
+                        throw std::invalid_argument("Channel " + std::to_string(t_level - 1) +
+                                                    " selects non-existing input " + std::to_string(t_select) + ".");
+                    }
+                    t_node.operands[t_operand] = static_cast<uint16_t>(cNumOfInputs + t_previousFirstPe + t_select);
+                }
+            }
+
+#ifdef PE_IMMEDIATES
+            // The immediate operand replaces In2
+            const uint32_t t_modeStart = t_pe * cPeConfigLvSize + cPeOperationBitwidth;
+            if (PeOperations::IMMEDIATE &
+                extractConfigField(peConfigA, cPeConfigBitWidth, t_modeStart, cPeModeBitwidth)) {
+                m_constants[t_pe] = static_cast<value_type_t>(extractConfigField(
+                    peConfigA, cPeConfigBitWidth, t_modeStart + cPeModeBitwidth, cPeImmediateBitwidth));
+                t_node.operands[1] = static_cast<uint16_t>(cNumOfInputs + cNumOfPe + t_pe);
+            }
+#endif
+
+            // A PE only produces a valid result for a known operation and two valid operands
+            if (PeOperations::NONE != t_node.operation && PeOperations::LAST >= t_node.operation &&
+                t_valid[t_node.operands[0]] && t_valid[t_node.operands[1]]) {
+                t_valid[t_node.result] = true;
+                m_nodes.push_back(t_node);
+            }
+        }
+        t_firstPe += cPeLevels[t_level];
+    }
+
+    // Last PE level drives the data outputs and the synchronizer
+    const uint32_t t_syncMask = extractConfigField(chConfigA, cVChConfigBitWidth, cSyncConfigStart, cNumOfOutputs);
+    m_ready = true;
+    for (uint32_t t_output = 0; cNumOfOutputs > t_output; ++t_output) {
+        m_outputs[t_output] = static_cast<uint16_t>(cNumOfInputs + cNumOfPe - cNumOfOutputs + t_output);
+        m_outputValid[t_output] = t_valid[m_outputs[t_output]];
+
+        // Mask bits are interpreted from the least significant bit (valid input 0)
+        if (!m_outputValid[t_output] && !((t_syncMask >> t_output) & 0x1U)) {
+            m_ready = false;
+        }
+    }
+}
+
+FunctionalVcgra::value_type_t FunctionalVcgra::execute(const uint8_t operationA, const value_type_t aA,
+                                                       const value_type_t bA)
+{
+    switch (operationA) {
+    case PeOperations::ADD:
+        return datapath_type_t::add(aA, bA);
+    case PeOperations::SUB:
+        return datapath_type_t::sub(aA, bA);
+    case PeOperations::MUL:
+        return datapath_type_t::mul(aA, bA);
+    case PeOperations::IDIV:
+        return datapath_type_t::idiv(aA, bA);
+    case PeOperations::MDL:
+        return datapath_type_t::mdl(aA, bA);
+    case PeOperations::GRE:
+        return datapath_type_t::gre(aA, bA);
+    case PeOperations::EQU:
+        return datapath_type_t::equ(aA, bA);
+    case PeOperations::BUF:
+        return datapath_type_t::buf(aA);
+    case PeOperations::ABS:
+        return datapath_type_t::abs(aA);
+    case PeOperations::MIN:
+        return datapath_type_t::min(aA, bA);
+    case PeOperations::SHL:
+        return datapath_type_t::shl(aA, bA);
+    case PeOperations::SHR:
+        return datapath_type_t::shr(aA, bA);
+    case PeOperations::SADD:
+        return datapath_type_t::sadd(aA, bA);
+    case PeOperations::SSUB:
+        return datapath_type_t::ssub(aA, bA);
+    default:
+        return 0;
+    }
+}
+
+void FunctionalVcgra::evaluate(const value_type_t* inputsA, value_type_t* outputsA)
+{
+    evaluateBatch(inputsA, outputsA, 1);
+}
+
+void FunctionalVcgra::evaluateBatch(const value_type_t* inputsA, value_type_t* outputsA,
+                                    const std::size_t numVectorsA)
+{
+    std::array<value_type_t, cNumOfValues> t_values{};
+    std::copy_n(m_constants.cbegin(), cNumOfConstants, t_values.begin() + cNumOfInputs + cNumOfPe);
+
+    for (std::size_t t_vector = 0; numVectorsA > t_vector; ++t_vector) {
+        std::copy_n(inputsA + t_vector * cNumOfInputs, cNumOfInputs, t_values.begin());
+        std::copy(m_feedback.cbegin(), m_feedback.cend(), t_values.begin() + cFeedbackStart);
+
+        for (const auto& node : m_nodes) {
+            if (PeOperations::MAC == node.operation) {
+                t_values[node.result] = accumulate(m_accumulators[node.result - cNumOfInputs],
+                                                   t_values[node.operands[0]], t_values[node.operands[1]]);
+            }
+            else {
+                t_values[node.result] =
+                    execute(node.operation, t_values[node.operands[0]], t_values[node.operands[1]]);
+            }
+        }
+
+        for (uint32_t t_output = 0; cNumOfOutputs > t_output; ++t_output) {
+            outputsA[t_vector * cNumOfOutputs + t_output] =
+                m_outputValid[t_output] ? t_values[m_outputs[t_output]] : value_type_t{0};
+        }
+        if (m_ready) {
+            storeFeedback(m_feedback, outputsA + t_vector * cNumOfOutputs, 1);
+        }
+    }
+}
+
+void FunctionalVcgra::dump(std::ostream& os) const
+{
+    os << "Functional VCGRA\t" << m_nodes.size() << " active PEs\n";
+    for (const auto& node : m_nodes) {
+        os << "PE " << std::setw(3) << node.result - cNumOfInputs << ": OP " << static_cast<uint32_t>(node.operation)
+           << " (" << node.operands[0] << ", " << node.operands[1] << ")\n";
+    }
+    os << "ready: " << (m_ready ? "yes" : "no") << std::endl;
+}
+
+} // namespace cgra
@@ -9,12 +9,13 @@
 #include <iomanip>
 #include <iostream>
 #include "MMU.h"
+#include "PeDatapath.h"
 
 namespace cgra {
 
 MMU::MMU(const sc_core::sc_module_name& nameA,
         std::initializer_list<uint16_t> cacheFeaturesA) :
-        sc_core::sc_module(nameA), pCurrentMemPtr(const_cast<memory_size_type_t*>(pMemStartPtr))
+        sc_core::sc_module(nameA)
 {
 
     //Initialize cache feature list; Check if the constructor parameter will have the correct size
@@ -35,11 +36,6 @@ MMU::MMU(const sc_core::sc_module_name& nameA,
     sensitive << clk.pos();
 }
 
-MMU::~MMU()
-{
-    free(pMemStartPtr);
-}
-
 void MMU::end_of_elaboration()
 {
     //Initialize output ports of MMU entity before simulator starts.
@@ -48,6 +44,9 @@ void MMU::end_of_elaboration()
     write_enable.write(false);
     data_value_out_stream.write(0);
     cache_place.write(0);
+#ifdef MMU_BURST_WIDTH
+    burst.write(false);
+#endif
 
 }
 
@@ -64,6 +63,13 @@ void MMU::state_machine()
                 pCurrentCache = static_cast<CACHE_TYPE>(cache_select.read().to_uint());
                 pAddress.write(address.read());
                 pPlaceIn.write(place.read().to_uint());
+#ifdef PARTIAL_RECONFIGURATION
+                pSegmentLength = segment.read().to_uint();
+#endif
+#ifdef COMPRESSED_CONFIG
+                pCompressed = compressed.read() &&
+                    (pCurrentCache == CACHE_TYPE::CONF_PE || pCurrentCache == CACHE_TYPE::CONF_CC);
+#endif
 
                 pState = STATES::DECODE;
             }
@@ -73,7 +79,24 @@ void MMU::state_machine()
         {
             if(127 == pPlaceIn.read().to_uint())
             {
+#ifdef COMPRESSED_CONFIG
+                //Only the compressed bytes of a cache line are streamed to the configuration cache
+                uint64_t tCompressedSize{0};
+                if (pCompressed)
+                {
+                    tCompressedSize = compressedConfigurationSize(pMemory, pAddress.read().to_uint(),
+                        pCacheFeatures.at(pCurrentCache).at(FEATURE_SELECT::LINESIZE));
+                    if (0 == tCompressedSize)
+                    {
+                        ready.write(true);
+                        SC_REPORT_WARNING("MMU Transmission Error", "Compressed configuration out of memory.");
+                        pState = STATES::AWAIT;
+                        break;
+                    }
+                }
+#endif
                 pBlockTransmission = true;
+#ifndef MMU_BURST_WIDTH
                 //Get cache line size in bits to calculate number of transmissions for whole data block.
                 uint16_t tCacheLineSize = pCacheFeatures.at(pCurrentCache).at(FEATURE_SELECT::LINESIZE)* 8U;
 
@@ -105,17 +128,85 @@ void MMU::state_machine()
                 else {
                     pNumOfTransmission = tCacheLineSize / tStreamDataWidth - 1;
                 }
+#ifdef COMPRESSED_CONFIG
+                if (pCompressed) {
+                    pNumOfTransmission = (tCompressedSize * 8 + tStreamDataWidth - 1) / tStreamDataWidth - 1;
+                }
+#endif
 
                 //Calculate address step width for block data transfers
                 pAddressStepSize = tStreamDataWidth / (8 * sizeof(memory_size_type_t));
+#ifdef PACKED_DATAPATH
+                //A packed data value is composed of cPackedLanes values in shared memory
+                if (pCurrentCache == CACHE_TYPE::DATA_INPUT || pCurrentCache == CACHE_TYPE::DATA_OUTPUT) {
+                    pAddressStepSize = cDataValueMemorySize;
+                }
+#endif
+#else
+                //A whole cache line is transferred in bursts of cBurstSize memory lines
+                pRemainingSize = pCacheFeatures.at(pCurrentCache).at(FEATURE_SELECT::LINESIZE);
+
+                switch (pCurrentCache)
+                {
+                    case CACHE_TYPE::DATA_INPUT:
+                    case CACHE_TYPE::DATA_OUTPUT:
+                        pPlaceStepSize = cgra::cMmuBurstWidth / cgra::cDataValueBitwidth;
+                        break;
+                    case CACHE_TYPE::CONF_PE:
+                    case CACHE_TYPE::CONF_CC:
+                        pPlaceStepSize = 1;
+                        break;
+                    default:
+                        pRemainingSize = 0;
+                        break;
+                }
+#ifdef COMPRESSED_CONFIG
+                if (pCompressed) {
+                    pRemainingSize = tCompressedSize;
+                }
+#endif
+
+                //Transmission needs to be one step smaller because of zero based counting
+                const uint16_t tNumOfBursts = (pRemainingSize + cBurstSize - 1) / cBurstSize;
+                pNumOfTransmission = (0 < tNumOfBursts) ? tNumOfBursts - 1 : 0;
+                pBlockTransmission = (0 < pNumOfTransmission);
+                burst.write(true);
+#endif
 
                 pState = STATES::PROCESS;
                 pPlaceOut.write(0);
             }
             else
             {
+#ifdef COMPRESSED_CONFIG
+                //Compressed configurations are streamed for whole cache lines only
+                if (pCompressed) {
+                    SC_REPORT_WARNING("MMU Transmission Error", "Compressed configurations need to be loaded as whole cache line.");
+                    pCompressed = false;
+                }
+#endif
                 pBlockTransmission = false;
                 pNumOfTransmission = 1;
+#ifdef MMU_BURST_WIDTH
+                //A single value or a single configuration burst
+                if (pCurrentCache == CACHE_TYPE::DATA_INPUT || pCurrentCache == CACHE_TYPE::DATA_OUTPUT) {
+                    pRemainingSize = cgra::cDataValueBitwidth / (8 * sizeof(memory_size_type_t));
+                }
+                else {
+                    pRemainingSize = cBurstSize;
+                }
+                pPlaceStepSize = 1;
+                burst.write(false);
+#endif
+#ifdef PARTIAL_RECONFIGURATION
+                //A configuration segment is transferred byte by byte like a block transmission
+                if ((pCurrentCache == CACHE_TYPE::CONF_PE || pCurrentCache == CACHE_TYPE::CONF_CC) && 1 < pSegmentLength)
+                {
+                    pBlockTransmission = true;
+                    pNumOfTransmission = pSegmentLength - 1;
+                    pAddressStepSize = cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t));
+                }
+#endif
 
                 pPlaceOut.write(pPlaceIn.read());
                 pState = STATES::VALIDATE;
@@ -143,6 +234,24 @@ void MMU::state_machine()
                     pState = STATES::AWAIT;
                 }
             }
+#ifdef PARTIAL_RECONFIGURATION
+            else if (pCurrentCache == CACHE_TYPE::CONF_PE || pCurrentCache == CACHE_TYPE::CONF_CC)
+            {
+                //The segment needs to be located completely within the configuration cache line
+                if(0 < pSegmentLength && pCacheFeatures.at(pCurrentCache).at(FEATURE_SELECT::LINESIZE) >=
+                        pPlaceOut.read().to_uint() + pSegmentLength)
+                {
+                    pState = STATES::PROCESS;
+                }
+                else
+                {
+                    pBlockTransmission = false;
+                    ready.write(true);
+                    SC_REPORT_WARNING("MMU Transmission Error", "Selected segment out of range at selected configuration cache.");
+                    pState = STATES::AWAIT;
+                }
+            }
+#endif
             else {
                 pState = STATES::PROCESS;
             }
@@ -151,6 +260,25 @@ void MMU::state_machine()
         }
         case STATES::PROCESS:
         {
+#ifdef MMU_BURST_WIDTH
+            /*
+             * Configuration bursts are right-aligned within the data stream. Thus, the first
+             * burst of a configuration cache line carries the remainder of LINESIZE / cBurstSize.
+             */
+#ifdef COMPRESSED_CONFIG
+            //Compressed bursts are left-aligned, only the last burst is padded
+            if (pCompressed) {
+                pBurstLength = (cBurstSize < pRemainingSize) ? cBurstSize : pRemainingSize;
+            }
+            else
+#endif
+            if (pCurrentCache == CACHE_TYPE::CONF_PE || pCurrentCache == CACHE_TYPE::CONF_CC) {
+                pBurstLength = (0 < pRemainingSize) ? (pRemainingSize - 1) % cBurstSize + 1 : 0;
+            }
+            else {
+                pBurstLength = (cBurstSize < pRemainingSize) ? cBurstSize : pRemainingSize;
+            }
+#endif
             switch (pCurrentCache)
             {
                 case CACHE_TYPE::DATA_OUTPUT:
@@ -186,6 +314,12 @@ void MMU::state_machine()
                     break;
                 case CACHE_TYPE::CONF_CC:
                 case CACHE_TYPE::CONF_PE:
+#ifdef COMPRESSED_CONFIG
+                    if (pCompressed) {
+                        process_compressed_configuration();
+                        break;
+                    }
+#endif
                     process_configuration();
                     break;
                 default:
@@ -247,13 +381,28 @@ void MMU::state_machine()
         }
         case STATES::BLOCK:
         {
-            uint16_t tAddress = pAddress.read().to_uint() + pAddressStepSize;
+#ifndef MMU_BURST_WIDTH
+            uint32_t tAddress = pAddress.read().to_uint() + pAddressStepSize;
+#else
+            uint32_t tAddress = pAddress.read().to_uint() + pBurstLength;
+#ifdef PACKED_DATAPATH
+            //A packed data value is composed of cPackedLanes values in shared memory
+            if (pCurrentCache == CACHE_TYPE::DATA_INPUT || pCurrentCache == CACHE_TYPE::DATA_OUTPUT) {
+                tAddress = pAddress.read().to_uint() + pBurstLength * cgra::cPackedLanes;
+            }
+#endif
+            pRemainingSize -= pBurstLength;
+#endif
             pAddress.write(tAddress);
             if(!(--pNumOfTransmission)) {
                 pBlockTransmission = false;
             }
 
+#ifndef MMU_BURST_WIDTH
             uint16_t tPlace = static_cast<uint16_t>(pPlaceOut.read().to_uint()) + 1;
+#else
+            uint16_t tPlace = static_cast<uint16_t>(pPlaceOut.read().to_uint()) + pPlaceStepSize;
+#endif
             pPlaceOut.write(tPlace);
             pState = STATES::PROCESS;
             break;
@@ -283,35 +432,61 @@ void MMU::state_machine()
 
 void MMU::process_data_input()
 {
-
-    if(pAddress.read().to_uint() + (cgra::cDataValueBitwidth/(8 * sizeof(memory_size_type_t))) >= cgra::cMemorySize) {
+#ifdef MMU_BURST_WIDTH
+    if(uint64_t{pAddress.read().to_uint()} + pBurstLength / cDataValueSize * cDataValueMemorySize >= cgra::cMemorySize) {
         SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
     }
     else
     {
-        //Temporary variable for data to write to data stream
-        sc_dt::int_type tvalue{0};
+        //Value n of the burst is placed at bits (n + 1) * cDataValueBitwidth - 1 downto n * cDataValueBitwidth
+        data_stream_type_t tstream{0};
 
-        pCurrentMemPtr = pMemStartPtr + pAddress.read().to_uint();
-        /*
-         * Hint to magic number 8: Sizeof returns the size of a data type in number of bytes.
-         * The bitwidth of a data connections is set in number of bits. Thus, a previous devision by
-         * 8 calculates a data path size in the number of bytes.
-         */
-        memcpy(&tvalue, pCurrentMemPtr, (cgra::cDataValueBitwidth / (8 * sizeof(memory_size_type_t))));
-        data_value_out_stream.write(tvalue);
+        const uint64_t tAddress{pAddress.read().to_uint()};
+        for (uint16_t idx = 0; pBurstLength / cDataValueSize > idx; ++idx)
+        {
+            tstream.range((idx + 1) * cgra::cDataValueBitwidth - 1, idx * cgra::cDataValueBitwidth) =
+                load_data_value(tAddress + idx * cDataValueMemorySize);
+        }
+        data_value_out_stream.write(tstream);
     }
+#else
+    if(uint64_t{pAddress.read().to_uint()} + cDataValueMemorySize >= cgra::cMemorySize) {
+        SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
+    }
+    else
+    {
+        data_value_out_stream.write(load_data_value(pAddress.read().to_uint()));
+    }
+#endif
 }
 
 void MMU::process_configuration()
 {
+#ifdef MMU_BURST_WIDTH
+    if(uint64_t{pAddress.read().to_uint()} + pBurstLength >= cgra::cMemorySize){
+        SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
+    }
+    else
+    {
+        //The first memory line is the most significant byte of the right-aligned burst
+        conf_stream_type_t tstream{0};
+
+        const uint64_t tAddress{pAddress.read().to_uint()};
+        for (uint16_t idx = 0; pBurstLength > idx; ++idx)
+        {
+            const uint16_t tLsb = (pBurstLength - 1 - idx) * 8 * sizeof(memory_size_type_t);
+            tstream.range(tLsb + 8 * sizeof(memory_size_type_t) - 1, tLsb) = pMemory[tAddress + idx];
+        }
+        conf_cache_stream.write(tstream);
+    }
+#else
 
     /*
      * Hint to magic number 8: Sizeof returns the size of a data type in number of bytes.
      * The bitwidth of a data connections is set in number of bits. Thus, a previous devision by
      * 8 calculates a data path size in the number of bytes.
      */
-    if(pAddress.read().to_uint() + (cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t))) >= cgra::cMemorySize){
+    if(uint64_t{pAddress.read().to_uint()} + (cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t))) >= cgra::cMemorySize){
         SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
     }
     else
@@ -319,16 +494,47 @@ void MMU::process_configuration()
         //Temporary variable for data to write to data stream
         sc_dt::int_type tvalue{0};
 
-        pCurrentMemPtr = pMemStartPtr + pAddress.read().to_uint();
         /*
          * Hint to magic number 8: Sizeof returns the size of a data type in number of bytes.
          * The bitwidth of a data connections is set in number of bits. Thus, a previous devision by
          * 8 calculates a data path size in the number of bytes.
          */
-        memcpy(&tvalue, pCurrentMemPtr, (cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t))));
+        pMemory.read(pAddress.read().to_uint(), &tvalue, (cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t))));
         conf_cache_stream.write(tvalue);
     }
+#endif
+}
+
+#ifdef COMPRESSED_CONFIG
+void MMU::process_compressed_configuration()
+{
+#ifdef MMU_BURST_WIDTH
+    const uint16_t tNumOfBytes{pBurstLength};
+#else
+    const uint16_t tNumOfBytes{1};
+#endif
+    const uint16_t tStreamBytes{cgra::cDataStreamBitWidthConfCaches / (8 * sizeof(memory_size_type_t))};
+
+    if(uint64_t{pAddress.read().to_uint()} + tNumOfBytes > cgra::cMemorySize) {
+        SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
+    }
+    else
+    {
+        //The first compressed byte is the most significant byte of the stream, the rest is padded with no-operations
+        conf_stream_type_t tstream{0};
+
+        const uint64_t tAddress{pAddress.read().to_uint()};
+        for (uint16_t idx = 0; tStreamBytes > idx; ++idx)
+        {
+            const uint16_t tLsb = (tStreamBytes - 1 - idx) * 8 * sizeof(memory_size_type_t);
+            tstream.range(tLsb + 8 * sizeof(memory_size_type_t) - 1, tLsb) =
+                (tNumOfBytes > idx) ? pMemory[tAddress + idx] : cgra::cCompressionNoOp;
+        }
+        conf_cache_stream.write(tstream);
+        pCompressedBytes += tNumOfBytes;
+    }
 }
+#endif
 
 void MMU::dump(std::ostream& os) const
 {
@@ -357,28 +563,92 @@ void MMU::dump(std::ostream& os) const
             break;
     }
     os << "Current Address:\t\t" << std::setw(3) << address.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+    os << "Allocated memory pages:\t\t" << std::setw(3) << pMemory.allocatedPages() << std::endl;
     os << "Selected place:\t\t\t" << std::setw(3) << place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#ifdef PARTIAL_RECONFIGURATION
+    os << "Selected segment length:\t" << std::setw(3) << segment.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#endif
     os << "Data value in stream:\t\t" << std::setw(3) << data_value_in_stream.read().to_string(sc_dt::SC_HEX) << std::endl;
     os << "Data value out stream:\t\t" << std::setw(3) << data_value_out_stream.read().to_string(sc_dt::SC_HEX) << std::endl;
     os << "config. cache stream:\t\t" << std::setw(3) << conf_cache_stream.read().to_string(sc_dt::SC_HEX) << std::endl;
     os << "Current place:\t\t\t" << std::setw(3) << cache_place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#ifdef COMPRESSED_CONFIG
+    os << "Compressed config. bytes read:\t" << pCompressedBytes << std::endl;
+#endif
 }
 
 void MMU::process_data_output()
 {
+#ifdef MMU_BURST_WIDTH
+    if(uint64_t{pAddress.read().to_uint()} + pBurstLength / cDataValueSize * cDataValueMemorySize >= cgra::cMemorySize) {
+        SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
+    }
+    else
+    {
+        const data_stream_type_t tstream = data_value_in_stream.read();
+
+        const uint64_t tAddress{pAddress.read().to_uint()};
+        for (uint16_t idx = 0; pBurstLength / cDataValueSize > idx; ++idx)
+        {
+            store_data_value(tAddress + idx * cDataValueMemorySize,
+                tstream.range((idx + 1) * cgra::cDataValueBitwidth - 1, idx * cgra::cDataValueBitwidth).to_int());
+        }
+    }
+#else
 
-    if(pAddress.read().to_uint() + (cgra::cDataValueBitwidth/(8 * sizeof(memory_size_type_t))) >= cgra::cMemorySize) {
+    if(uint64_t{pAddress.read().to_uint()} + cDataValueMemorySize >= cgra::cMemorySize) {
         SC_REPORT_WARNING("MMU Transmission Error", "Addressed value out of memory.");
     }
     else
     {
-        //Temporary variable for data to read from data stream
-        sc_dt::int_type tvalue{0};
+        store_data_value(pAddress.read().to_uint(), data_value_in_stream.read().to_int());
+    }
+#endif
+}
+
+sc_dt::int_type MMU::load_data_value(const uint64_t addressA) const
+{
+    //Temporary variable for data to write to data stream
+    sc_dt::int_type tvalue{0};
 
-        pCurrentMemPtr = pMemStartPtr + pAddress.read().to_uint();
-        tvalue = data_value_in_stream.read().to_int();
-        memcpy(pCurrentMemPtr, &tvalue, (cgra::cDataValueBitwidth / (8 * sizeof(memory_size_type_t))));
+#ifdef PACKED_DATAPATH
+    //Lane l is the l-th value in memory saturated to the range of a lane
+    for (uint16_t tlane = 0; cgra::cPackedLanes > tlane; ++tlane)
+    {
+        sc_dt::int_type tlaneValue{0};
+        pMemory.read(addressA + tlane * cDataValueSize, &tlaneValue, cDataValueSize);
+        tlaneValue = cgra::wrap_to_bitwidth<cgra::cDataValueBitwidth>(tlaneValue);
+        tlaneValue = cgra::cPackedUnsignedLanes
+            ? cgra::saturate_to_unsigned_bitwidth<cgra::cPackedLaneBitwidth>(tlaneValue)
+            : cgra::saturate_to_bitwidth<cgra::cPackedLaneBitwidth>(tlaneValue);
+        tvalue |= (tlaneValue & ((1LL << cgra::cPackedLaneBitwidth) - 1)) << (tlane * cgra::cPackedLaneBitwidth);
     }
+#else
+    /*
+     * Hint to magic number 8: Sizeof returns the size of a data type in number of bytes.
+     * The bitwidth of a data connections is set in number of bits. Thus, a previous devision by
+     * 8 calculates a data path size in the number of bytes.
+     */
+    pMemory.read(addressA, &tvalue, cDataValueSize);
+#endif
+
+    return tvalue;
+}
+
+void MMU::store_data_value(const uint64_t addressA, const sc_dt::int_type valueA)
+{
+#ifdef PACKED_DATAPATH
+    //Lane l is sign (zero) extended and stored as the l-th value in memory
+    for (uint16_t tlane = 0; cgra::cPackedLanes > tlane; ++tlane)
+    {
+        const sc_dt::int_type tlaneValue = cgra::cPackedUnsignedLanes
+            ? (valueA >> (tlane * cgra::cPackedLaneBitwidth)) & ((1LL << cgra::cPackedLaneBitwidth) - 1)
+            : cgra::wrap_to_bitwidth<cgra::cPackedLaneBitwidth>(valueA >> (tlane * cgra::cPackedLaneBitwidth));
+        pMemory.write(addressA + tlane * cDataValueSize, &tlaneValue, cDataValueSize);
+    }
+#else
+    pMemory.write(addressA, &valueA, cDataValueSize);
+#endif
 }
 
 } /* End namespace cgra */
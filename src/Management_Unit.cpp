@@ -1,6 +1,7 @@
 #include "Management_Unit.h"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 namespace cgra {
 
@@ -33,8 +34,8 @@ static std::string integer2binaryCstr(const uint32_t numberA)
 ManagementUnit::ManagementUnit(const sc_core::sc_module_name& nameA,
         CommandInterpreter::assembler_type_t* const program_assemblyA,
         const uint64_t sizeA)
-    : sc_core::sc_module(nameA), m_programPointer(&m_programMemory.front()),
-       m_activeState(ACTIVE_STATE::STOP), m_current_state(STATE::NOOP)
+    : sc_core::sc_module(nameA), m_programPointer(0), m_currentInstruction(CommandInterpreter::predecode(0)),
+       m_activeState(ACTIVE_STATE::STOP), m_current_state(STATE::NOOP), m_returnState(STATE::ADAPT_PP)
 #ifdef MCPAT
     , m_totalCycles{0}, m_busyCycles{0}, m_idleCycles{0}
 #endif
@@ -58,12 +59,14 @@ ManagementUnit::ManagementUnit(const sc_core::sc_module_name& nameA,
     sensitive << mmu_ready.neg();
     dont_initialize();
 
-    //Wire signal connections
+#ifndef PREDECODED_INSTRUCTIONS
+    //Wire signal connections to trace the fields of fetched commands
     m_cInterpreter.assembler.bind(m_currentAssembler);
     m_cInterpreter.command.bind(m_currentCommand);
     m_cInterpreter.address.bind(m_currentAddress);
     m_cInterpreter.line.bind(m_currentLine);
     m_cInterpreter.place.bind(m_currentPlace);
+#endif
 
     //Store Assembler commands form source in program memory
     uint64_t t_size;
@@ -77,8 +80,32 @@ ManagementUnit::ManagementUnit(const sc_core::sc_module_name& nameA,
     else
         t_size = sizeA;
 
+    m_programMemory.reserve(t_size);
+    for(uint64_t i = 0; t_size > i; ++i)
+        m_programMemory.push_back(CommandInterpreter::predecode((program_assemblyA + i)->to_uint()));
+
+    return;
+}
+
+void ManagementUnit::load_program(const uint32_t* programA, const uint64_t sizeA)
+{
+    uint64_t t_size;
+
+    //Limit program size to program memory.
+    if(sizeA > cgra::cProgramMemorySize)
+    {
+        t_size = cgra::cProgramMemorySize;
+        SC_REPORT_WARNING("ManagementUnit", "Program size exceeds program memory.");
+    }
+    else
+        t_size = sizeA;
+
+    m_programMemory.clear();
+    m_programMemory.reserve(t_size);
     for(uint64_t i = 0; t_size > i; ++i)
-        m_programMemory.at(i) = *(program_assemblyA + i);
+        m_programMemory.push_back(CommandInterpreter::predecode(*(programA + i)));
+
+    m_programPointer = 0;
 
     return;
 }
@@ -145,12 +172,20 @@ void ManagementUnit::state_machine()
                 break;
             case STATE::CONT_MMU:
                 start_mmu();
-                m_current_state = STATE::ADAPT_PP;
+                m_current_state = m_returnState;
+                break;
+            case STATE::SWAP_LINES:
+                swap_lines();
+                break;
+            case STATE::PREFETCH:
+                prefetch();
                 break;
             case STATE::LOADD:
             case STATE::LOADDA:
             case STATE::LOADPC:
             case STATE::LOADCC:
+            case STATE::LOADPCZ:
+            case STATE::LOADCCZ:
             case STATE::STORED:
             case STATE::STOREDA:
                 start_mmu();
@@ -186,8 +221,15 @@ void ManagementUnit::state_machine()
 
 void ManagementUnit::fetch()
 {
-    //Load current assembler command to decode module
-    m_currentAssembler.write(*m_programPointer);
+    //Load current assembler command to decode module.
+    //Program memory outside of the stored program contains zeros.
+    if(m_programMemory.size() > m_programPointer)
+        m_currentInstruction = m_programMemory[m_programPointer];
+    else
+        m_currentInstruction = CommandInterpreter::predecode(0);
+#ifndef PREDECODED_INSTRUCTIONS
+    m_currentAssembler.write(m_currentInstruction.assembler);
+#endif
     m_current_state = STATE::DECODE;
 
     return;
@@ -195,64 +237,162 @@ void ManagementUnit::fetch()
 
 void ManagementUnit::decode()
 {
-    //Decode next command and update state machine state
-    m_current_state = static_cast<enum STATE>(m_currentCommand.read().to_uint());
+    //Decode next command and update state machine state.
+    //Command parts are already separated in program memory.
+    m_current_state = static_cast<enum STATE>(m_currentInstruction.command);
+
+    //Cache line within selected bank of cache lines
+    const uint32_t t_line = static_cast<uint32_t>(m_lineBank) << 3 | m_currentInstruction.line;
+
+#ifdef COMPRESSED_CONFIG
+    //Only LOADPCZ and LOADCCZ transfer compressed configurations
+    compressed.write(false);
+#endif
 
     //Update to address lines according to next command
     switch(m_current_state)
     {
     case STATE::LOADD:
         cache_select.write(MMU::CACHE_TYPE::DATA_INPUT);
-        dic_select_lines.first.write(m_cInterpreter.line.read().to_uint());
-        place.write(m_currentPlace);
+        dic_select_lines.first.write(t_line);
+        place.write(m_currentInstruction.place);
         break;
     case STATE::LOADDA:
         cache_select.write(MMU::CACHE_TYPE::DATA_INPUT);
-        dic_select_lines.first.write(m_cInterpreter.line.read().to_uint());
+        dic_select_lines.first.write(t_line);
         place.write(127);
         break;
     case STATE::SLCT_DIC_LINE:
-        dic_select_lines.second.write(m_cInterpreter.line.read().to_uint());
+        dic_select_lines.second.write(t_line);
         m_current_state = STATE::ADAPT_PP;
         break;
     case STATE::STORED:
         cache_select.write(MMU::CACHE_TYPE::DATA_OUTPUT);
-        doc_select_lines.second.write(m_cInterpreter.line.read().to_uint());
-        place.write(m_currentPlace);
+        doc_select_lines.second.write(t_line);
+        place.write(m_currentInstruction.place);
         break;
     case STATE::STOREDA:
         cache_select.write(MMU::CACHE_TYPE::DATA_OUTPUT);
-        doc_select_lines.second.write(m_cInterpreter.line.read().to_uint());
+        doc_select_lines.second.write(t_line);
         place.write(127);
         break;
     case STATE::SLCT_DOC_LINE:
-        doc_select_lines.first.write(m_cInterpreter.line.read().to_uint());
+        doc_select_lines.first.write(t_line);
         m_current_state = STATE::ADAPT_PP;
         break;
     case STATE::LOADPC:
         cache_select.write(MMU::CACHE_TYPE::CONF_PE);
-        pe_cc_select_lines.first.write(m_cInterpreter.line.read().to_uint());
-        place.write(m_currentPlace);
+        pe_cc_select_lines.first.write(t_line);
+        place.write(m_currentInstruction.place);
+#ifdef PARTIAL_RECONFIGURATION
+        segment.write(m_segmentLength);
+#endif
         break;
     case STATE::SLCT_PECC_LINE:
-        pe_cc_select_lines.second.write(m_cInterpreter.line.read().to_uint());
+        pe_cc_select_lines.second.write(t_line);
         m_current_state = STATE::ADAPT_PP;
         break;
     case STATE::LOADCC:
         cache_select.write(MMU::CACHE_TYPE::CONF_CC);
-        ch_cc_select_lines.first.write(m_cInterpreter.line.read().to_uint());
-        place.write(m_currentPlace);
+        ch_cc_select_lines.first.write(t_line);
+        place.write(m_currentInstruction.place);
+#ifdef PARTIAL_RECONFIGURATION
+        segment.write(m_segmentLength);
+#endif
         break;
     case STATE::SLCT_CHCC_LINE:
-        ch_cc_select_lines.second.write(m_cInterpreter.line.read().to_uint());
+        ch_cc_select_lines.second.write(t_line);
         m_current_state = STATE::ADAPT_PP;
         break;
+    case STATE::LOADPCZ:
+    case STATE::LOADCCZ:
+#ifdef COMPRESSED_CONFIG
+        if(STATE::LOADPCZ == m_current_state)
+        {
+            cache_select.write(MMU::CACHE_TYPE::CONF_PE);
+            pe_cc_select_lines.first.write(t_line);
+        }
+        else
+        {
+            cache_select.write(MMU::CACHE_TYPE::CONF_CC);
+            ch_cc_select_lines.first.write(t_line);
+        }
+        place.write(127);
+        compressed.write(true);
+#else
+        SC_REPORT_WARNING("MU", "Compressed configurations are not available. Command is ignored.");
+        cache_select.write(MMU::CACHE_TYPE::NONE);
+        m_current_state = STATE::ADAPT_PP;
+#endif
+        break;
+    case STATE::SET_LINE_BANK:
+    {
+        //The first line of a bank needs to be located within the largest cache
+        const uint32_t t_maxLines = std::max({cgra::cNumberOfPeCacheLines, cgra::cNumberOfVChCacheLines,
+                                              cgra::cNumberDataInCacheLines, cgra::cNumberDataOutCacheLines});
+        if(t_maxLines > (static_cast<uint32_t>(m_currentInstruction.address) << 3))
+            m_lineBank = m_currentInstruction.address;
+        else
+            SC_REPORT_WARNING("MU", "Cache line bank out of range. Command is ignored.");
+        m_current_state = STATE::ADAPT_PP;
+    }
+        break;
+    case STATE::SET_ADDR_HIGH:
+        //Upper address bits need to be located within the shared memory
+        if(cgra::cMemorySize > (static_cast<uint64_t>(m_currentInstruction.address) << 16))
+            m_addressHigh = m_currentInstruction.address;
+        else
+            SC_REPORT_WARNING("MU", "Address out of shared memory. Command is ignored.");
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    case STATE::SET_SEGMENT:
+#ifdef PARTIAL_RECONFIGURATION
+        //A segment is located within a cache line, which is addressed by the 7 bit place field
+        if(0 < m_currentInstruction.address && 127 > m_currentInstruction.address)
+            m_segmentLength = m_currentInstruction.address;
+        else
+            SC_REPORT_WARNING("MU", "Segment length out of range. Command is ignored.");
+#else
+        SC_REPORT_WARNING("MU", "Partial reconfiguration is not available. Command is ignored.");
+#endif
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    case STATE::SET_STREAM:
+        set_stream();
+        break;
+    case STATE::STOP_STREAM:
+        //Results of the last VCGRA run are stored before the streams are disabled
+        if(m_resultPending)
+        {
+            m_current_state = STATE::SWAP_LINES;
+        }
+        else
+            m_current_state = STATE::PREFETCH;
+        m_streamInput = false;
+        m_streamOutput = false;
+        m_loadPending = false;
+        break;
+    case STATE::START:
+        cache_select.write(MMU::CACHE_TYPE::NONE);
+        place.write(m_currentInstruction.place);
+        if(m_streamInput || m_streamOutput)
+            m_current_state = STATE::SWAP_LINES;
+        break;
+    case STATE::NOOP:
+    case STATE::WAIT_READY:
+    case STATE::FINISH:
+        cache_select.write(MMU::CACHE_TYPE::NONE);
+        place.write(m_currentInstruction.place);
+        break;
     default:
+        //Internal states of the state machine are no assembler commands
+        SC_REPORT_WARNING("MU", "Unknown command. Command is ignored.");
         cache_select.write(MMU::CACHE_TYPE::NONE);
-        place.write(m_currentPlace);
+        place.write(m_currentInstruction.place);
+        m_current_state = STATE::ADAPT_PP;
         break;
     }
-    address.write(m_currentAddress);
+    address.write(static_cast<uint32_t>(m_addressHigh) << 16 | m_currentInstruction.address);
 
     return;
 }
@@ -278,7 +418,14 @@ void ManagementUnit::start_state()
     else if(start.read())
     {
         start.write(false);
-        m_current_state = STATE::ADAPT_PP;
+        if(m_streamInput || m_streamOutput)
+        {
+            //Results of this run are stored by the next START or STOP_STREAM
+            m_resultPending = m_streamOutput;
+            m_current_state = STATE::PREFETCH;
+        }
+        else
+            m_current_state = STATE::ADAPT_PP;
     }
     /*There is no signal which shows that the VCGRA is currently in process.
     * The assembler needs to ensure that the VCGRA is started again only if the ready signal already occurred.
@@ -289,6 +436,106 @@ void ManagementUnit::start_state()
     return;
 }
 
+void ManagementUnit::set_stream()
+{
+    const uint32_t t_value = m_currentInstruction.address;
+    //Base addresses are located within the selected 64KiB region of shared memory
+    const uint32_t t_address = static_cast<uint32_t>(m_addressHigh) << 16 | t_value;
+
+    switch(m_currentInstruction.line)
+    {
+    case 0:
+        m_dicStreamBase = t_address;
+        m_dicStreamBlocks = 0;
+        m_streamInput = true;
+        m_loadPending = true;
+        m_current_state = STATE::PREFETCH;
+        break;
+    case 1:
+        m_dicStreamStride = t_value;
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    case 2:
+        m_docStreamBase = t_address;
+        m_docStreamBlocks = 0;
+        m_streamOutput = true;
+        m_resultPending = false;
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    case 3:
+        m_docStreamStride = t_value;
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    default:
+        SC_REPORT_WARNING("MU", "Unknown stream parameter. Command is ignored.");
+        m_current_state = STATE::ADAPT_PP;
+        break;
+    }
+
+    return;
+}
+
+void ManagementUnit::swap_lines()
+{
+    if(m_streamInput)
+    {
+        const auto t_line = dic_select_lines.first.read();
+        dic_select_lines.first.write(dic_select_lines.second.read());
+        dic_select_lines.second.write(t_line);
+        m_loadPending = true;
+    }
+
+    if(m_resultPending)
+    {
+        const auto t_line = doc_select_lines.first.read();
+        doc_select_lines.first.write(doc_select_lines.second.read());
+        doc_select_lines.second.write(t_line);
+        m_storePending = true;
+        m_resultPending = false;
+    }
+
+    //START continues with the VCGRA start, STOP_STREAM with the transmissions
+    if(STATE::START == m_currentInstruction.command)
+        m_current_state = STATE::START;
+    else
+        m_current_state = STATE::PREFETCH;
+
+    return;
+}
+
+void ManagementUnit::prefetch()
+{
+    if(m_storePending)
+    {
+        cache_select.write(MMU::CACHE_TYPE::DATA_OUTPUT);
+        address.write(m_docStreamBase + m_docStreamBlocks * m_docStreamStride);
+        place.write(127);
+        ++m_docStreamBlocks;
+        m_storePending = false;
+
+        m_returnState = STATE::PREFETCH;
+        m_current_state = STATE::STOREDA;
+    }
+    else if(m_loadPending)
+    {
+        cache_select.write(MMU::CACHE_TYPE::DATA_INPUT);
+        address.write(m_dicStreamBase + m_dicStreamBlocks * m_dicStreamStride);
+        place.write(127);
+        ++m_dicStreamBlocks;
+        m_loadPending = false;
+
+        m_returnState = STATE::PREFETCH;
+        m_current_state = STATE::LOADDA;
+    }
+    else
+    {
+        m_returnState = STATE::ADAPT_PP;
+        m_current_state = STATE::ADAPT_PP;
+    }
+
+    return;
+}
+
 void ManagementUnit::wait_ready()
 {
     //If former processing state is WAIT
@@ -312,9 +559,14 @@ void ManagementUnit::end_of_elaboration()
     mmu_start.write(false);
     address.write(0);
     place.write(0);
+#ifdef PARTIAL_RECONFIGURATION
+    segment.write(m_segmentLength);
+#endif
+#ifdef COMPRESSED_CONFIG
+    compressed.write(false);
+#endif
     finish.write(false);
     cache_select.write(MMU::CACHE_TYPE::NONE);
-    m_currentCommand.write(0);
 
     dic_select_lines.first.write(0);
     dic_select_lines.second.write(1);
@@ -337,7 +589,7 @@ void ManagementUnit::dump(std::ostream& os) const
     os << "Current MMU start status:\t" << std::setw(3) << std::boolalpha << mmu_start.read() << std::endl;
     os << "Current MMU ready status:\t" << std::setw(3) << std::boolalpha << mmu_ready.read() << std::endl;
     os << "Current RUN STATE:\t\t";
-    switch(static_cast<enum STATE>(m_currentCommand.read().to_uint()))
+    switch(static_cast<enum STATE>(m_currentInstruction.command))
     {
         case STATE::NOOP:
             os << "NOOP" << std::endl;
@@ -363,6 +615,12 @@ void ManagementUnit::dump(std::ostream& os) const
         case STATE::LOADPC:
             os << "Load processing element configuration cache" << std::endl;
             break;
+        case STATE::LOADCCZ:
+            os << "Load virtual channel configuration cache from compressed configuration" << std::endl;
+            break;
+        case STATE::LOADPCZ:
+            os << "Load processing element configuration cache from compressed configuration" << std::endl;
+            break;
         case STATE::START:
             os << "Start VCGRA processing" << std::endl;
             break;
@@ -393,12 +651,36 @@ void ManagementUnit::dump(std::ostream& os) const
         case STATE::SLCT_CHCC_LINE:
             os << "Select active virtual channel configuration cache outline." << std::endl;
             break;
+        case STATE::SET_STREAM:
+            os << "Set stream parameter of prefetch engine." << std::endl;
+            break;
+        case STATE::STOP_STREAM:
+            os << "Store pending results and stop prefetch engine." << std::endl;
+            break;
+        case STATE::SWAP_LINES:
+            os << "Swap active and inactive lines of streamed caches." << std::endl;
+            break;
+        case STATE::PREFETCH:
+            os << "Transmit pending blocks of prefetch engine." << std::endl;
+            break;
+        case STATE::SET_LINE_BANK:
+            os << "Select bank of cache lines." << std::endl;
+            break;
+        case STATE::SET_SEGMENT:
+            os << "Set length of partial configuration loads." << std::endl;
+            break;
+        case STATE::SET_ADDR_HIGH:
+            os << "Set upper bits of shared memory addresses." << std::endl;
+            break;
         default:
             os << "Unknown cache type." << std::endl;
             break;
     }
     os << "Current Address:\t\t" << std::setw(3) << address.read().to_string(sc_dt::SC_DEC, false) << std::endl;
     os << "Current place:\t\t\t" << std::setw(3) << place.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#ifdef PARTIAL_RECONFIGURATION
+    os << "Current segment length:\t\t" << std::setw(3) << segment.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+#endif
     os << "Current Cache:\t\t\t";
     switch(static_cast<MMU::CACHE_TYPE>(cache_select.read().to_uint()))
     {
@@ -508,7 +790,21 @@ void ManagementUnit::reset_interrupt()
 
     //Reset internal registers and program pointer
     m_current_state = STATE::NOOP;
-    m_programPointer = &m_programMemory.front();
+    m_returnState = STATE::ADAPT_PP;
+    m_programPointer = 0;
+
+    m_lineBank = 0;
+    m_segmentLength = 1;
+    m_addressHigh = 0;
+
+    //Disable prefetch engine
+    m_streamInput = false;
+    m_streamOutput = false;
+    m_loadPending = false;
+    m_storePending = false;
+    m_resultPending = false;
+    m_dicStreamStride = cDicStreamStride;
+    m_docStreamStride = cDocStreamStride;
 
     return;
 }
@@ -533,7 +829,7 @@ void ManagementUnit::show_finish_state()
     {
         m_activeState = ACTIVE_STATE::STOP;
         m_current_state = STATE::NOOP;
-        m_programPointer = m_programMemory.data();
+        m_programPointer = 0;
         finish.write(false);
     }
     else
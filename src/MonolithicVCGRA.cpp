@@ -0,0 +1,506 @@
+/*
+ * MonolithicVCGRA.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "MonolithicVCGRA.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace cgra {
+
+static_assert(cgra::cInputChannel_InputBitwidth == cgra::cPeDataBitwidth &&
+              cgra::cInputChannel_OutputBitwidth == cgra::cPeDataBitwidth &&
+              cgra::cChannel_InputBitwidth == cgra::cPeDataBitwidth &&
+              cgra::cChannel_OutputBitwidth == cgra::cPeDataBitwidth,
+              "MonolithicVCGRA routes PE values without changing their bitwidth");
+
+MonolithicVCGRA::MonolithicVCGRA(const sc_core::sc_module_name& nameA) :
+    sc_core::sc_module(nameA)
+{
+    uint32_t t_offset{0};
+    for (uint32_t t_level = 0; cgra::cNumOfLevels > t_level; ++t_level)
+    {
+        m_levelOffsets[t_level] = t_offset;
+        t_offset += cgra::cPeLevels[t_level];
+    }
+
+    SC_METHOD(update);
+    sensitive << clk.pos();
+    SC_METHOD(decode_pe_configuration);
+    sensitive << pe_config;
+    SC_METHOD(decode_ch_configuration);
+    sensitive << ch_config;
+
+    if (1 < cNumOfThreads)
+        m_threadPool.reset(new cgra::ThreadPool{cNumOfThreads});
+}
+
+void MonolithicVCGRA::end_of_elaboration()
+{
+    m_peConfigs.fill(0);
+    m_operations.fill(cgra::PeOperations::NONE);
+    m_immediateModes.fill(false);
+    m_immediates.fill(0);
+    m_operands.fill(0);
+    m_accumulators.fill(0);
+#ifdef PIPELINED_PE
+    m_sampled.fill(false);
+#else
+    m_states.fill(STATE::AWAIT_DATA);
+#endif
+    m_results.fill(0);
+    m_valids.fill(false);
+
+    m_current = 0;
+    for (uint32_t t_set = 0; 2 > t_set; ++t_set)
+    {
+        m_samples[t_set].fill(0);
+        m_sampledValids[t_set].fill(false);
+        m_channelOutputs[t_set].fill(0);
+        m_enables[t_set].fill(false);
+    }
+    for (uint32_t t_level = 0; cgra::cNumOfLevels > t_level; ++t_level)
+    {
+        //Select lines of a VirtualChannel are zero, i.e. its first input is routed
+        const uint32_t t_firstSample{0 == t_level ? 0
+            : cgra::cInputChannel_NumOfChannelInputs + m_levelOffsets[t_level - 1]};
+        std::fill_n(m_selects.begin() + 2 * m_levelOffsets[t_level], 2 * cgra::cPeLevels[t_level], t_firstSample);
+    }
+
+    m_syncMask.fill(false);
+#ifdef FEEDBACK_REGISTERS
+    m_feedback.fill(0);
+    m_sampledOutputs.fill(0);
+#endif
+
+    ready.write(true);
+    for(auto& out : data_outputs) {
+        out.write(0);
+    }
+}
+
+void MonolithicVCGRA::update()
+{
+    //Channels and Synchronizer also run at initialization, PEs only on clock edges
+    const bool t_edge{clk.posedge()};
+
+#ifdef MCPAT
+    ++m_totalCycles;
+#endif
+
+    //Synchronizer: valid signals of the last PE level ORed with the mask, which
+    //is applied from the first clock edge on
+    bool t_ready{true};
+    for (uint32_t i = 0; cgra::cPeLevels.back() > i; ++i)
+        t_ready = t_ready && (m_valids[cNumOfInnerPe + i] || (t_edge && m_syncMask[i]));
+#ifdef PIPELINED_PE
+    //ready marks one result vector per clock cycle, a fully masked configuration has none
+    t_ready = t_ready && !std::all_of(m_syncMask.cbegin(), m_syncMask.cend(), [](const bool maskA) { return maskA; });
+#endif
+    ready.write(t_ready);
+
+    //Channel phase: route the current samples and sample the current PE results
+    //into the next register set
+    const bool t_reset{!rst.read()};
+    sample_inputs(t_reset);
+    for_each_partition([this, t_reset](const uint32_t firstPeA, const uint32_t endPeA) {
+        update_channels(firstPeA, endPeA, t_reset);
+    });
+
+    //PE phase: PEs read the channel outputs of the previous clock edge
+#ifndef PIPELINED_PE
+    if (t_edge)
+#endif
+    {
+        for_each_partition([this](const uint32_t firstPeA, const uint32_t endPeA) {
+            update_pes(firstPeA, endPeA);
+        });
+        for (uint32_t i = 0; cgra::cPeLevels.back() > i; ++i)
+            data_outputs[i].write(m_results[cNumOfInnerPe + i]);
+    }
+    m_current ^= 1U;
+
+#ifdef FEEDBACK_REGISTERS
+    //ready and data outputs still hold their values of the previous clock edge
+    if (!rst.read())
+    {
+        m_feedback.fill(0);
+    }
+#ifdef PIPELINED_PE
+    else if (ready.read())
+#else
+    else if (ready.read() && !m_readyBefore)
+#endif
+    {
+        std::copy_backward(m_feedback.cbegin(), m_feedback.cend() - cgra::cPeLevels.back(), m_feedback.end());
+        std::copy(m_sampledOutputs.cbegin(), m_sampledOutputs.cend(), m_feedback.begin());
+#ifdef MCPAT
+        ++m_feedbackWrites;
+#endif
+    }
+    m_readyBefore = !rst.read() || ready.read();
+
+    for (uint32_t i = 0; cgra::cPeLevels.back() > i; ++i)
+        m_sampledOutputs[i] = data_outputs[i].read();
+#endif
+}
+
+template <typename F>
+void MonolithicVCGRA::for_each_partition(F&& phaseA)
+{
+    if (!m_threadPool)
+    {
+        phaseA(0U, cgra::cNumOfPe);
+        return;
+    }
+
+    m_threadPool->run([&phaseA](const uint32_t partitionA) {
+        const uint32_t t_size{(cgra::cNumOfPe + cNumOfThreads - 1) / cNumOfThreads};
+        const uint32_t t_first{partitionA * t_size};
+        if (cgra::cNumOfPe > t_first)
+            phaseA(t_first, (cgra::cNumOfPe - t_first > t_size) ? t_first + t_size : cgra::cNumOfPe);
+    });
+}
+
+void MonolithicVCGRA::update_pes(const uint32_t firstPeA, const uint32_t endPeA)
+{
+    const auto& t_enables = m_enables[m_current];
+    const auto& t_channelOutputs = m_channelOutputs[m_current];
+
+    for (uint32_t t_pe = firstPeA; endPeA > t_pe; ++t_pe)
+    {
+        const uint32_t t_in{2 * t_pe};
+        bool t_executed{false};
+
+#ifdef PIPELINED_PE
+        //EXECUTE stage
+#ifdef MCPAT
+        if (m_sampled[t_pe])
+            ++m_busyCycles[t_pe];
+        else
+            ++m_idleCycles[t_pe];
+#endif
+        if (m_sampled[t_pe])
+            t_executed = execute(t_pe);
+        m_valids[t_pe] = t_executed;
+
+        //SAMPLE stage
+        m_sampled[t_pe] = t_enables[t_in] && (t_enables[t_in + 1] || m_immediateModes[t_pe]);
+        if (m_sampled[t_pe])
+        {
+            m_operands[t_in] = pe_datapath_type_t::load(t_channelOutputs[t_in]);
+            m_operands[t_in + 1] = m_immediateModes[t_pe] ? m_immediates[t_pe]
+                : pe_datapath_type_t::load(t_channelOutputs[t_in + 1]);
+        }
+#else
+        switch (m_states[t_pe])
+        {
+        case STATE::AWAIT_DATA:
+#ifdef MCPAT
+            ++m_idleCycles[t_pe];
+#endif
+            m_valids[t_pe] = false;
+            if (t_enables[t_in] && (t_enables[t_in + 1] || m_immediateModes[t_pe]))
+                m_states[t_pe] = STATE::PROCESS_DATA;
+            break;
+
+        case STATE::PROCESS_DATA:
+#ifdef MCPAT
+            ++m_busyCycles[t_pe];
+#endif
+            t_executed = execute(t_pe);
+            m_states[t_pe] = t_executed ? STATE::VALID_DATA : STATE::AWAIT_DATA;
+            break;
+
+        case STATE::VALID_DATA:
+#ifdef MCPAT
+            ++m_busyCycles[t_pe];
+#endif
+            m_states[t_pe] = STATE::AWAIT_DATA;
+            m_valids[t_pe] = true;
+            break;
+        }
+
+        //Current inputs are the operands if the PE enters PROCESS_DATA
+        m_operands[t_in] = pe_datapath_type_t::load(t_channelOutputs[t_in]);
+        m_operands[t_in + 1] = m_immediateModes[t_pe] ? m_immediates[t_pe]
+            : pe_datapath_type_t::load(t_channelOutputs[t_in + 1]);
+#endif
+
+#ifdef MCPAT
+        if (t_executed)
+        {
+            if (cgra::PeOperations::usesMultiplier(m_operations[t_pe]))
+                ++m_mulAccesses[t_pe];
+            else
+                ++m_ialuAccesses[t_pe];
+        }
+#endif
+    }
+}
+
+bool MonolithicVCGRA::execute(const uint32_t peA)
+{
+    typedef pe_datapath_type_t D;
+    typedef cgra::PeOperations::OP OP;
+
+    const operand_type_t& t_in1 = m_operands[2 * peA];
+    const operand_type_t& t_in2 = m_operands[2 * peA + 1];
+    result_type_t t_result;
+
+    switch (m_operations[peA])
+    {
+    case OP::ADD:
+        t_result = D::add(t_in1, t_in2);
+        break;
+    case OP::SUB:
+        t_result = D::sub(t_in1, t_in2);
+        break;
+    case OP::MUL:
+        t_result = D::mul(t_in1, t_in2);
+        break;
+    case OP::IDIV:
+        t_result = D::idiv(t_in1, t_in2);
+        break;
+    case OP::MDL:
+        t_result = D::mdl(t_in1, t_in2);
+        break;
+    case OP::GRE:
+        t_result = D::gre(t_in1, t_in2);
+        break;
+    case OP::EQU:
+        t_result = D::equ(t_in1, t_in2);
+        break;
+    case OP::BUF:
+        t_result = D::buf(t_in1);
+        break;
+    case OP::MAC:
+        m_accumulators[peA] = D::mac(m_accumulators[peA], t_in1, t_in2);
+        t_result = m_accumulators[peA];
+        break;
+    case OP::ABS:
+        t_result = D::abs(t_in1);
+        break;
+    case OP::MIN:
+        t_result = D::min(t_in1, t_in2);
+        break;
+    case OP::SHL:
+        t_result = D::shl(t_in1, t_in2);
+        break;
+    case OP::SHR:
+        t_result = D::shr(t_in1, t_in2);
+        break;
+    case OP::SADD:
+        t_result = D::sadd(t_in1, t_in2);
+        break;
+    case OP::SSUB:
+        t_result = D::ssub(t_in1, t_in2);
+        break;
+    default:
+        return false;
+    }
+
+    m_results[peA] = D::store(t_result);
+
+    return true;
+}
+
+void MonolithicVCGRA::sample_inputs(const bool resetA)
+{
+    const uint32_t t_next{m_current ^ 1U};
+    const bool t_valid{!resetA && start.read()};
+
+    for (uint32_t i = 0; cgra::cInputChannel_NumOfInputs > i; ++i)
+    {
+        m_samples[t_next][i] = resetA ? data_input_type_t{0} : data_inputs[i].read();
+        m_sampledValids[t_next][i] = t_valid;
+    }
+#ifdef FEEDBACK_REGISTERS
+    //Feedback registers are valid at the start of an invocation like the data inputs
+    for (uint32_t i = 0; cgra::cNumOfFeedbackRegisters > i; ++i)
+    {
+        m_samples[t_next][cgra::cInputChannel_NumOfInputs + i] = resetA ? data_input_type_t{0} : m_feedback[i];
+        m_sampledValids[t_next][cgra::cInputChannel_NumOfInputs + i] = t_valid;
+    }
+#endif
+}
+
+void MonolithicVCGRA::update_channels(const uint32_t firstPeA, const uint32_t endPeA, const bool resetA)
+{
+    const uint32_t t_next{m_current ^ 1U};
+    const auto& t_samples = m_samples[m_current];
+    const auto& t_sampledValids = m_sampledValids[m_current];
+
+    //Route the inputs sampled on the previous clock edge
+    for (uint32_t t_out = 2 * firstPeA; 2 * endPeA > t_out; ++t_out)
+    {
+        m_channelOutputs[t_next][t_out] = t_samples[m_selects[t_out]];
+        m_enables[t_next][t_out] = t_sampledValids[m_selects[t_out]];
+    }
+
+    //Sample the results for the succeeding channel, a reset clears the input buffers
+    const uint32_t t_end{(cNumOfInnerPe < endPeA) ? cNumOfInnerPe : endPeA};
+    for (uint32_t t_pe = firstPeA; t_end > t_pe; ++t_pe)
+    {
+        const uint32_t t_sample{cgra::cInputChannel_NumOfChannelInputs + t_pe};
+        m_samples[t_next][t_sample] = resetA ? data_input_type_t{0} : m_results[t_pe];
+        m_sampledValids[t_next][t_sample] = !resetA && m_valids[t_pe];
+    }
+}
+
+void MonolithicVCGRA::decode_pe_configuration()
+{
+    constexpr uint32_t t_partBitwidth{cgra::cPeConfigLvSize};
+    const cgra::pe_config_type_t t_config{pe_config.read()};
+
+    for (uint32_t t_pe = 0; cgra::cNumOfPe > t_pe; ++t_pe)
+    {
+        const pe_config_part_type_t t_part{t_config.range(cgra::cPeConfigBitWidth - 1 - t_pe * t_partBitwidth,
+            cgra::cPeConfigBitWidth - (t_pe + 1) * t_partBitwidth)};
+        if (t_part == m_peConfigs[t_pe])
+            continue;
+
+        m_peConfigs[t_pe] = t_part;
+        m_operations[t_pe] = t_part.range(t_partBitwidth - 1, t_partBitwidth - cgra::cPeOperationBitwidth).to_uint();
+        if (cImmediates)
+        {
+            const uint32_t t_mode{t_part.range(cgra::cPeDataBitwidth + cgra::cPeModeBitwidth - 1,
+                cgra::cPeDataBitwidth).to_uint()};
+            data_input_type_t t_immediate;
+            t_immediate = t_part.range(cgra::cPeDataBitwidth - 1, 0).to_uint();
+
+            m_immediateModes[t_pe] = 0 != (t_mode & cgra::PeOperations::IMMEDIATE);
+            m_immediates[t_pe] = pe_datapath_type_t::load(t_immediate);
+        }
+        m_accumulators[t_pe] = 0;
+    }
+}
+
+void MonolithicVCGRA::decode_ch_configuration()
+{
+    const cgra::ch_config_type_t t_config{ch_config.read()};
+    //Fields are counted from the most significant bit like in the Selectors
+    auto t_field = [&t_config](const uint32_t offsetA, const uint32_t lengthA) -> uint32_t {
+        return t_config.range(cgra::cVChConfigBitWidth - 1 - offsetA, cgra::cVChConfigBitWidth - offsetA - lengthA).to_uint();
+    };
+
+    for (uint32_t t_out = 0; cgra::cInputChannel_NumOfOutputs > t_out; ++t_out)
+    {
+        m_selects[t_out] = t_field(t_out * cgra::cInputChannel_MuxScltBitwidth, cgra::cInputChannel_MuxScltBitwidth);
+        // Check, that selecting index is valid
+        sc_assert(m_selects[t_out] < cgra::cInputChannel_NumOfChannelInputs);
+    }
+
+    for (uint32_t t_level = 1; cgra::cNumOfLevels > t_level; ++t_level)
+    {
+        const uint32_t t_configStart{cgra::cInputChannelConfigBitwidth + (t_level - 1) * cgra::cChannelConfigBitwidth};
+        const uint32_t t_firstSample{cgra::cInputChannel_NumOfChannelInputs + m_levelOffsets[t_level - 1]};
+        for (uint32_t t_out = 0; 2U * cgra::cPeLevels[t_level] > t_out; ++t_out)
+        {
+            const uint32_t t_select{t_field(t_configStart + t_out * cgra::cChannel_MuxScltBitwidth,
+                                            cgra::cChannel_MuxScltBitwidth)};
+            // Check, that selecting index is valid
+            sc_assert(t_select < cgra::cChannel_NumOfInputs);
+            //Channels are sized for the largest PE levels, like in VCGRA
+            m_selects[2 * m_levelOffsets[t_level] + t_out] =
+                (cgra::cPeLevels[t_level - 1] > t_select) ? t_firstSample + t_select : cUnusedSample;
+        }
+    }
+
+    const uint32_t t_mask{t_field(cgra::cSyncConfigStart, cgra::cPeLevels.back())};
+    for (uint32_t i = 0; cgra::cPeLevels.back() > i; ++i)
+        m_syncMask[i] = 0 != ((t_mask >> i) & 0x1U);
+}
+
+#ifdef MCPAT
+void MonolithicVCGRA::dumpMcpatStatistics(std::ostream& os) const
+{
+    for (uint32_t t_pe = 0; cgra::cNumOfPe > t_pe; ++t_pe)
+    {
+#ifdef PIPELINED_PE
+        os << name() << ".VCGRA_PEs_" << t_pe << "\t\tPipelined Processing Element\tID: " << std::setw(3) << t_pe << "\n";
+#else
+        os << name() << ".VCGRA_PEs_" << t_pe << "\t\tProcessing Element\tID: " << std::setw(3) << t_pe << "\n";
+#endif
+        os << "total cycles: " << m_idleCycles[t_pe] + m_busyCycles[t_pe] << "\n";
+        os << "idle cycles: " << m_idleCycles[t_pe] << "\n";
+        os << "busy cycles: " << m_busyCycles[t_pe] << "\n";
+        os << "ialu accesses: " << m_ialuAccesses[t_pe] << "\n";
+        os << "mul accesses: " << m_mulAccesses[t_pe] << "\n";
+        os << std::endl;
+    }
+
+    //VirtualChannels and the Synchronizer are busy in every cycle
+    for (uint32_t t_level = 0; cgra::cNumOfLevels > t_level; ++t_level)
+    {
+        if (0 == t_level)
+            os << name() << ".Input_Channel\tVirtual Channel" << std::endl;
+        else
+            os << name() << ".VCGRA_Channels_" << t_level - 1 << "\tVirtual Channel" << std::endl;
+        os << "total cycles: " << m_totalCycles << "\n";
+        os << "idle cycles: " << 0U << "\n";
+        os << "busy cycles: " << m_totalCycles << "\n";
+        os << std::endl;
+    }
+
+    os << name() << ".VCGRA_Sync\t\tSynchronizer\n";
+    os << "total cycles: " << m_totalCycles << "\n";
+    os << "idle cycles: " << 0U << "\n";
+    os << "busy cycles: " << m_totalCycles << "\n";
+    os << std::endl;
+#ifdef FEEDBACK_REGISTERS
+    os << name() << ".VCGRA_Feedback\t\tFeedback Registers\n";
+    os << "total cycles: " << m_totalCycles << "\n";
+    os << "write accesses: " << m_feedbackWrites << "\n";
+    os << std::endl;
+#endif
+}
+#endif
+
+void MonolithicVCGRA::dump(::std::ostream & os) const
+{
+    os << this->name() << "\t\t\t" << this->kind() << std::endl;
+    os << "Reset signal status:\t\t\t" << std::setw(3) << std::boolalpha << rst.read() << std::endl;
+    os << "Start signal status:\t\t\t" << std::setw(3) << std::boolalpha << start.read() << std::endl;
+    os << "Ready signal status:\t\t\t" << std::setw(3) << std::boolalpha << ready.read() << std::endl;
+    os << "PE configuration status:\t\t" << pe_config.read().to_string(sc_dt::SC_HEX) << std::endl;
+    os << "CH configuration status:\t\t" << ch_config.read().to_string(sc_dt::SC_HEX) << std::endl;
+
+    os << "Inputs:" << std::endl;
+    for(auto& in : data_inputs) {
+        os << in.name() << ":\t\t" << in.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+    }
+    os << "Outputs:" << std::endl;
+    for(auto& out : data_outputs) {
+        os << out.name() << ":\t\t" << out.read().to_string(sc_dt::SC_DEC, false) << std::endl;
+    }
+
+    os << "PE status:\n";
+    os << "----------" << std::endl;
+    os << "PE\tOperation\tIn1 select\tIn2 select\tResult\tValid\n";
+    for (uint32_t t_pe = 0; cgra::cNumOfPe > t_pe; ++t_pe)
+    {
+        os << std::setw(3) << t_pe << "\t" << std::setw(6) << m_operations[t_pe] << "\t\t"
+           << std::setw(6) << m_selects[2 * t_pe] << "\t\t";
+        if (m_immediateModes[t_pe])
+            os << "#" << std::setw(5) << static_cast<int64_t>(m_immediates[t_pe]);
+        else
+            os << std::setw(6) << m_selects[2 * t_pe + 1];
+        os << "\t\t" << std::setw(6) << m_results[t_pe].to_int64() << "\t" << m_valids[t_pe] << "\n";
+    }
+    os << "Synchronizer mask:\t";
+    for (const auto t_bit : m_syncMask)
+        os << t_bit;
+    os << std::endl;
+#ifdef FEEDBACK_REGISTERS
+    os << "Feedback registers:\t";
+    for (const auto& t_value : m_feedback)
+        os << std::setw(7) << t_value.to_int64();
+    os << std::endl;
+#endif
+    os << std::endl;
+}
+
+} /* end namespace cgra */
@@ -0,0 +1,111 @@
+/*
+ * ProgramLoader.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "ProgramLoader.hpp"
+#include <fstream>
+#include <iterator>
+
+#if (defined(__unix__) || defined(__APPLE__)) && defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define PROGRAM_LOADER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cgra
+{
+
+ProgramLoader::~ProgramLoader()
+{
+    release();
+}
+
+void ProgramLoader::release()
+{
+#ifdef PROGRAM_LOADER_MMAP
+    if (nullptr != m_mapping) {
+        ::munmap(m_mapping, m_mappingLength);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mappingLength = 0;
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool ProgramLoader::load(const std::string& pathA)
+{
+    release();
+
+#ifdef PROGRAM_LOADER_MMAP
+    const int t_fd = ::open(pathA.c_str(), O_RDONLY);
+    if (0 > t_fd) {
+        return false;
+    }
+
+    struct stat t_stat;
+    if (0 != ::fstat(t_fd, &t_stat) || 0 != (t_stat.st_size % sizeof(uint32_t))) {
+        ::close(t_fd);
+        return false;
+    }
+
+    if (0 < t_stat.st_size) {
+        void* t_mapping = ::mmap(nullptr, static_cast<std::size_t>(t_stat.st_size), PROT_READ, MAP_PRIVATE, t_fd, 0);
+        if (MAP_FAILED != t_mapping) {
+            m_mapping = t_mapping;
+            m_mappingLength = static_cast<std::size_t>(t_stat.st_size);
+            m_data = static_cast<const uint32_t*>(m_mapping);
+            m_size = m_mappingLength / sizeof(uint32_t);
+            ::close(t_fd);
+            return true;
+        }
+    }
+    ::close(t_fd);
+#endif
+
+    // Fallback: read and convert the whole file
+    std::ifstream t_ifs{pathA, std::ios_base::in | std::ios_base::binary};
+    if (t_ifs.fail()) {
+        return false;
+    }
+
+    const std::vector<uint8_t> t_bytes{std::istreambuf_iterator<char>{t_ifs}, std::istreambuf_iterator<char>{}};
+    if (0 != (t_bytes.size() % sizeof(uint32_t))) {
+        return false;
+    }
+
+    m_buffer.resize(t_bytes.size() / sizeof(uint32_t));
+    for (std::size_t i = 0; m_buffer.size() > i; ++i) {
+        m_buffer[i] = static_cast<uint32_t>(t_bytes[4 * i]) | static_cast<uint32_t>(t_bytes[4 * i + 1]) << 8 |
+                      static_cast<uint32_t>(t_bytes[4 * i + 2]) << 16 | static_cast<uint32_t>(t_bytes[4 * i + 3]) << 24;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+
+    return true;
+}
+
+bool ProgramLoader::save(const std::string& pathA, const uint32_t* programA, const std::size_t sizeA)
+{
+    std::ofstream t_ofs{pathA, std::ios_base::out | std::ios_base::binary};
+    if (t_ofs.fail()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; sizeA > i; ++i) {
+        const char t_bytes[4] = {static_cast<char>(programA[i] & 0xFF), static_cast<char>((programA[i] >> 8) & 0xFF),
+                                 static_cast<char>((programA[i] >> 16) & 0xFF),
+                                 static_cast<char>((programA[i] >> 24) & 0xFF)};
+        t_ofs.write(t_bytes, sizeof(t_bytes));
+    }
+
+    return t_ofs.good();
+}
+
+} // namespace cgra
@@ -0,0 +1,414 @@
+/*
+ * SimdVcgra.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "SimdVcgra.hpp"
+#include <algorithm>
+#include <array>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+static_assert(16 == cgra::cPeDataBitwidth, "SIMD lanes require a PE data bitwidth of 16 bit");
+
+typedef cgra::FunctionalVcgra::value_type_t value_type_t;
+
+/*!
+ * \brief Scalar lanes: one input vector per step
+ */
+struct ScalarLanes
+{
+    typedef value_type_t reg_t;
+    static constexpr std::size_t cWidth{1};
+
+    static reg_t load(const value_type_t* srcA) { return *srcA; }
+    static void store(value_type_t* dstA, const reg_t valueA) { *dstA = valueA; }
+    static reg_t zero() { return 0; }
+    static reg_t broadcast(const value_type_t valueA) { return valueA; }
+
+    static reg_t apply(const uint8_t operationA, const reg_t aA, const reg_t bA)
+    {
+        return cgra::FunctionalVcgra::execute(operationA, aA, bA);
+    }
+};
+
+/*!
+ * \brief Apply an operation lane by lane for operations without SIMD instruction
+ */
+template <typename V>
+typename V::reg_t applyLanewise(const uint8_t operationA, const typename V::reg_t aA, const typename V::reg_t bA)
+{
+    alignas(sizeof(typename V::reg_t)) std::array<value_type_t, V::cWidth> t_a;
+    alignas(sizeof(typename V::reg_t)) std::array<value_type_t, V::cWidth> t_b;
+
+    V::store(t_a.data(), aA);
+    V::store(t_b.data(), bA);
+    for (std::size_t t_lane = 0; V::cWidth > t_lane; ++t_lane) {
+        t_a[t_lane] = cgra::FunctionalVcgra::execute(operationA, t_a[t_lane], t_b[t_lane]);
+    }
+
+    return V::load(t_a.data());
+}
+
+#ifdef __SSE2__
+/*!
+ * \brief SSE2 lanes: eight input vectors per step
+ */
+struct Sse2Lanes
+{
+    typedef __m128i reg_t;
+    static constexpr std::size_t cWidth{8};
+
+    static reg_t load(const value_type_t* srcA) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcA)); }
+    static void store(value_type_t* dstA, const reg_t valueA)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstA), valueA);
+    }
+    static reg_t zero() { return _mm_setzero_si128(); }
+    static reg_t broadcast(const value_type_t valueA) { return _mm_set1_epi16(valueA); }
+
+    static reg_t apply(const uint8_t operationA, const reg_t aA, const reg_t bA)
+    {
+#ifdef PACKED_DATAPATH
+        // Lanes of 8 bit use byte instructions, other lane bitwidths are calculated lane by lane
+        if (8 != cgra::cPackedLaneBitwidth) {
+            return (cgra::PeOperations::BUF == operationA) ? aA : applyLanewise<Sse2Lanes>(operationA, aA, bA);
+        }
+        if (cgra::cPackedUnsignedLanes) {
+            switch (operationA) {
+            case cgra::PeOperations::ADD:
+            case cgra::PeOperations::SADD:
+                return _mm_adds_epu8(aA, bA);
+            case cgra::PeOperations::SUB:
+            case cgra::PeOperations::SSUB:
+                return _mm_subs_epu8(aA, bA);
+            case cgra::PeOperations::GRE:
+                return _mm_max_epu8(aA, bA);
+            case cgra::PeOperations::EQU:
+                return _mm_and_si128(_mm_cmpeq_epi8(aA, bA), _mm_set1_epi8(1));
+            case cgra::PeOperations::BUF:
+            case cgra::PeOperations::ABS:
+                return aA;
+            case cgra::PeOperations::MIN:
+                return _mm_min_epu8(aA, bA);
+            default:
+                return applyLanewise<Sse2Lanes>(operationA, aA, bA);
+            }
+        }
+        switch (operationA) {
+        case cgra::PeOperations::ADD:
+            return _mm_add_epi8(aA, bA);
+        case cgra::PeOperations::SUB:
+            return _mm_sub_epi8(aA, bA);
+        case cgra::PeOperations::EQU:
+            return _mm_and_si128(_mm_cmpeq_epi8(aA, bA), _mm_set1_epi8(1));
+        case cgra::PeOperations::BUF:
+            return aA;
+        case cgra::PeOperations::SADD:
+            return _mm_adds_epi8(aA, bA);
+        case cgra::PeOperations::SSUB:
+            return _mm_subs_epi8(aA, bA);
+        default:
+            return applyLanewise<Sse2Lanes>(operationA, aA, bA);
+        }
+#else
+        switch (operationA) {
+        case cgra::PeOperations::ADD:
+            return _mm_add_epi16(aA, bA);
+        case cgra::PeOperations::SUB:
+            return _mm_sub_epi16(aA, bA);
+        case cgra::PeOperations::MUL:
+            return _mm_mullo_epi16(aA, bA);
+        case cgra::PeOperations::GRE:
+            return _mm_max_epi16(aA, bA);
+        case cgra::PeOperations::EQU:
+            return _mm_and_si128(_mm_cmpeq_epi16(aA, bA), _mm_set1_epi16(1));
+        case cgra::PeOperations::BUF:
+            return aA;
+        case cgra::PeOperations::ABS:
+            return _mm_max_epi16(aA, _mm_sub_epi16(_mm_setzero_si128(), aA));
+        case cgra::PeOperations::MIN:
+            return _mm_min_epi16(aA, bA);
+        case cgra::PeOperations::SADD:
+            return _mm_adds_epi16(aA, bA);
+        case cgra::PeOperations::SSUB:
+            return _mm_subs_epi16(aA, bA);
+        default:
+            return applyLanewise<Sse2Lanes>(operationA, aA, bA);
+        }
+#endif
+    }
+};
+#endif // __SSE2__
+
+#ifdef __AVX2__
+/*!
+ * \brief AVX2 lanes: sixteen input vectors per step
+ */
+struct Avx2Lanes
+{
+    typedef __m256i reg_t;
+    static constexpr std::size_t cWidth{16};
+
+    static reg_t load(const value_type_t* srcA) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(srcA)); }
+    static void store(value_type_t* dstA, const reg_t valueA)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstA), valueA);
+    }
+    static reg_t zero() { return _mm256_setzero_si256(); }
+    static reg_t broadcast(const value_type_t valueA) { return _mm256_set1_epi16(valueA); }
+
+    static reg_t apply(const uint8_t operationA, const reg_t aA, const reg_t bA)
+    {
+#ifdef PACKED_DATAPATH
+        // Lanes of 8 bit use byte instructions, other lane bitwidths are calculated lane by lane
+        if (8 != cgra::cPackedLaneBitwidth) {
+            return (cgra::PeOperations::BUF == operationA) ? aA : applyLanewise<Avx2Lanes>(operationA, aA, bA);
+        }
+        if (cgra::cPackedUnsignedLanes) {
+            switch (operationA) {
+            case cgra::PeOperations::ADD:
+            case cgra::PeOperations::SADD:
+                return _mm256_adds_epu8(aA, bA);
+            case cgra::PeOperations::SUB:
+            case cgra::PeOperations::SSUB:
+                return _mm256_subs_epu8(aA, bA);
+            case cgra::PeOperations::GRE:
+                return _mm256_max_epu8(aA, bA);
+            case cgra::PeOperations::EQU:
+                return _mm256_and_si256(_mm256_cmpeq_epi8(aA, bA), _mm256_set1_epi8(1));
+            case cgra::PeOperations::BUF:
+            case cgra::PeOperations::ABS:
+                return aA;
+            case cgra::PeOperations::MIN:
+                return _mm256_min_epu8(aA, bA);
+            default:
+                return applyLanewise<Avx2Lanes>(operationA, aA, bA);
+            }
+        }
+        switch (operationA) {
+        case cgra::PeOperations::ADD:
+            return _mm256_add_epi8(aA, bA);
+        case cgra::PeOperations::SUB:
+            return _mm256_sub_epi8(aA, bA);
+        case cgra::PeOperations::GRE:
+            return _mm256_max_epi8(aA, bA);
+        case cgra::PeOperations::EQU:
+            return _mm256_and_si256(_mm256_cmpeq_epi8(aA, bA), _mm256_set1_epi8(1));
+        case cgra::PeOperations::BUF:
+            return aA;
+        case cgra::PeOperations::ABS:
+            return _mm256_abs_epi8(aA);
+        case cgra::PeOperations::MIN:
+            return _mm256_min_epi8(aA, bA);
+        case cgra::PeOperations::SADD:
+            return _mm256_adds_epi8(aA, bA);
+        case cgra::PeOperations::SSUB:
+            return _mm256_subs_epi8(aA, bA);
+        default:
+            return applyLanewise<Avx2Lanes>(operationA, aA, bA);
+        }
+#else
+        switch (operationA) {
+        case cgra::PeOperations::ADD:
+            return _mm256_add_epi16(aA, bA);
+        case cgra::PeOperations::SUB:
+            return _mm256_sub_epi16(aA, bA);
+        case cgra::PeOperations::MUL:
+            return _mm256_mullo_epi16(aA, bA);
+        case cgra::PeOperations::GRE:
+            return _mm256_max_epi16(aA, bA);
+        case cgra::PeOperations::EQU:
+            return _mm256_and_si256(_mm256_cmpeq_epi16(aA, bA), _mm256_set1_epi16(1));
+        case cgra::PeOperations::BUF:
+            return aA;
+        case cgra::PeOperations::ABS:
+            return _mm256_abs_epi16(aA);
+        case cgra::PeOperations::MIN:
+            return _mm256_min_epi16(aA, bA);
+        case cgra::PeOperations::SADD:
+            return _mm256_adds_epi16(aA, bA);
+        case cgra::PeOperations::SSUB:
+            return _mm256_subs_epi16(aA, bA);
+        default:
+            return applyLanewise<Avx2Lanes>(operationA, aA, bA);
+        }
+#endif
+    }
+};
+#endif // __AVX2__
+
+/*!
+ * \brief Process input vectors in steps of V::cWidth vectors
+ *
+ * \param[in] nodesA        Dataflow graph
+ * \param[in] outputsIdxA   Value index of each data output or -1
+ * \param[in] constantsA    Immediate operands, indexed by PE
+ * \param[in] inputsA       Input values (structure of arrays)
+ * \param[out] outputsA     Output values (structure of arrays)
+ * \param[in] numVectorsA   Number of input vectors
+ * \param[in] firstA        First input vector to process
+ * \return First input vector which was not processed
+ */
+template <typename V>
+std::size_t processLanes(const std::vector<cgra::FunctionalVcgra::Node>& nodesA,
+                         const std::vector<int32_t>& outputsIdxA, const value_type_t* constantsA,
+                         const value_type_t* inputsA, value_type_t* outputsA, const std::size_t numVectorsA,
+                         std::size_t firstA)
+{
+    typename V::reg_t t_values[cgra::FunctionalVcgra::cNumOfValues];
+
+    for (uint32_t t_constant = 0; cgra::FunctionalVcgra::cNumOfConstants > t_constant; ++t_constant) {
+        t_values[cgra::FunctionalVcgra::cNumOfInputs + cgra::cNumOfPe + t_constant] =
+            V::broadcast(constantsA[t_constant]);
+    }
+
+    for (; numVectorsA >= firstA + V::cWidth; firstA += V::cWidth) {
+        for (uint32_t t_input = 0; cgra::FunctionalVcgra::cNumOfInputs > t_input; ++t_input) {
+            t_values[t_input] = V::load(inputsA + t_input * numVectorsA + firstA);
+        }
+
+        for (const auto& node : nodesA) {
+            t_values[node.result] =
+                V::apply(node.operation, t_values[node.operands[0]], t_values[node.operands[1]]);
+        }
+
+        for (uint32_t t_output = 0; cgra::FunctionalVcgra::cNumOfOutputs > t_output; ++t_output) {
+            V::store(outputsA + t_output * numVectorsA + firstA,
+                     (0 > outputsIdxA[t_output]) ? V::zero() : t_values[outputsIdxA[t_output]]);
+        }
+    }
+
+    return firstA;
+}
+
+/*!
+ * \brief Process input vectors one after another with MAC accumulators and feedback registers
+ *
+ * \param[in] nodesA            Dataflow graph
+ * \param[in] outputsIdxA       Value index of each data output or -1
+ * \param[in] constantsA        Immediate operands, indexed by PE
+ * \param[in] inputsA           Input values (structure of arrays)
+ * \param[out] outputsA         Output values (structure of arrays)
+ * \param[in] numVectorsA       Number of input vectors
+ * \param[in,out] accumulatorsA Accumulators of MAC operations, indexed by PE
+ * \param[in,out] feedbackA     Feedback registers
+ * \param[in] readyA            Results are stored in the feedback registers
+ */
+void processSequential(const std::vector<cgra::FunctionalVcgra::Node>& nodesA,
+                       const std::vector<int32_t>& outputsIdxA, const value_type_t* constantsA,
+                       const value_type_t* inputsA, value_type_t* outputsA, const std::size_t numVectorsA,
+                       value_type_t* accumulatorsA, cgra::FunctionalVcgra::feedback_registers_t& feedbackA,
+                       const bool readyA)
+{
+    value_type_t t_values[cgra::FunctionalVcgra::cNumOfValues];
+
+    std::copy_n(constantsA, cgra::FunctionalVcgra::cNumOfConstants,
+                t_values + cgra::FunctionalVcgra::cNumOfInputs + cgra::cNumOfPe);
+
+    for (std::size_t t_vector = 0; numVectorsA > t_vector; ++t_vector) {
+        for (uint32_t t_input = 0; cgra::FunctionalVcgra::cNumOfInputs > t_input; ++t_input) {
+            t_values[t_input] = inputsA[t_input * numVectorsA + t_vector];
+        }
+        std::copy(feedbackA.cbegin(), feedbackA.cend(), t_values + cgra::FunctionalVcgra::cFeedbackStart);
+
+        for (const auto& node : nodesA) {
+            if (cgra::PeOperations::MAC == node.operation) {
+                t_values[node.result] = cgra::FunctionalVcgra::accumulate(
+                    accumulatorsA[node.result - cgra::FunctionalVcgra::cNumOfInputs], t_values[node.operands[0]],
+                    t_values[node.operands[1]]);
+            }
+            else {
+                t_values[node.result] = cgra::FunctionalVcgra::execute(node.operation, t_values[node.operands[0]],
+                                                                       t_values[node.operands[1]]);
+            }
+        }
+
+        for (uint32_t t_output = 0; cgra::FunctionalVcgra::cNumOfOutputs > t_output; ++t_output) {
+            outputsA[t_output * numVectorsA + t_vector] =
+                (0 > outputsIdxA[t_output]) ? value_type_t{0} : t_values[outputsIdxA[t_output]];
+        }
+        if (readyA) {
+            cgra::FunctionalVcgra::storeFeedback(feedbackA, outputsA + t_vector, numVectorsA);
+        }
+    }
+}
+
+} // namespace
+
+namespace cgra
+{
+
+SimdVcgra::SimdVcgra(const FunctionalVcgra& modelA) :
+    m_nodes(modelA.nodes()), m_outputs(cNumOfOutputs, -1), m_constants(modelA.constants()),
+    m_ready(modelA.ready()), m_feedback(modelA.feedbackRegisters())
+{
+    m_sequential = modelA.readsFeedback() ||
+                   std::any_of(m_nodes.cbegin(), m_nodes.cend(),
+                               [](const FunctionalVcgra::Node& nodeA) { return PeOperations::MAC == nodeA.operation; });
+
+    for (uint32_t t_output = 0; cNumOfOutputs > t_output; ++t_output) {
+        if (modelA.outputValid(t_output)) {
+            m_outputs[t_output] = static_cast<int32_t>(cNumOfInputs + cNumOfPe - cNumOfOutputs + t_output);
+        }
+    }
+}
+
+void SimdVcgra::evaluateTile(const value_type_t* inputsA, value_type_t* outputsA, const std::size_t numVectorsA)
+{
+    // Accumulators depend on all previous input vectors
+    if (m_sequential) {
+        processSequential(m_nodes, m_outputs, m_constants.data(), inputsA, outputsA, numVectorsA,
+                          m_accumulators.data(), m_feedback, m_ready);
+        return;
+    }
+
+    std::size_t t_next{0};
+
+#ifdef __AVX2__
+    t_next = processLanes<Avx2Lanes>(m_nodes, m_outputs, m_constants.data(), inputsA, outputsA, numVectorsA, t_next);
+#endif
+#ifdef __SSE2__
+    t_next = processLanes<Sse2Lanes>(m_nodes, m_outputs, m_constants.data(), inputsA, outputsA, numVectorsA, t_next);
+#endif
+    processLanes<ScalarLanes>(m_nodes, m_outputs, m_constants.data(), inputsA, outputsA, numVectorsA, t_next);
+
+    // Feedback registers keep the results of the last input vectors
+    if (m_ready && 0 < FunctionalVcgra::cNumOfFeedbackRegisters) {
+        const std::size_t t_depth{FunctionalVcgra::cNumOfFeedbackRegisters / cNumOfOutputs};
+        for (std::size_t t_vector = (numVectorsA > t_depth) ? numVectorsA - t_depth : 0; numVectorsA > t_vector;
+             ++t_vector) {
+            FunctionalVcgra::storeFeedback(m_feedback, outputsA + t_vector, numVectorsA);
+        }
+    }
+}
+
+uint32_t SimdVcgra::laneWidth()
+{
+#if defined(__AVX2__)
+    return Avx2Lanes::cWidth;
+#elif defined(__SSE2__)
+    return Sse2Lanes::cWidth;
+#else
+    return ScalarLanes::cWidth;
+#endif
+}
+
+const char* SimdVcgra::instructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace cgra
@@ -0,0 +1,162 @@
+/*
+ * StreamingVCGRA.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "StreamingVCGRA.h"
+#include <algorithm>
+
+namespace cgra {
+
+StreamingVCGRA::StreamingVCGRA(const sc_core::sc_module_name& nameA) :
+    sc_core::sc_module(nameA)
+{
+    m_vcgra.clk.bind(clk);
+    m_vcgra.rst.bind(rst);
+    m_vcgra.pe_config.bind(pe_config);
+    m_vcgra.ch_config.bind(ch_config);
+    m_vcgra.start.bind(s_start);
+    m_vcgra.ready.bind(s_ready);
+
+#ifdef GSYSC
+    REG_PORT(&m_vcgra.clk,       &m_vcgra, &clk);
+    REG_PORT(&m_vcgra.rst,       &m_vcgra, &rst);
+    REG_PORT(&m_vcgra.pe_config, &m_vcgra, &pe_config);
+    REG_PORT(&m_vcgra.ch_config, &m_vcgra, &ch_config);
+    REG_PORT(&m_vcgra.start,     &m_vcgra, &s_start);
+    REG_PORT(&m_vcgra.ready,     &m_vcgra, &s_ready);
+    REG_MODULE(&m_vcgra, const_cast<char*>(m_vcgra.basename()), this);
+#endif
+
+    for(uint32_t i = 0; cNumOfInputs > i; ++i)
+    {
+        m_vcgra.data_inputs.at(i).bind(s_data_inputs.at(i));
+#ifdef GSYSC
+        REG_PORT(&m_vcgra.data_inputs.at(i), &m_vcgra, &s_data_inputs.at(i));
+#endif
+    }
+    for(uint32_t i = 0; cNumOfOutputs > i; ++i)
+    {
+        m_vcgra.data_outputs.at(i).bind(s_data_outputs.at(i));
+#ifdef GSYSC
+        REG_PORT(&m_vcgra.data_outputs.at(i), &m_vcgra, &s_data_outputs.at(i));
+#endif
+    }
+
+    SC_METHOD(stream);
+    sensitive << clk.pos();
+}
+
+void StreamingVCGRA::end_of_elaboration()
+{
+    m_lanes.fill(0);
+    m_sampledOutputs.fill(0);
+    reset();
+
+    for(auto& out : data_outputs) {
+        out.write(0);
+    }
+}
+
+void StreamingVCGRA::reset()
+{
+    m_laneFull.fill(false);
+    m_laneReady.fill(false);
+    m_outputBuffer.clear();
+    m_inFlight = 0;
+    m_cyclesSinceStart = cInitiationInterval;
+    m_outValid = false;
+
+    s_start.write(false);
+    for(auto& ready : in_readys) {
+        ready.write(false);
+    }
+    out_valid.write(false);
+}
+
+void StreamingVCGRA::stream()
+{
+    if(!rst.read())
+    {
+        reset();
+        return;
+    }
+
+    //Output handshake of the previous clock cycle
+    if(m_outValid && out_ready.read())
+        m_outputBuffer.pop_front();
+
+    //The Synchronizer raised ready at the previous clock edge for the outputs sampled at that edge
+    if(s_ready.read() && 0 < m_inFlight)
+    {
+        m_outputBuffer.push_back(m_sampledOutputs);
+        --m_inFlight;
+    }
+    for(uint32_t i = 0; cNumOfOutputs > i; ++i)
+        m_sampledOutputs[i] = s_data_outputs[i].read();
+
+    //Apply a complete input vector if its result has a place in the output buffer
+    if(cInitiationInterval > m_cyclesSinceStart)
+        ++m_cyclesSinceStart;
+
+    const bool t_lanesFull{std::all_of(m_laneFull.cbegin(), m_laneFull.cend(), [](const bool fullA) { return fullA; })};
+    const bool t_start{t_lanesFull && cOutputBufferDepth > m_inFlight + m_outputBuffer.size()
+                       && cInitiationInterval <= m_cyclesSinceStart};
+    if(t_start)
+    {
+        for(uint32_t i = 0; cNumOfInputs > i; ++i)
+        {
+            s_data_inputs[i].write(m_lanes[i]);
+            m_laneFull[i] = false;
+        }
+        ++m_inFlight;
+        m_cyclesSinceStart = 0;
+    }
+    s_start.write(t_start);
+
+    //Input lane handshakes
+    for(uint32_t i = 0; cNumOfInputs > i; ++i)
+    {
+        if(m_laneReady[i] && in_valids[i].read())
+        {
+            m_lanes[i] = data_inputs[i].read();
+            m_laneFull[i] = true;
+        }
+    }
+
+    /* A full lane is ready as well if its vector is applied at the next clock edge.
+     * Credits can only increase until then, thus the prediction is safe.
+     */
+    const bool t_startNext{std::all_of(m_laneFull.cbegin(), m_laneFull.cend(), [](const bool fullA) { return fullA; })
+                           && cOutputBufferDepth > m_inFlight + m_outputBuffer.size()
+                           && cInitiationInterval <= m_cyclesSinceStart + 1};
+    for(uint32_t i = 0; cNumOfInputs > i; ++i)
+    {
+        m_laneReady[i] = !m_laneFull[i] || t_startNext;
+        in_readys[i].write(m_laneReady[i]);
+    }
+
+    //Present the oldest result
+    m_outValid = !m_outputBuffer.empty();
+    if(m_outValid)
+    {
+        for(uint32_t i = 0; cNumOfOutputs > i; ++i)
+            data_outputs[i].write(m_outputBuffer.front()[i]);
+    }
+    out_valid.write(m_outValid);
+}
+
+void StreamingVCGRA::dump(::std::ostream& os) const
+{
+    os << this->name() << "\t\t\t" << this->kind() << std::endl;
+    os << "Initiation interval:\t\t\t" << cInitiationInterval << std::endl;
+    os << "Full input lanes:\t\t\t" << std::count(m_laneFull.cbegin(), m_laneFull.cend(), true) << std::endl;
+    os << "Input vectors in VCGRA:\t\t\t" << m_inFlight << std::endl;
+    os << "Buffered results:\t\t\t" << m_outputBuffer.size() << std::endl;
+    os << "Credits:\t\t\t\t" << cOutputBufferDepth - m_inFlight - m_outputBuffer.size() << std::endl;
+    os << std::endl;
+    m_vcgra.dump(os);
+}
+
+} // namespace cgra
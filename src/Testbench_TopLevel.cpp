@@ -18,11 +18,18 @@
  */
 
 #include "Testbench_TopLevel.h"
+#include "SobelProgram.hpp"
+#ifdef COMPRESSED_CONFIG
+#include "ConfigCompression.hpp"
+#endif
+#include <array>
+#include <iostream>
+#include <string>
 
 namespace cgra {
 
-Testbench_TopLevel::Testbench_TopLevel(const sc_core::sc_module_name& nameA, cgra::MMU& mmuA) :
-sc_core::sc_module(nameA), m_mmu(mmuA)
+Testbench_TopLevel::Testbench_TopLevel(const sc_core::sc_module_name& nameA, cgra::MMU& mmuA, cgra::ManagementUnit& muA) :
+sc_core::sc_module(nameA), m_mmu(mmuA), m_mu(muA)
 {
     SC_THREAD(stimuli);
     sensitive << finish.pos();
@@ -83,7 +90,10 @@ void Testbench_TopLevel::stimuli(void)
     run.write(true);
     wait(finish.posedge_event());
     auto t_stopSobely = sc_core::sc_time_stamp();
-    wait(50, sc_core::SC_NS);
+    run.write(false);
+    wait(220, sc_core::SC_NS);
+
+    sobelProgramVariants();
     sc_core::sc_stop();
     
     std::cout << "\n\nSimulation timings: " << "\n" ;
@@ -105,4 +115,218 @@ void Testbench_TopLevel::stimuli(void)
     return;
 }
 
+void Testbench_TopLevel::sobelProgramVariants()
+{
+    //The variants filter a section of the 64x64 image (0x200) with the Sobel
+    //configurations written by sc_main. Their data is placed behind the results.
+    constexpr uint32_t t_imageSize{64};
+    constexpr uint32_t t_sectionOrigin{20};
+    constexpr uint32_t t_sectionSize{24};
+    constexpr uint32_t t_numOfPixels{(t_sectionSize - 2) * (t_sectionSize - 2)};
+    constexpr uint32_t t_dataBase{0x4400};
+
+    std::cout << "\n\nSobel program variants (" << t_sectionSize - 2 << "x" << t_sectionSize - 2 << " pixels): " << "\n";
+
+    //The blocks hold one data value per DataInCache place
+    if(1 < cgra::cPackedLanes)
+    {
+        std::cout << "skipped, packed data values are not supported" << std::endl;
+        return;
+    }
+
+    std::array<uint16_t, t_imageSize * t_imageSize> t_image;
+    m_mmu.read_shared_memory<uint16_t>(0x200, t_image.data(), t_image.size());
+    const std::array<int16_t, 3*3> t_kernel{1, 0, -1, 2, 0, -2, 1, 0, -1};
+
+    SobelProgram t_program;
+    t_program.peConfigs = {0x00, 0x40};
+    t_program.chConfigs = {0x80, 0x120};
+    t_program.upperBlocks = t_dataBase;
+    t_program.lowerBlocks = t_program.upperBlocks + t_numOfPixels * SobelProgram::cBlockSize;
+    t_program.finalBlocks = t_program.lowerBlocks + t_numOfPixels * SobelProgram::cBlockSize;
+    t_program.upperSums = t_program.finalBlocks + t_numOfPixels * SobelProgram::cBlockSize;
+    t_program.lowerSums = t_program.upperSums + t_numOfPixels * SobelProgram::cSumSize;
+    t_program.results = t_program.lowerSums + t_numOfPixels * SobelProgram::cSumSize;
+    t_program.scratch = t_program.results + t_numOfPixels * sizeof(int16_t);
+    t_program.numOfPixels = t_numOfPixels;
+
+    //Blocks of each pass and the expected filter results
+    std::vector<int16_t> t_upperBlocks{}, t_lowerBlocks{}, t_finalBlocks{}, t_expected{};
+    for(uint32_t y = 1; t_sectionSize - 1 > y; ++y)
+    {
+        for(uint32_t x = 1; t_sectionSize - 1 > x; ++x)
+        {
+            auto pixel = [&](const int32_t dyA, const int32_t dxA) {
+                return static_cast<int16_t>(t_image.at((t_sectionOrigin + y + dyA) * t_imageSize + t_sectionOrigin + x + dxA));
+            };
+            const std::array<int16_t, 4> t_upper{pixel(-1, -1), pixel(-1, 0), pixel(-1, 1), pixel(0, -1)};
+            const std::array<int16_t, 4> t_lower{pixel(0, 0), pixel(0, 1), pixel(1, -1), pixel(1, 0)};
+
+            std::vector<int16_t> t_lowerBlock{};
+            for(uint32_t i = 0; 4 > i; ++i)
+            {
+                t_upperBlocks.push_back(t_kernel[i]);
+                t_upperBlocks.push_back(t_upper[i]);
+                t_lowerBlock.push_back(t_kernel[4 + i]);
+                t_lowerBlock.push_back(t_lower[i]);
+            }
+            t_lowerBlocks.insert(t_lowerBlocks.end(), t_lowerBlock.begin(), t_lowerBlock.end());
+            t_lowerBlock[0] = t_kernel[8];
+            t_lowerBlock[1] = pixel(1, 1);
+            t_finalBlocks.insert(t_finalBlocks.end(), t_lowerBlock.begin(), t_lowerBlock.end());
+
+            int32_t t_gradient{0};
+            for(int32_t k = 0; 9 > k; ++k)
+                t_gradient += t_kernel[k] * pixel(k / 3 - 1, k % 3 - 1);
+            t_expected.push_back(static_cast<int16_t>(t_gradient));
+        }
+    }
+    m_mmu.write_shared_memory<int16_t>(t_program.upperBlocks, t_upperBlocks.data(), t_upperBlocks.size());
+    m_mmu.write_shared_memory<int16_t>(t_program.lowerBlocks, t_lowerBlocks.data(), t_lowerBlocks.size());
+    m_mmu.write_shared_memory<int16_t>(t_program.finalBlocks, t_finalBlocks.data(), t_finalBlocks.size());
+
+    //Partial sums and results are cleared, thus a variant can not reuse results of a former one
+    std::vector<int16_t> t_reference{};
+    uint64_t t_referenceCycles{0};
+    auto runVariant = [&](const std::string& nameA, const SobelProgram& programA) {
+        const uint32_t t_region{static_cast<uint32_t>(programA.addressHigh) << 16};
+        std::vector<int16_t> t_results(t_numOfPixels * (2 * SobelProgram::cSumSize / sizeof(int16_t) + 1), 0);
+        m_mmu.write_shared_memory<int16_t>(t_region | programA.upperSums, t_results.data(), t_results.size());
+
+        const uint64_t t_cycles{runProgram(programA.assemble())};
+
+        t_results.resize(t_numOfPixels);
+        m_mmu.read_shared_memory<int16_t>(t_region | programA.results, t_results.data(), t_results.size());
+        const std::vector<int16_t>& t_compare{t_reference.empty() ? t_expected : t_reference};
+        uint32_t t_mismatches{0};
+        for(uint32_t idx = 0; t_numOfPixels > idx; ++idx)
+        {
+            if(t_compare[idx] != t_results[idx])
+                ++t_mismatches;
+        }
+
+        std::cout << nameA << ": " << t_cycles << " cycles";
+        if(t_reference.empty())
+        {
+            std::cout << ", " << t_mismatches << " mismatches against the host filter" << std::endl;
+            t_reference = t_results;
+            t_referenceCycles = t_cycles;
+        }
+        else
+        {
+            std::cout << " (" << static_cast<int64_t>(t_cycles) - static_cast<int64_t>(t_referenceCycles)
+                      << " cycles), " << t_mismatches << " mismatches against the program without streams" << std::endl;
+        }
+        if(0 != t_mismatches)
+            SC_REPORT_WARNING("Testbench", "Sobel program variant differs from its reference");
+    };
+
+    runVariant("without streams", t_program);
+
+    t_program.streamed = true;
+    runVariant("streamed", t_program);
+
+    //The same data in the second 64 KiB region of shared memory is addressed by SET_ADDR_HIGH
+    if(16 < cgra::cMemoryAddressBitwidth)
+    {
+        SobelProgram t_highProgram{t_program};
+        t_highProgram.addressHigh = 1;
+        const uint32_t t_region{static_cast<uint32_t>(t_highProgram.addressHigh) << 16};
+        m_mmu.write_shared_memory<int16_t>(t_region | t_program.upperBlocks, t_upperBlocks.data(), t_upperBlocks.size());
+        m_mmu.write_shared_memory<int16_t>(t_region | t_program.lowerBlocks, t_lowerBlocks.data(), t_lowerBlocks.size());
+        m_mmu.write_shared_memory<int16_t>(t_region | t_program.finalBlocks, t_finalBlocks.data(), t_finalBlocks.size());
+        runVariant("streamed above 64 KiB", t_highProgram);
+    }
+    else
+    {
+        std::cout << "streamed above 64 KiB: skipped, needs MMU_ADDRESS_WIDTH > 16" << std::endl;
+    }
+
+    //The following variants change configuration loads of the program without streams
+    t_program.streamed = false;
+#if defined(PARTIAL_RECONFIGURATION) || defined(COMPRESSED_CONFIG)
+    auto readConfiguration = [&](const uint32_t addressA, const uint32_t sizeA) {
+        std::vector<uint8_t> t_config(sizeA, 0);
+        m_mmu.read_shared_memory<uint8_t>(addressA, t_config.data(), sizeA);
+        return t_config;
+    };
+    constexpr uint32_t t_peConfigSize{cgra::calc_numOfBytes(cgra::cPeConfigBitWidth)};
+    constexpr uint32_t t_chConfigSize{cgra::calc_numOfBytes(cgra::cVChConfigBitWidth)};
+#endif
+
+#ifdef PARTIAL_RECONFIGURATION
+    //The final pass only loads the configuration bytes which differ from the partial sum passes
+    SobelProgram t_partialProgram{t_program};
+    t_partialProgram.peSegments = configurationSegments(readConfiguration(t_program.peConfigs[0], t_peConfigSize),
+                                                        readConfiguration(t_program.peConfigs[1], t_peConfigSize));
+    t_partialProgram.chSegments = configurationSegments(readConfiguration(t_program.chConfigs[0], t_chConfigSize),
+                                                        readConfiguration(t_program.chConfigs[1], t_chConfigSize));
+
+    uint32_t t_segmentBytes{0};
+    for(const auto& segment : t_partialProgram.peSegments)
+        t_segmentBytes += segment.second;
+    for(const auto& segment : t_partialProgram.chSegments)
+        t_segmentBytes += segment.second;
+    std::cout << "final configurations: " << t_segmentBytes << " of " << t_peConfigSize + t_chConfigSize << " bytes loaded in "
+              << t_partialProgram.peSegments.size() + t_partialProgram.chSegments.size() << " segments" << std::endl;
+    runVariant("partial reconfiguration", t_partialProgram);
+#else
+    std::cout << "partial reconfiguration: skipped, needs PARTIAL_RECONFIGURATION_ENABLED" << std::endl;
+#endif
+
+#ifdef COMPRESSED_CONFIG
+    //Only compressed copies which are smaller than their configuration are stored behind the scratch value
+    SobelProgram t_compressedProgram{t_program};
+    uint32_t t_compressedAddress{t_program.scratch + static_cast<uint32_t>(sizeof(int16_t))};
+    uint32_t t_savedBytes{0};
+    auto compress = [&](uint16_t& addressA, bool& compressedA, const uint32_t sizeA) {
+        std::vector<uint8_t> t_compressed{compressConfiguration(readConfiguration(addressA, sizeA))};
+        const uint64_t t_compressedSize{compressedConfigurationSize(t_compressed, 0, sizeA)};
+        if(sizeA <= t_compressedSize)
+            return;
+        m_mmu.write_shared_memory<uint8_t>(t_compressedAddress, t_compressed.data(), t_compressedSize);
+        addressA = static_cast<uint16_t>(t_compressedAddress);
+        compressedA = true;
+        t_compressedAddress += t_compressedSize;
+        t_savedBytes += sizeA - t_compressedSize;
+    };
+    for(uint32_t i = 0; 2 > i; ++i)
+    {
+        compress(t_compressedProgram.peConfigs[i], t_compressedProgram.peCompressed[i], t_peConfigSize);
+        compress(t_compressedProgram.chConfigs[i], t_compressedProgram.chCompressed[i], t_chConfigSize);
+    }
+
+    if(0 == t_savedBytes)
+    {
+        std::cout << "compressed configurations: skipped, no compressed configuration is smaller than its original" << std::endl;
+    }
+    else
+    {
+        std::cout << "compressed configurations: " << t_savedBytes << " bytes saved" << std::endl;
+        runVariant("compressed configurations", t_compressedProgram);
+    }
+#else
+    std::cout << "compressed configurations: skipped, needs COMPRESSED_CONFIG_ENABLED" << std::endl;
+#endif
+
+    return;
+}
+
+uint64_t Testbench_TopLevel::runProgram(const std::vector<uint32_t>& programA)
+{
+    m_mu.load_program(programA.data(), programA.size());
+
+    uint64_t t_cycles{0};
+    run.write(true);
+    do
+    {
+        wait(clk.posedge_event());
+        ++t_cycles;
+    } while(!finish.read());
+    run.write(false);
+    wait(220, sc_core::SC_NS);
+
+    return t_cycles;
+}
+
 } /* End namespace cgra */
@@ -15,6 +15,11 @@
 
 namespace
 {
+
+// The testbench writes the Sobel operands to data inputs 0..7 and reads data output 2
+static_assert(cgra::calc_isTopology(cgra::cPeLevels, cgra::cDefaultTopology),
+              "The Sobel testbench of vcgra_prefetchers needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
+
 /*!
  * \brief Read image file in pgm-format.
  *
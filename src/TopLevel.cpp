@@ -20,6 +20,10 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     data_out_cache.clk.bind(clk);
     pe_confCache.clk.bind(clk);
     ch_confCache.clk.bind(clk);
+#ifdef COMPRESSED_CONFIG
+    pe_decompressor.clk.bind(clk);
+    ch_decompressor.clk.bind(clk);
+#endif
     mmu.clk.bind(clk);
     mu.clk.bind(clk);
     //reset
@@ -101,11 +105,24 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     
     //PE configuration Cache
     pe_confCache.currentConfig.bind(s_pe_config);
+#ifndef COMPRESSED_CONFIG
     pe_confCache.dataInStream.bind(s_config_cache_stream);
     pe_confCache.ack.bind(s_acknowledges.at(MMU::CACHE_TYPE::CONF_PE));
     pe_confCache.write.bind(s_write_enables.at(MMU::CACHE_TYPE::CONF_PE));
+#else
+    pe_confCache.dataInStream.bind(s_decompressed_streams.first);
+    pe_confCache.ack.bind(s_decompressed_acknowledges.first);
+    pe_confCache.write.bind(s_decompressed_write_enables.first);
+#endif
     pe_confCache.slt_in.bind(s_pe_select_signals.first);
     pe_confCache.slt_out.bind(s_pe_select_signals.second);
+#ifdef PARTIAL_RECONFIGURATION
+#ifndef COMPRESSED_CONFIG
+    pe_confCache.slt_place.bind(s_cache_place);
+#else
+    pe_confCache.slt_place.bind(s_decompressed_places.first);
+#endif
+#endif
     #ifdef GSYSC
         RENAME_SIGNAL(&s_config_cache_stream,
             (cgra::create_name<std::string,uint32_t>("s_config_cache_stream_", 0)));
@@ -119,21 +136,47 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
             (cgra::create_name<std::string,uint32_t>("s_pe_select_signals_second_", 0)));
 
         REG_PORT(&pe_confCache.currentConfig, &pe_confCache, &s_pe_config);
+    #ifndef COMPRESSED_CONFIG
         REG_PORT(&pe_confCache.dataInStream,  &pe_confCache, &s_config_cache_stream);
         REG_PORT(&pe_confCache.ack,           &pe_confCache, &s_acknowledges.at(MMU::CACHE_TYPE::CONF_PE));
         REG_PORT(&pe_confCache.write,         &pe_confCache, &s_write_enables.at(MMU::CACHE_TYPE::CONF_PE));
+    #else
+        REG_PORT(&pe_confCache.dataInStream,  &pe_confCache, &s_decompressed_streams.first);
+        REG_PORT(&pe_confCache.ack,           &pe_confCache, &s_decompressed_acknowledges.first);
+        REG_PORT(&pe_confCache.write,         &pe_confCache, &s_decompressed_write_enables.first);
+    #endif
         REG_PORT(&pe_confCache.slt_in,        &pe_confCache, &s_pe_select_signals.first);
         REG_PORT(&pe_confCache.slt_out,       &pe_confCache, &s_pe_select_signals.second);
+    #ifdef PARTIAL_RECONFIGURATION
+    #ifndef COMPRESSED_CONFIG
+        REG_PORT(&pe_confCache.slt_place,     &pe_confCache, &s_cache_place);
+    #else
+        REG_PORT(&pe_confCache.slt_place,     &pe_confCache, &s_decompressed_places.first);
+    #endif
+    #endif
     #endif
     
     
     //VCH Configuration Cache
     ch_confCache.currentConfig.bind(s_ch_config);
+#ifndef COMPRESSED_CONFIG
     ch_confCache.dataInStream.bind(s_config_cache_stream);
     ch_confCache.ack.bind(s_acknowledges.at(MMU::CACHE_TYPE::CONF_CC));
     ch_confCache.write.bind(s_write_enables.at(MMU::CACHE_TYPE::CONF_CC));
+#else
+    ch_confCache.dataInStream.bind(s_decompressed_streams.second);
+    ch_confCache.ack.bind(s_decompressed_acknowledges.second);
+    ch_confCache.write.bind(s_decompressed_write_enables.second);
+#endif
     ch_confCache.slt_in.bind(s_ch_select_signals.first);
     ch_confCache.slt_out.bind(s_ch_select_signals.second);
+#ifdef PARTIAL_RECONFIGURATION
+#ifndef COMPRESSED_CONFIG
+    ch_confCache.slt_place.bind(s_cache_place);
+#else
+    ch_confCache.slt_place.bind(s_decompressed_places.second);
+#endif
+#endif
     #ifdef GSYSC
         RENAME_SIGNAL(&s_acknowledges.at(MMU::CACHE_TYPE::CONF_CC),
             (cgra::create_name<std::string,uint32_t>("s_acknowledges_CONF_CC_", 0)));
@@ -145,11 +188,94 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
             (cgra::create_name<std::string,uint32_t>("s_ch_select_signals_second_", 0)));
 
         REG_PORT(&ch_confCache.currentConfig, &ch_confCache, &s_pe_config);
+    #ifndef COMPRESSED_CONFIG
         REG_PORT(&ch_confCache.dataInStream,  &ch_confCache, &s_config_cache_stream);
         REG_PORT(&ch_confCache.ack,           &ch_confCache, &s_acknowledges.at(MMU::CACHE_TYPE::CONF_CC));
         REG_PORT(&ch_confCache.write,         &ch_confCache, &s_write_enables.at(MMU::CACHE_TYPE::CONF_CC));
+    #else
+        REG_PORT(&ch_confCache.dataInStream,  &ch_confCache, &s_decompressed_streams.second);
+        REG_PORT(&ch_confCache.ack,           &ch_confCache, &s_decompressed_acknowledges.second);
+        REG_PORT(&ch_confCache.write,         &ch_confCache, &s_decompressed_write_enables.second);
+    #endif
         REG_PORT(&ch_confCache.slt_in,        &ch_confCache, &s_ch_select_signals.first);
         REG_PORT(&ch_confCache.slt_out,       &ch_confCache, &s_ch_select_signals.second);
+    #ifdef PARTIAL_RECONFIGURATION
+    #ifndef COMPRESSED_CONFIG
+        REG_PORT(&ch_confCache.slt_place,     &ch_confCache, &s_cache_place);
+    #else
+        REG_PORT(&ch_confCache.slt_place,     &ch_confCache, &s_decompressed_places.second);
+    #endif
+    #endif
+
+#ifdef COMPRESSED_CONFIG
+    //PE configuration decompressor
+    pe_decompressor.compressed.bind(s_compressed);
+    pe_decompressor.dataInStream.bind(s_config_cache_stream);
+    pe_decompressor.write.bind(s_write_enables.at(MMU::CACHE_TYPE::CONF_PE));
+    pe_decompressor.ack.bind(s_acknowledges.at(MMU::CACHE_TYPE::CONF_PE));
+    pe_decompressor.dataOutStream.bind(s_decompressed_streams.first);
+    pe_decompressor.cache_write.bind(s_decompressed_write_enables.first);
+    pe_decompressor.cache_ack.bind(s_decompressed_acknowledges.first);
+#ifdef PARTIAL_RECONFIGURATION
+    pe_decompressor.slt_place.bind(s_cache_place);
+    pe_decompressor.cache_place.bind(s_decompressed_places.first);
+#endif
+    #ifdef GSYSC
+        RENAME_SIGNAL(&s_decompressed_streams.first,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_streams_first_", 0)));
+        RENAME_SIGNAL(&s_decompressed_write_enables.first,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_write_enables_first_", 0)));
+        RENAME_SIGNAL(&s_decompressed_acknowledges.first,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_acknowledges_first_", 0)));
+
+        REG_PORT(&pe_decompressor.compressed,    &pe_decompressor, &s_compressed);
+        REG_PORT(&pe_decompressor.dataInStream,  &pe_decompressor, &s_config_cache_stream);
+        REG_PORT(&pe_decompressor.write,         &pe_decompressor, &s_write_enables.at(MMU::CACHE_TYPE::CONF_PE));
+        REG_PORT(&pe_decompressor.ack,           &pe_decompressor, &s_acknowledges.at(MMU::CACHE_TYPE::CONF_PE));
+        REG_PORT(&pe_decompressor.dataOutStream, &pe_decompressor, &s_decompressed_streams.first);
+        REG_PORT(&pe_decompressor.cache_write,   &pe_decompressor, &s_decompressed_write_enables.first);
+        REG_PORT(&pe_decompressor.cache_ack,     &pe_decompressor, &s_decompressed_acknowledges.first);
+    #ifdef PARTIAL_RECONFIGURATION
+        REG_PORT(&pe_decompressor.slt_place,     &pe_decompressor, &s_cache_place);
+        REG_PORT(&pe_decompressor.cache_place,   &pe_decompressor, &s_decompressed_places.first);
+    #endif
+    #endif
+#endif
+
+#ifdef COMPRESSED_CONFIG
+    //VCH configuration decompressor
+    ch_decompressor.compressed.bind(s_compressed);
+    ch_decompressor.dataInStream.bind(s_config_cache_stream);
+    ch_decompressor.write.bind(s_write_enables.at(MMU::CACHE_TYPE::CONF_CC));
+    ch_decompressor.ack.bind(s_acknowledges.at(MMU::CACHE_TYPE::CONF_CC));
+    ch_decompressor.dataOutStream.bind(s_decompressed_streams.second);
+    ch_decompressor.cache_write.bind(s_decompressed_write_enables.second);
+    ch_decompressor.cache_ack.bind(s_decompressed_acknowledges.second);
+#ifdef PARTIAL_RECONFIGURATION
+    ch_decompressor.slt_place.bind(s_cache_place);
+    ch_decompressor.cache_place.bind(s_decompressed_places.second);
+#endif
+    #ifdef GSYSC
+        RENAME_SIGNAL(&s_decompressed_streams.second,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_streams_second_", 0)));
+        RENAME_SIGNAL(&s_decompressed_write_enables.second,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_write_enables_second_", 0)));
+        RENAME_SIGNAL(&s_decompressed_acknowledges.second,
+            (cgra::create_name<std::string,uint32_t>("s_decompressed_acknowledges_second_", 0)));
+
+        REG_PORT(&ch_decompressor.compressed,    &ch_decompressor, &s_compressed);
+        REG_PORT(&ch_decompressor.dataInStream,  &ch_decompressor, &s_config_cache_stream);
+        REG_PORT(&ch_decompressor.write,         &ch_decompressor, &s_write_enables.at(MMU::CACHE_TYPE::CONF_CC));
+        REG_PORT(&ch_decompressor.ack,           &ch_decompressor, &s_acknowledges.at(MMU::CACHE_TYPE::CONF_CC));
+        REG_PORT(&ch_decompressor.dataOutStream, &ch_decompressor, &s_decompressed_streams.second);
+        REG_PORT(&ch_decompressor.cache_write,   &ch_decompressor, &s_decompressed_write_enables.second);
+        REG_PORT(&ch_decompressor.cache_ack,     &ch_decompressor, &s_decompressed_acknowledges.second);
+    #ifdef PARTIAL_RECONFIGURATION
+        REG_PORT(&ch_decompressor.slt_place,     &ch_decompressor, &s_cache_place);
+        REG_PORT(&ch_decompressor.cache_place,   &ch_decompressor, &s_decompressed_places.second);
+    #endif
+    #endif
+#endif
     #endif
     
     //Data Output Cache
@@ -160,6 +286,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     data_out_cache.slt_in.bind(s_doc_select_signals.first);
     data_out_cache.slt_out.bind(s_doc_select_signals.second);
     data_out_cache.slt_place.bind(s_cache_place);
+#ifdef MMU_BURST_WIDTH
+    data_out_cache.burst.bind(s_burst);
+#endif
     #ifdef GSYSC
         RENAME_SIGNAL(&s_acknowledges.at(MMU::CACHE_TYPE::DATA_OUTPUT),
             (cgra::create_name<std::string,uint32_t>("s_acknowledges_DATA_OUTPUT_", 0)));
@@ -181,6 +310,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
         REG_PORT(&data_out_cache.slt_in,        &data_out_cache, &s_doc_select_signals.first);
         REG_PORT(&data_out_cache.slt_out,       &data_out_cache, &s_doc_select_signals.second);
         REG_PORT(&data_out_cache.slt_place,     &data_out_cache, &s_cache_place);
+    #ifdef MMU_BURST_WIDTH
+        REG_PORT(&data_out_cache.burst,         &data_out_cache, &s_burst);
+    #endif
     #endif
 
     for(uint16_t idx = 0; cgra::cPeLevels.back() > idx; ++idx) {
@@ -197,6 +329,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     data_in_cache.slt_in.bind(s_dic_select_signals.first);
     data_in_cache.slt_out.bind(s_dic_select_signals.second);
     data_in_cache.slt_place.bind(s_cache_place);
+#ifdef MMU_BURST_WIDTH
+    data_in_cache.burst.bind(s_burst);
+#endif
     #ifdef GSYSC
         RENAME_SIGNAL(&s_acknowledges.at(MMU::CACHE_TYPE::DATA_INPUT),
             (cgra::create_name<std::string,uint32_t>("s_acknowledges_DATA_INPUT_", 0)));
@@ -215,6 +350,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
         REG_PORT(&data_in_cache.slt_in,       &data_in_cache, &s_dic_select_signals.first);
         REG_PORT(&data_in_cache.slt_out,      &data_in_cache, &s_dic_select_signals.second);
         REG_PORT(&data_in_cache.slt_place,    &data_in_cache, &s_cache_place);
+    #ifdef MMU_BURST_WIDTH
+        REG_PORT(&data_in_cache.burst,        &data_in_cache, &s_burst);
+    #endif
     #endif
 
     for(uint16_t idx = 0; 2 * cgra::cPeLevels.front() > idx; ++idx)
@@ -232,6 +370,12 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     mu.mmu_ready.bind(s_mmu_ready);
     mu.address.bind(s_address);
     mu.place.bind(s_place);
+#ifdef PARTIAL_RECONFIGURATION
+    mu.segment.bind(s_segment);
+#endif
+#ifdef COMPRESSED_CONFIG
+    mu.compressed.bind(s_compressed);
+#endif
     mu.cache_select.bind(s_cache_select);
     mu.pe_cc_select_lines.first.bind(s_pe_select_signals.first);
     mu.pe_cc_select_lines.second.bind(s_pe_select_signals.second);
@@ -250,6 +394,14 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
             (cgra::create_name<std::string,uint32_t>("s_address_", 0)));
         RENAME_SIGNAL(&s_place,
             (cgra::create_name<std::string,uint32_t>("s_place_", 0)));
+    #ifdef PARTIAL_RECONFIGURATION
+        RENAME_SIGNAL(&s_segment,
+            (cgra::create_name<std::string,uint32_t>("s_segment_", 0)));
+    #endif
+    #ifdef COMPRESSED_CONFIG
+        RENAME_SIGNAL(&s_compressed,
+            (cgra::create_name<std::string,uint32_t>("s_compressed_", 0)));
+    #endif
         RENAME_SIGNAL(&s_cache_select,
             (cgra::create_name<std::string,uint32_t>("s_cache_select_", 0)));
 
@@ -259,6 +411,12 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
         REG_PORT(&mu.mmu_ready,                 &mu, &s_mmu_ready);
         REG_PORT(&mu.address,                   &mu, &s_address);
         REG_PORT(&mu.place,                     &mu, &s_place);
+    #ifdef PARTIAL_RECONFIGURATION
+        REG_PORT(&mu.segment,                   &mu, &s_segment);
+    #endif
+    #ifdef COMPRESSED_CONFIG
+        REG_PORT(&mu.compressed,                &mu, &s_compressed);
+    #endif
         REG_PORT(&mu.cache_select,              &mu, &s_cache_select);
         REG_PORT(&mu.pe_cc_select_lines.first,  &mu, &s_pe_select_signals.first);
         REG_PORT(&mu.pe_cc_select_lines.second, &mu, &s_pe_select_signals.second);
@@ -275,6 +433,12 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     mmu.ready.bind(s_mmu_ready);
     mmu.address.bind(s_address);
     mmu.place.bind(s_place);
+#ifdef PARTIAL_RECONFIGURATION
+    mmu.segment.bind(s_segment);
+#endif
+#ifdef COMPRESSED_CONFIG
+    mmu.compressed.bind(s_compressed);
+#endif
     mmu.conf_cache_stream.bind(s_config_cache_stream);
     mmu.cache_select.bind(s_cache_select);
     mmu.ack.bind(s_acknowledges.at(MMU::CACHE_TYPE::NONE));
@@ -282,6 +446,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
     mmu.data_value_in_stream.bind(s_data_out_stream);
     mmu.data_value_out_stream.bind(s_data_in_stream);
     mmu.cache_place.bind(s_cache_place);
+#ifdef MMU_BURST_WIDTH
+    mmu.burst.bind(s_burst);
+#endif
     #ifdef GSYSC
         RENAME_SIGNAL(&s_acknowledges.at(MMU::CACHE_TYPE::NONE),
             (cgra::create_name<std::string,uint32_t>("s_acknowledges_NONE_", 0)));
@@ -292,6 +459,12 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
         REG_PORT(&mmu.ready,                 &mmu, &s_mmu_ready);
         REG_PORT(&mmu.address,               &mmu, &s_address);
         REG_PORT(&mmu.place,                 &mmu, &s_place);
+    #ifdef PARTIAL_RECONFIGURATION
+        REG_PORT(&mmu.segment,               &mmu, &s_segment);
+    #endif
+    #ifdef COMPRESSED_CONFIG
+        REG_PORT(&mmu.compressed,            &mmu, &s_compressed);
+    #endif
         REG_PORT(&mmu.conf_cache_stream,     &mmu, &s_config_cache_stream);
         REG_PORT(&mmu.cache_select,          &mmu, &s_cache_select);
         REG_PORT(&mmu.ack,                   &mmu, &s_acknowledges.at(MMU::CACHE_TYPE::NONE));
@@ -299,6 +472,9 @@ cgra::TopLevel::TopLevel(const sc_core::sc_module_name& nameA,
         REG_PORT(&mmu.data_value_in_stream,  &mmu, &s_data_out_stream);
         REG_PORT(&mmu.data_value_out_stream, &mmu, &s_data_in_stream);
         REG_PORT(&mmu.cache_place,           &mmu, &s_cache_place);
+    #ifdef MMU_BURST_WIDTH
+        REG_PORT(&mmu.burst,                 &mmu, &s_burst);
+    #endif
     #endif
     
     //WE DeMUX
@@ -347,6 +523,12 @@ void cgra::TopLevel::dump(::std::ostream& os) const
     os << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
     ch_confCache.dump(os);
     os << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+#ifdef COMPRESSED_CONFIG
+    pe_decompressor.dump(os);
+    os << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    ch_decompressor.dump(os);
+    os << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+#endif
     data_in_cache.dump(os);
     os << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
     data_out_cache.dump(os);
@@ -27,6 +27,17 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
      */
     m_channel_instances.init(cgra::cNumOfLevels - 1);
 
+#ifdef CONFIG_DECODE_CACHE
+    //Configuration parts and select lines are written from the decode cache
+    SC_METHOD(decode_pe_configuration);
+    sensitive << pe_config;
+    SC_METHOD(decode_ch_configuration);
+    sensitive << ch_config;
+
+    m_input_channel.use_external_selects();
+    for(auto& vch : m_channel_instances)
+        vch.use_external_selects();
+#else
     //Connect configuration Selector and Demultiplexer
     m_input_channel_selector.config_input.bind(ch_config);
     m_input_channel_selector.config_parts.at(0).bind(s_input_ch_configuration);
@@ -89,6 +100,7 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
     REG_MODULE(&m_input_channel_selector, const_cast<char *>(m_input_channel_selector.basename()), this);
     REG_MODULE(&m_channel_selector, const_cast<char *>(m_channel_selector.basename()), this);
     REG_MODULE(&m_sync_selector, const_cast<char *>(m_sync_selector.basename()), this);
+#endif
 #endif
 
     //Connect Input Channel ports
@@ -123,6 +135,27 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
                  &data_inputs.at(i));
 #endif
     }
+#ifdef FEEDBACK_REGISTERS
+    //Feedback registers are valid at the start of an invocation like the data inputs
+    for(uint32_t i = 0; cgra::cNumOfFeedbackRegisters > i; ++i)
+    {
+        m_input_channel.valids.at(cgra::cInputChannel_NumOfInputs + i).bind(start);
+        m_input_channel.channel_inputs.at(cgra::cInputChannel_NumOfInputs + i).bind(s_feedback_signals.at(i));
+        m_feedback.feedback_outputs.at(i).bind(s_feedback_signals.at(i));
+
+#ifdef GSYSC
+        REG_PORT(&m_input_channel.valids.at(cgra::cInputChannel_NumOfInputs + i),
+                 &m_input_channel,
+                 &start);
+        REG_PORT(&m_input_channel.channel_inputs.at(cgra::cInputChannel_NumOfInputs + i),
+                 &m_input_channel,
+                 &s_feedback_signals.at(i));
+        REG_PORT(&m_feedback.feedback_outputs.at(i),
+                 &m_feedback,
+                 &s_feedback_signals.at(i));
+#endif
+    }
+#endif
     for(uint32_t i = 0; cgra::cInputChannel_NumOfOutputs > i; ++i)
     {
         m_input_channel.enables.at(i).bind(s_enables.at(i));
@@ -195,6 +228,7 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
         //Connect general VirtualChannels:
         uint32_t t_ch_num{0};
         uint32_t t_pe_level{0};
+        uint32_t t_unused_idx{0};
         for(auto& vch : m_channel_instances)
         {
             vch.clk.bind(clk);
@@ -208,28 +242,24 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
             REG_MODULE(&vch, const_cast<char*>(vch.basename()), this);
 #endif
 
-            for(uint16_t j = 0 , k = 0; cgra::cPeLevels.at(t_pe_level) > j; ++j, k += 2)
+            const auto t_offset_in = std::accumulate(cgra::cPeLevels.begin(),
+                                            cgra::cPeLevels.begin() + t_pe_level,
+                                            0);
+            const auto t_offset_out = 2 * (std::accumulate(cgra::cPeLevels.begin(),
+                                            cgra::cPeLevels.begin() + t_pe_level + 1,
+                                            0));
+
+            /*
+             * Channels are sized for the largest PE levels. Inputs without a
+             * preceding PE are constantly zero and invalid.
+             */
+            for(uint32_t j = 0; cgra::cChannel_NumOfInputs > j; ++j)
             {
-
-                auto t_offset_in = std::accumulate(cgra::cPeLevels.begin(),
-                                                cgra::cPeLevels.begin() + t_pe_level,
-                                                0);
-                auto t_offset_out = 2 * (std::accumulate(cgra::cPeLevels.begin(),
-                                                cgra::cPeLevels.begin() + t_pe_level + 1,
-                                                0));
-
-                vch.channel_inputs.at(j).bind(s_pe_data_output_signals.at(
-                    t_offset_in + j));
-                vch.valids.at(j).bind(s_pe_valid_signals.at(
-                    t_offset_in + j));
-                vch.channel_outputs.at(k).bind(s_pe_data_input_signals.at(
-                    t_offset_out + k));
-                vch.channel_outputs.at(k + 1).bind(s_pe_data_input_signals.at(
-                    t_offset_out + k + 1));
-                vch.enables.at(k).bind(s_enables.at(
-                    t_offset_out + k));
-                vch.enables.at(k + 1).bind(s_enables.at(
-                    t_offset_out + k + 1));
+                if(cgra::cPeLevels.at(t_pe_level) > j) {
+                    vch.channel_inputs.at(j).bind(s_pe_data_output_signals.at(
+                        t_offset_in + j));
+                    vch.valids.at(j).bind(s_pe_valid_signals.at(
+                        t_offset_in + j));
 
 #ifdef GSYSC
                     REG_PORT(&vch.channel_inputs.at(j),
@@ -238,19 +268,47 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
                     REG_PORT(&vch.valids.at(j),
                              &vch,
                              &s_pe_valid_signals.at(t_offset_in + j));
+#endif
+                }
+                else {
+                    vch.channel_inputs.at(j).bind(s_unused_channel_input);
+                    vch.valids.at(j).bind(s_unused_channel_valid);
+
+#ifdef GSYSC
+                    REG_PORT(&vch.channel_inputs.at(j), &vch, &s_unused_channel_input);
+                    REG_PORT(&vch.valids.at(j), &vch, &s_unused_channel_valid);
+#endif
+                }
+            }
+
+            //Outputs without a succeeding PE are left open
+            for(uint32_t k = 0; cgra::cChannel_NumOfOutputs > k; ++k)
+            {
+                if(2U * cgra::cPeLevels.at(t_pe_level + 1) > k) {
+                    vch.channel_outputs.at(k).bind(s_pe_data_input_signals.at(
+                        t_offset_out + k));
+                    vch.enables.at(k).bind(s_enables.at(
+                        t_offset_out + k));
+
+#ifdef GSYSC
                     REG_PORT(&vch.channel_outputs.at(k),
                              &vch,
                              &s_pe_data_input_signals.at(t_offset_out + k));
-                    REG_PORT(&vch.channel_outputs.at(k + 1),
-                             &vch,
-                             &s_pe_data_input_signals.at(t_offset_out + k + 1));
                     REG_PORT(&vch.enables.at(k),
                              &vch,
                              &s_enables.at(t_offset_out + k));
-                    REG_PORT(&vch.enables.at(k + 1),
-                             &vch,
-                             &s_enables.at(t_offset_out + k + 1));
 #endif
+                }
+                else {
+                    vch.channel_outputs.at(k).bind(s_unused_channel_outputs.at(t_unused_idx));
+                    vch.enables.at(k).bind(s_unused_channel_enables.at(t_unused_idx));
+
+#ifdef GSYSC
+                    REG_PORT(&vch.channel_outputs.at(k), &vch, &s_unused_channel_outputs.at(t_unused_idx));
+                    REG_PORT(&vch.enables.at(k), &vch, &s_unused_channel_enables.at(t_unused_idx));
+#endif
+                    ++t_unused_idx;
+                }
             }
 
             ++t_ch_num;
@@ -287,6 +345,28 @@ VCGRA::VCGRA(const sc_core::sc_module_name& nameA) :
 #endif
     }
 
+#ifdef FEEDBACK_REGISTERS
+    //Connect feedback registers to the data outputs
+    m_feedback.clk.bind(clk);
+    m_feedback.rst.bind(rst);
+    m_feedback.ready.bind(ready);
+
+#ifdef GSYSC
+    REG_PORT(&m_feedback.clk,   &m_feedback, &clk);
+    REG_PORT(&m_feedback.rst,   &m_feedback, &rst);
+    REG_PORT(&m_feedback.ready, &m_feedback, &ready);
+    REG_MODULE(&m_feedback, const_cast<char*>(m_feedback.basename()), this);
+#endif
+
+    for(uint32_t i = 0; cgra::cPeLevels.back() > i; ++i)
+    {
+        m_feedback.data_inputs.at(i).bind(data_outputs.at(i));
+#ifdef GSYSC
+        REG_PORT(&m_feedback.data_inputs.at(i), &m_feedback, &data_outputs.at(i));
+#endif
+    }
+#endif
+
 }
 
 void VCGRA::end_of_elaboration()
@@ -298,6 +378,133 @@ void VCGRA::end_of_elaboration()
 
 }
 
+#ifdef CONFIG_DECODE_CACHE
+VCGRA::PeDecode VCGRA::decode_pe(const cgra::pe_config_type_t& configA)
+{
+    constexpr uint32_t t_partBitwidth{cgra::cPeConfigBitWidth / cgra::cNumOfPe};
+    PeDecode t_decode;
+
+    //Same slices as the Demultiplexer
+    for(uint32_t i = 0; cgra::cNumOfPe > i; ++i)
+        t_decode.parts[i] = configA.range((cgra::cPeConfigBitWidth - 1) - i * t_partBitwidth,
+                                          cgra::cPeConfigBitWidth - (i + 1) * t_partBitwidth);
+
+    return t_decode;
+}
+
+VCGRA::ChDecode VCGRA::decode_ch(const cgra::ch_config_type_t& configA)
+{
+    //Fields are counted from the most significant bit like in the Selectors
+    auto t_field = [&configA](const uint32_t offsetA, const uint32_t lengthA) {
+        return configA.range(cgra::cVChConfigBitWidth - 1 - offsetA, cgra::cVChConfigBitWidth - offsetA - lengthA);
+    };
+    ChDecode t_decode;
+
+    t_decode.inputChannelPart = t_field(0, cgra::cInputChannelConfigBitwidth);
+    for(uint32_t k = 0; cgra::cInputChannel_NumOfOutputs > k; ++k)
+    {
+        t_decode.inputChannelSelects[k] = t_field(k * cgra::cInputChannel_MuxScltBitwidth,
+                                                  cgra::cInputChannel_MuxScltBitwidth).to_uint();
+        // Check, that selecting index is valid
+        sc_assert(t_decode.inputChannelSelects[k] < cgra::cInputChannel_NumOfChannelInputs);
+    }
+
+    for(uint32_t i = 0; cgra::cNumOfLevels - 1 > i; ++i)
+    {
+        const uint32_t t_offset{cgra::cInputChannelConfigBitwidth + i * cgra::cChannelConfigBitwidth};
+        t_decode.channelParts[i] = t_field(t_offset, cgra::cChannelConfigBitwidth);
+        for(uint32_t k = 0; cgra::cChannel_NumOfOutputs > k; ++k)
+        {
+            t_decode.channelSelects[i][k] = t_field(t_offset + k * cgra::cChannel_MuxScltBitwidth,
+                                                    cgra::cChannel_MuxScltBitwidth).to_uint();
+            // Check, that selecting index is valid
+            sc_assert(t_decode.channelSelects[i][k] < cgra::cChannel_NumOfInputs);
+        }
+    }
+
+    t_decode.syncPart = t_field(cgra::cSyncConfigStart, cgra::cPeLevels.back());
+
+    return t_decode;
+}
+
+void VCGRA::decode_pe_configuration()
+{
+    const cgra::pe_config_type_t t_config{pe_config.read()};
+
+    //Undefined configurations (e.g. at power-on) are decoded without caching
+    PeDecode t_uncached;
+    const PeDecode* t_pesPtr{&t_uncached};
+    if(has_unknown_bits(t_config))
+    {
+        t_uncached = decode_pe(t_config);
+        ++m_decodes;
+    }
+    else
+    {
+        const auto t_key = config_key<pe_config_key_t>(t_config);
+
+        auto t_decode = m_peDecodes.find(t_key);
+        if(m_peDecodes.end() == t_decode)
+        {
+            if(cNumOfDecodes <= m_peDecodes.size())
+                m_peDecodes.clear();
+            t_decode = m_peDecodes.emplace(t_key, decode_pe(t_config)).first;
+            ++m_decodes;
+        }
+        else
+        {
+            ++m_cachedDecodes;
+        }
+        t_pesPtr = &t_decode->second;
+    }
+
+    for(uint32_t i = 0; cgra::cNumOfPe > i; ++i)
+        s_pe_configurations[i].write(t_pesPtr->parts[i]);
+}
+
+void VCGRA::decode_ch_configuration()
+{
+    const cgra::ch_config_type_t t_config{ch_config.read()};
+
+    //Undefined configurations (e.g. at power-on) are decoded without caching
+    ChDecode t_uncached;
+    const ChDecode* t_channelsPtr{&t_uncached};
+    if(has_unknown_bits(t_config))
+    {
+        t_uncached = decode_ch(t_config);
+        ++m_decodes;
+    }
+    else
+    {
+        const auto t_key = config_key<ch_config_key_t>(t_config);
+
+        auto t_decode = m_chDecodes.find(t_key);
+        if(m_chDecodes.end() == t_decode)
+        {
+            if(cNumOfDecodes <= m_chDecodes.size())
+                m_chDecodes.clear();
+            t_decode = m_chDecodes.emplace(t_key, decode_ch(t_config)).first;
+            ++m_decodes;
+        }
+        else
+        {
+            ++m_cachedDecodes;
+        }
+        t_channelsPtr = &t_decode->second;
+    }
+
+    const ChDecode& t_channels = *t_channelsPtr;
+    s_input_ch_configuration.write(t_channels.inputChannelPart);
+    m_input_channel.load_selects(t_channels.inputChannelSelects);
+    for(uint32_t i = 0; cgra::cNumOfLevels - 1 > i; ++i)
+    {
+        s_ch_configurations[i].write(t_channels.channelParts[i]);
+        m_channel_instances[i].load_selects(t_channels.channelSelects[i]);
+    }
+    s_sync_configuration.write(t_channels.syncPart);
+}
+#endif
+
 
 #ifdef MCPAT
     /**
@@ -320,6 +527,9 @@ void VCGRA::dumpMcpatStatistics(std::ostream& os) const
     }
 
     m_sync.dumpMcpatStatistics(os);
+#ifdef FEEDBACK_REGISTERS
+    m_feedback.dumpMcpatStatistics(os);
+#endif
 }
 #endif
 
@@ -355,6 +565,11 @@ void VCGRA::dump(::std::ostream & os) const
     os << std::endl;
     m_sync.dump(os);
     os << std::endl;
+#ifdef FEEDBACK_REGISTERS
+    m_feedback.dump(os);
+    os << std::endl;
+#endif
+#ifndef CONFIG_DECODE_CACHE
     m_input_channel_selector.dump(os);
     os << std::endl;
     m_pe_config_demux.dump(os);
@@ -363,6 +578,9 @@ void VCGRA::dump(::std::ostream & os) const
     os << std::endl;
     m_sync_selector.dump(os);
     os << std::endl;
+#else
+    os << "Decoded configurations:\t\t" << m_decodes << " (cached: " << m_cachedDecodes << ")" << std::endl;
+#endif
 
 }
 
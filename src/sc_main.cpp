@@ -12,6 +12,13 @@
 #include <fstream>
 #include "TopLevel.h"
 #include "Testbench_TopLevel.h"
+#include "ProgramLoader.hpp"
+#include "PeConfiguration.hpp"
+#include "ChConfiguration.hpp"
+#ifdef COMPRESSED_CONFIG
+#include <map>
+#include "ConfigCompression.hpp"
+#endif
 #include "Assembler.hpp"
 
 #ifdef GSYSC
@@ -20,6 +27,11 @@
 
 namespace {
 
+// The example program and its Sobel configurations address PEs, VirtualChannel selects
+// and data outputs of the default topology, use vcgra_scaling for other topologies
+static_assert(cgra::calc_isTopology(cgra::cPeLevels, cgra::cDefaultTopology),
+              "The Sobel program of full_architecture needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
+
 /*!
  * \brief Read image file in pgm-format.
  * 
@@ -131,6 +143,46 @@ bool writePgm(const std::string& file_p, const int16_t* image, const uint32_t si
   return true;
 }
 
+#ifdef COMPRESSED_CONFIG
+/*!
+ * \brief Load whole configuration cache lines of a program from compressed configurations
+ *
+ * \details
+ * LOADPC and LOADCC commands with place 127 are replaced by LOADPCZ and LOADCCZ
+ * commands. The address of a configuration is replaced by the address of its
+ * compressed copy if it is contained in addressesA.
+ *
+ * \param[in] programA   Assembler commands of the program
+ * \param[in] addressesA Shared memory addresses of the compressed copies of configurations
+ * \return Program with compressed configuration loads
+ */
+std::vector<uint32_t> useCompressedConfigurations(const std::vector<uint32_t>& programA,
+                                                  const std::map<uint32_t, uint32_t>& addressesA)
+{
+    //Command numbers of the ManagementUnit
+    constexpr uint32_t c_loadpc{9};
+    constexpr uint32_t c_loadcc{10};
+    constexpr uint32_t c_loadpcz{25};
+    constexpr uint32_t c_loadccz{26};
+
+    std::vector<uint32_t> t_program{programA};
+    for(auto& command : t_program)
+    {
+        const cgra::CommandInterpreter::Instruction t_instruction{cgra::CommandInterpreter::predecode(command)};
+        const auto t_compressed = addressesA.find(t_instruction.address);
+
+        if((c_loadpc == t_instruction.command || c_loadcc == t_instruction.command) && 127 == t_instruction.place &&
+           addressesA.end() != t_compressed)
+        {
+            command = (t_compressed->second << 16) | (command & 0xFFC0) |
+                      ((c_loadpc == t_instruction.command) ? c_loadpcz : c_loadccz);
+        }
+    }
+
+    return t_program;
+}
+#endif
+
 } // namespace
 
 
@@ -179,11 +231,30 @@ int sc_main(int argc, char* argv[])
     //     "0x00101FC8", //STOREDA 16 0
     //     "0x0000000C"  //FINISH
     // };
+    /*
+    An optional binary program file (packed little-endian 32 bit commands)
+    replaces the built-in assembler program:
+        full_architecture [program.bin]
+    */
+    cgra::ProgramLoader t_program{};
+    if(1 < argc)
+    {
+        if(!t_program.load(argv[1]))
+        {
+            std::cerr << "Can not load program file: " << argv[1] << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Loaded " << t_program.size() << " assembler commands from " << argv[1]
+                  << (t_program.mapped() ? " (memory-mapped)" : "") << std::endl;
+    }
+
     //instantiate modules
     auto toplevel = new cgra::TopLevel{"TopLevel", cgra::assembly.data(), cgra::assembly.size()};
+    if(1 < argc)
+        toplevel->mu.load_program(t_program.data(), t_program.size());
 
     //include TB
-    auto tb_toplevel = new cgra::Testbench_TopLevel{"Architecture_TestBench", toplevel->mmu};
+    auto tb_toplevel = new cgra::Testbench_TopLevel{"Architecture_TestBench", toplevel->mmu, toplevel->mu};
     
 //#############################################################################
 
@@ -230,7 +301,9 @@ int sc_main(int argc, char* argv[])
     sc_core::sc_trace(fp_toplevel,rst,"rst");
     sc_core::sc_trace(fp_toplevel,pause,"pause");
     sc_core::sc_trace(fp_toplevel,finish,"finish");
+#ifndef PREDECODED_INSTRUCTIONS
     sc_core::sc_trace(fp_toplevel, toplevel->mu.m_currentAssembler, "assembler");
+#endif
     sc_core::sc_trace(fp_toplevel, toplevel->mu.address, "address");
     sc_core::sc_trace(fp_toplevel, toplevel->mu.place, "place");
     sc_core::sc_trace(fp_toplevel, toplevel->mu.cache_select, "cache_select");
@@ -286,16 +359,60 @@ int sc_main(int argc, char* argv[])
         return EXIT_FAILURE;
 
     toplevel->mmu.write_shared_memory<uint16_t>(0x200, tdataValues.data(), tdataValues.max_size());
-    std::vector<uint8_t> tPeConfig1 = {0x33, 0x33, 0x01, 0x01, 0x00, 0x10, 0x00, 0x80};
-    std::vector<uint8_t> tPeConfig2 = {0x38, 0x80, 0x01, 0x80, 0x00, 0x10, 0x00, 0x80};
+    std::vector<uint8_t> tPeConfig1 = cgra::expandPeConfiguration({0x33, 0x33, 0x01, 0x01, 0x00, 0x10, 0x00, 0x80});
+    std::vector<uint8_t> tPeConfig2 = cgra::expandPeConfiguration({0x38, 0x80, 0x01, 0x80, 0x00, 0x10, 0x00, 0x80});
     toplevel->mmu.write_shared_memory(0x00, tPeConfig1.data(), tPeConfig1.size());
     toplevel->mmu.write_shared_memory(0x40, tPeConfig2.data(), tPeConfig2.size());
-    std::vector<uint8_t> tChConfig1 = {0x05, 0x39, 0x77, 0x01, 0xAB,
-                            0x05, 0x7F, 0x05, 0xAF, 0xB0};
-    std::vector<uint8_t> tChConfig2 = {0x05, 0x26, 0xE4, 0x01, 0xAF,
-                            0x05, 0x6F, 0x05, 0xAF, 0xB0};
+    std::vector<uint8_t> tChConfig1 = cgra::expandChConfiguration({0x05, 0x39, 0x77, 0x01, 0xAB,
+                            0x05, 0x7F, 0x05, 0xAF, 0xB0});
+    std::vector<uint8_t> tChConfig2 = cgra::expandChConfiguration({0x05, 0x26, 0xE4, 0x01, 0xAF,
+                            0x05, 0x6F, 0x05, 0xAF, 0xB0});
     toplevel->mmu.write_shared_memory(0x80, tChConfig1.data(), tChConfig1.size());
     toplevel->mmu.write_shared_memory(0x120, tChConfig2.data(), tChConfig2.size());
+
+#ifdef COMPRESSED_CONFIG
+    /*
+    The built-in program loads configurations from compressed copies, which are
+    stored behind the results. Only copies which are smaller than their configuration
+    are used. A program file is used unchanged.
+    */
+    if(1 >= argc)
+    {
+        std::map<uint32_t, uint32_t> t_compressedAddresses{};
+        const uint32_t t_compressedBase{0x4200};
+        uint32_t t_compressedAddress{t_compressedBase};
+        uint32_t t_configBytes{0};
+        for(const auto& config : {std::make_pair(0x00U, &tPeConfig1), std::make_pair(0x40U, &tPeConfig2),
+                                  std::make_pair(0x80U, &tChConfig1), std::make_pair(0x120U, &tChConfig2)})
+        {
+            std::vector<uint8_t> t_compressed = cgra::compressConfiguration(*config.second);
+            const uint64_t t_compressedSize{cgra::compressedConfigurationSize(t_compressed, 0, config.second->size())};
+            if(config.second->size() <= t_compressedSize)
+                continue;
+            toplevel->mmu.write_shared_memory(t_compressedAddress, t_compressed.data(), t_compressedSize);
+            t_compressedAddresses[config.first] = t_compressedAddress;
+            t_compressedAddress += t_compressedSize;
+            t_configBytes += config.second->size();
+        }
+
+        if(t_compressedAddresses.empty())
+        {
+            std::cout << "Compressed configurations: no compressed configuration is smaller than its original" << std::endl;
+        }
+        else
+        {
+            std::cout << "Compressed configurations: " << t_compressedAddresses.size() << " configurations of "
+                      << t_configBytes << " bytes stored in " << t_compressedAddress - t_compressedBase << " bytes ("
+                      << t_configBytes - (t_compressedAddress - t_compressedBase) << " bytes saved)" << std::endl;
+
+            std::vector<uint32_t> t_assembly{};
+            for(const auto& command : cgra::assembly)
+                t_assembly.push_back(command.to_uint());
+            const std::vector<uint32_t> t_compressedProgram{useCompressedConfigurations(t_assembly, t_compressedAddresses)};
+            toplevel->mu.load_program(t_compressedProgram.data(), t_compressedProgram.size());
+        }
+    }
+#endif
   }
 
   // Run simulation
@@ -7,6 +7,7 @@
 
 #include "testbench_vcgra_only.hpp"
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
 
 #ifdef GSYSC
@@ -16,6 +17,11 @@
 
 namespace
 {
+
+// The testbench writes the Sobel operands to data inputs 0..7 and reads data output 2
+static_assert(cgra::calc_isTopology(cgra::cPeLevels, cgra::cDefaultTopology),
+              "The Sobel testbench of vcgra_only needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
+
 /*!
  * \brief Read image file in pgm-format.
  *
@@ -137,16 +143,14 @@ auto writePgm(const std::string &file_p, const int16_t *image, const uint32_t si
  * @brief Create configuration bitvector from byte array
  *
  * @tparam bw   Bitwidth of target bitvector
- * @tparam T    Type of input configuration byte array
  * @param[in] configA   Input configuration byte array
- * @param[in] indexA    Index of configuration to use from configuration byte array
- * @return sc_dt::sc_lv<bw>     Logic vector with configuration
+ * @return cgra::config_vector_t<bw>     Vector with configuration
  */
-template <uint32_t bw, typename T> auto prepareConfig(T &configA, uint8_t indexA) -> sc_dt::sc_lv<bw> 
+template <uint32_t bw> auto prepareConfig(const std::vector<uint8_t> &configA) -> cgra::config_vector_t<bw>
 {
 
-    sc_dt::sc_lv<bw> config{0};
-    for (auto value : configA[indexA]) {
+    cgra::config_vector_t<bw> config{0};
+    for (auto value : configA) {
         config <<= sizeof(value) * 8;
         config |= value;
     }
@@ -174,7 +178,14 @@ Testbench::Testbench(const sc_core::sc_module_name &nameA, std::string imagePath
     mSobelxValues.fill(0);
     mSobelyValues.fill(0);
 
+#ifndef STREAMING_VCGRA
     SC_THREAD(stimuli);
+#else
+    SC_THREAD(streamStimuli);
+    SC_METHOD(collectResults);
+    sensitive << clk.pos();
+    dont_initialize();
+#endif
 }
 
 std::size_t Testbench::appendPeConfiguration(std::vector<uint8_t> peConfA)
@@ -195,6 +206,235 @@ bool Testbench::writeResultImagetoFile(const std::string &pathA) const
                     *std::max_element(mResultValues.cbegin(), mResultValues.cend()));
 }
 
+std::array<std::vector<uint8_t>, 3> Testbench::sobelPeConfigurations(const std::array<int16_t, 3 * 3> &kernelA) const
+{
+    std::array<std::vector<uint8_t>, 3> t_configs{mPeConfigs.at(0), mPeConfigs.at(0), mPeConfigs.at(1)};
+
+#ifdef PE_IMMEDIATES
+    // PEs 0 to 3 of the first level multiply a pixel with a coefficient
+    for (uint32_t t_pe = 0; 4 > t_pe; ++t_pe) {
+        cgra::setPeImmediate(t_configs[0], t_pe, kernelA[t_pe]);
+        cgra::setPeImmediate(t_configs[1], t_pe, kernelA[4 + t_pe]);
+    }
+    cgra::setPeImmediate(t_configs[2], 0, kernelA[8]);
+#else
+    static_cast<void>(kernelA);
+#endif
+
+    return t_configs;
+}
+
+#ifdef PACKED_DATAPATH
+std::vector<std::size_t> Testbench::packedSobelTerms(const std::array<int16_t, 3 * 3> &kernelA, const bool negativeA)
+{
+    std::vector<std::size_t> t_terms;
+    for (std::size_t t_index = 0; kernelA.size() > t_index; ++t_index) {
+        if ((negativeA && 0 > kernelA[t_index]) || (!negativeA && 0 < kernelA[t_index])) {
+            t_terms.push_back(t_index);
+        }
+    }
+
+    // The first PE level of the sum configuration contains four multipliers
+    if (4 < t_terms.size()) {
+        SC_REPORT_ERROR("Testbench", "Packed Sobel run supports up to four coefficients of each sign.");
+    }
+
+    return t_terms;
+}
+
+std::array<std::vector<Testbench::input_vector_t>, 2>
+Testbench::packedSobelVectors(const std::array<int16_t, 3 * 3> &kernelA) const
+{
+    constexpr size_t t_numOfWindows{(cInputSize - 2) * (cInputSize - 2)};
+    constexpr int32_t t_laneMask{(1 << cgra::cPackedLaneBitwidth) - 1};
+
+    std::array<std::vector<input_vector_t>, 2> t_vectors{std::vector<input_vector_t>(cPackedVectors),
+                                                         std::vector<input_vector_t>(cPackedVectors)};
+    for (size_t t_sign = 0; 2 > t_sign; ++t_sign) {
+        const std::vector<std::size_t> t_terms{packedSobelTerms(kernelA, 0 < t_sign)};
+
+        for (size_t t_vector = 0; cPackedVectors > t_vector; ++t_vector) {
+            for (size_t t_pe = 0; t_terms.size() > t_pe; ++t_pe) {
+                int32_t t_pixels{0};
+                int32_t t_coefficients{0};
+                for (uint32_t t_lane = 0; cgra::cPackedLanes > t_lane; ++t_lane) {
+                    const size_t t_window{t_vector * cgra::cPackedLanes + t_lane};
+                    if (t_numOfWindows <= t_window) {
+                        break;
+                    }
+                    const size_t yiter = t_window / (cInputSize - 2) + t_terms[t_pe] / 3;
+                    const size_t xiter = t_window % (cInputSize - 2) + t_terms[t_pe] % 3;
+                    const int32_t t_pixel{mInputValues.at(yiter * cInputSize + xiter) >> cPackedPixelShift};
+                    t_pixels |= (t_pixel & t_laneMask) << (t_lane * cgra::cPackedLaneBitwidth);
+                    t_coefficients |= (std::abs(kernelA[t_terms[t_pe]]) & t_laneMask)
+                                      << (t_lane * cgra::cPackedLaneBitwidth);
+                }
+                t_vectors[t_sign][t_vector][2 * t_pe + cPixelInput] = t_pixels;
+#ifndef PE_IMMEDIATES
+                t_vectors[t_sign][t_vector][2 * t_pe] = t_coefficients;
+#endif
+            }
+        }
+    }
+
+    return t_vectors;
+}
+
+std::array<std::vector<uint8_t>, 3>
+Testbench::packedSobelPeConfigurations(const std::array<int16_t, 3 * 3> &kernelA) const
+{
+    // PE 10 adds the two partial sums of the final configuration
+    constexpr uint32_t t_finalSumPe{10};
+
+    std::array<std::vector<uint8_t>, 3> t_configs{mPeConfigs.at(0), mPeConfigs.at(0), mPeConfigs.at(1)};
+    cgra::setPeOperation(t_configs[2], t_finalSumPe, cgra::PeOperations::SSUB);
+
+#ifdef PE_IMMEDIATES
+    // The coefficient of each lane is an immediate operand, unused multipliers calculate zero
+    for (size_t t_sign = 0; 2 > t_sign; ++t_sign) {
+        const std::vector<std::size_t> t_terms{packedSobelTerms(kernelA, 0 < t_sign)};
+        for (uint32_t t_pe = 0; 4 > t_pe; ++t_pe) {
+            int32_t t_coefficients{0};
+            for (uint32_t t_lane = 0; t_pe < t_terms.size() && cgra::cPackedLanes > t_lane; ++t_lane) {
+                t_coefficients |= (std::abs(kernelA[t_terms[t_pe]]) & ((1 << cgra::cPackedLaneBitwidth) - 1))
+                                  << (t_lane * cgra::cPackedLaneBitwidth);
+            }
+            cgra::setPeImmediate(t_configs[t_sign], t_pe, t_coefficients);
+        }
+    }
+#else
+    static_cast<void>(kernelA);
+#endif
+
+    return t_configs;
+}
+
+void Testbench::storePackedSobelResults(const std::size_t vectorA, const std::array<int16_t, 2> &differencesA,
+                                        std::array<int16_t, 64 * 64> &resultsA)
+{
+    typedef cgra::VCGRA::pe_datapath_type_t datapath_type_t;
+    constexpr size_t t_numOfWindows{(cInputSize - 2) * (cInputSize - 2)};
+
+    for (uint16_t t_lane = 0; cgra::cPackedLanes > t_lane; ++t_lane) {
+        const size_t t_window{vectorA * cgra::cPackedLanes + t_lane};
+        if (t_numOfWindows <= t_window) {
+            break;
+        }
+        // Unsigned lanes hold the positive and the negative part of the gradient separately
+        int64_t t_gradient{datapath_type_t::lane<cgra::cPeDataBitwidth>(differencesA[0], t_lane)};
+        if (1 < cPackedDifferences) {
+            t_gradient -= datapath_type_t::lane<cgra::cPeDataBitwidth>(differencesA[1], t_lane);
+        }
+        const size_t yiter = t_window / (cInputSize - 2) + 1;
+        const size_t xiter = t_window % (cInputSize - 2) + 1;
+        resultsA.at(yiter * cOutputSize + xiter) = static_cast<int16_t>(t_gradient);
+    }
+}
+
+std::size_t Testbench::verifyPackedSobel(const std::array<int16_t, 3 * 3> &kernelA,
+                                         const std::array<int16_t, 64 * 64> &resultsA) const
+{
+    std::size_t t_mismatches{0};
+    for (size_t yiter = 1; yiter < cInputSize - 1; ++yiter) {
+        for (size_t xiter = 1; xiter < cInputSize - 1; ++xiter) {
+            int32_t t_gradient{0};
+            for (size_t t_index = 0; kernelA.size() > t_index; ++t_index) {
+                const size_t t_y{yiter + t_index / 3 - 1};
+                const size_t t_x{xiter + t_index % 3 - 1};
+                t_gradient += kernelA[t_index] * (mInputValues.at(t_y * cInputSize + t_x) >> cPackedPixelShift);
+            }
+            if (t_gradient != resultsA.at(yiter * cOutputSize + xiter)) {
+                ++t_mismatches;
+            }
+        }
+    }
+
+    return t_mismatches;
+}
+#endif
+
+std::size_t Testbench::verifyWithFunctionalModel(const std::array<int16_t, 3 * 3> &kernelA,
+                                                 const std::array<int16_t, 64 * 64> &resultsA) const
+{
+    typedef cgra::SimdVcgra::value_type_t value_type_t;
+
+    const std::array<std::vector<uint8_t>, 3> t_peConfigs{sobelPeConfigurations(kernelA)};
+    cgra::SimdVcgra t_upperSum{cgra::FunctionalVcgra{t_peConfigs[0], mChConfigs.at(0)}};
+    cgra::SimdVcgra t_lowerSum{cgra::FunctionalVcgra{t_peConfigs[1], mChConfigs.at(0)}};
+    cgra::SimdVcgra t_finalSum{cgra::FunctionalVcgra{t_peConfigs[2], mChConfigs.at(1)}};
+
+    // All pixel windows of the image are processed as one tile (structure of arrays)
+    constexpr size_t t_numOfWindows{(cInputSize - 2) * (cInputSize - 2)};
+    std::vector<value_type_t> t_inputs(cgra::SimdVcgra::cNumOfInputs * t_numOfWindows, 0);
+    std::vector<value_type_t> t_temp0(cgra::SimdVcgra::cNumOfOutputs * t_numOfWindows, 0);
+    std::vector<value_type_t> t_temp1(cgra::SimdVcgra::cNumOfOutputs * t_numOfWindows, 0);
+    std::vector<value_type_t> t_outputs(cgra::SimdVcgra::cNumOfOutputs * t_numOfWindows, 0);
+
+    auto input = [&t_inputs](const size_t portA, const size_t windowA) -> value_type_t & {
+        return t_inputs[portA * t_numOfWindows + windowA];
+    };
+    auto pixel = [this](const size_t y, const size_t x) -> value_type_t {
+        return static_cast<value_type_t>(mInputValues.at(y * cInputSize + x));
+    };
+
+    // First pass: upper half of the kernel
+    for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+        const size_t yiter = t_window / (cInputSize - 2) + 1;
+        const size_t xiter = t_window % (cInputSize - 2) + 1;
+        input(cPixelInput, t_window) = pixel(yiter - 1, xiter - 1);
+        input(2 + cPixelInput, t_window) = pixel(yiter - 1, xiter);
+        input(4 + cPixelInput, t_window) = pixel(yiter - 1, xiter + 1);
+        input(6 + cPixelInput, t_window) = pixel(yiter, xiter - 1);
+#ifndef PE_IMMEDIATES
+        for (size_t i = 0; i < 4; ++i) {
+            input(2 * i, t_window) = kernelA[i];
+        }
+#endif
+    }
+    t_upperSum.evaluateTile(t_inputs.data(), t_temp0.data(), t_numOfWindows);
+
+    // Second pass: lower half of the kernel
+    for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+        const size_t yiter = t_window / (cInputSize - 2) + 1;
+        const size_t xiter = t_window % (cInputSize - 2) + 1;
+        input(cPixelInput, t_window) = pixel(yiter, xiter);
+        input(2 + cPixelInput, t_window) = pixel(yiter, xiter + 1);
+        input(4 + cPixelInput, t_window) = pixel(yiter + 1, xiter - 1);
+        input(6 + cPixelInput, t_window) = pixel(yiter + 1, xiter);
+#ifndef PE_IMMEDIATES
+        for (size_t i = 0; i < 4; ++i) {
+            input(2 * i, t_window) = kernelA[4 + i];
+        }
+#endif
+    }
+    t_lowerSum.evaluateTile(t_inputs.data(), t_temp1.data(), t_numOfWindows);
+
+    // Third pass: last kernel value and sum of both intermediate results;
+    // data inputs keep their values between invocations like the VCGRA ports
+    for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+        const size_t yiter = t_window / (cInputSize - 2) + 1;
+        const size_t xiter = t_window % (cInputSize - 2) + 1;
+        input(cPixelInput, t_window) = pixel(yiter + 1, xiter + 1);
+        input(2, t_window) = t_temp0[2 * t_numOfWindows + t_window];
+        input(3, t_window) = t_temp1[2 * t_numOfWindows + t_window];
+#ifndef PE_IMMEDIATES
+        input(0, t_window) = kernelA[8];
+#endif
+    }
+    t_finalSum.evaluateTile(t_inputs.data(), t_outputs.data(), t_numOfWindows);
+
+    std::size_t t_mismatches{0};
+    for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+        const size_t yiter = t_window / (cInputSize - 2) + 1;
+        const size_t xiter = t_window % (cInputSize - 2) + 1;
+        if (t_outputs[2 * t_numOfWindows + t_window] != resultsA.at(yiter * cOutputSize + xiter)) {
+            ++t_mismatches;
+        }
+    }
+
+    return t_mismatches;
+}
+
 void Testbench::dump(::std::ostream &os) const
 {
     os << "tbd";
@@ -203,14 +443,22 @@ void Testbench::dump(::std::ostream &os) const
 void Testbench::end_of_elaboration()
 {
     rst.write(true);
+#ifndef STREAMING_VCGRA
     start.write(false);
-    pe_config.write(sc_dt::sc_lv<cPeConfigBitWidth>{0});
-    ch_config.write(sc_dt::sc_lv<cVChConfigBitWidth>{0});
+#else
+    for (auto &valid : in_valids) {
+        valid.write(false);
+    }
+    out_ready.write(true);
+#endif
+    pe_config.write(cgra::pe_config_type_t{0});
+    ch_config.write(cgra::ch_config_type_t{0});
     for (auto &in : data_inputs) {
         in.write(cgra::VCGRA::data_input_type_t{0});
     }
 }
 
+#ifndef STREAMING_VCGRA
 void Testbench::stimuli()
 {
 
@@ -218,9 +466,18 @@ void Testbench::stimuli()
     const sc_core::sc_time changePeConfigDelay(6.4, sc_core::SC_US);
     const sc_core::sc_time changeChConfigDelay(6.5, sc_core::SC_US);
 
+#if defined(PACKED_DATAPATH)
+    // The packed run transmits its partial sums as data values
+#elif !defined(FEEDBACK_REGISTERS)
     // Temporary values for output pixel calculation
     cgra::VCGRA::data_output_type_t temp0{};
     cgra::VCGRA::data_output_type_t temp1{};
+    // Channel configuration of the final sum
+    constexpr std::size_t t_finalChConfig{1};
+#else
+    // The final sum reads the temporary values from the feedback registers of the VCGRA
+    constexpr std::size_t t_finalChConfig{2};
+#endif
 
     /*
      * The delay is approximated from the VHDL implementation. It takes
@@ -236,209 +493,392 @@ void Testbench::stimuli()
         return sc_core::sc_time(numbytesA * cDelayPerByte, sc_core::SC_NS);
     };
 
+    // Transmitted data values and configuration bytes
+    std::size_t t_dataValues{0};
+    std::size_t t_configBytes{0};
+
+    auto transmitPeConfig = [&](const std::vector<uint8_t> &peConfA) {
+        pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(peConfA));
+        sc_core::wait(calcDelay(peConfA.size() * sizeof(uint8_t)));
+        sc_core::wait(changePeConfigDelay);
+        t_configBytes += peConfA.size();
+    };
+
+    auto transmitChConfig = [&](const std::vector<uint8_t> &chConfA) {
+        ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(chConfA));
+        sc_core::wait(calcDelay(chConfA.size() * sizeof(uint8_t)));
+        sc_core::wait(changeChConfigDelay);
+        t_configBytes += chConfA.size();
+    };
+
+    auto transmitData = [&](const std::size_t inputA, const data_input_type_t valueA) {
+        data_inputs[inputA].write(valueA);
+        sc_core::wait(calcDelay(sizeof(uint32_t)));
+        ++t_dataValues;
+    };
+
+    // Start execution and wait for ready signal of VCGRA
+    auto execute = [&]() {
+        start.write(true);
+        sc_core::wait(clk.posedge_event());
+        sc_core::wait(clk.posedge_event());
+        start.write(false);
+        sc_core::wait(ready.posedge_event());
+    };
+
+#ifndef PACKED_DATAPATH
+    auto pixel = [this](const size_t y, const size_t x) -> data_input_type_t {
+        return mInputValues.at(y * cInputSize + x);
+    };
+#endif
+
+#ifdef PACKED_DATAPATH
+    // Process one Sobel direction with cPackedLanes pixel windows per input vector
+    auto processDirection = [&](const std::array<int16_t, 3 * 3> &kernelA,
+                                std::array<int16_t, cOutputSize * cOutputSize> &resultsA) {
+        const std::array<std::vector<uint8_t>, 3> t_peConfigs{packedSobelPeConfigurations(kernelA)};
+        const std::array<std::vector<input_vector_t>, 2> t_sums{packedSobelVectors(kernelA)};
+
+        for (size_t t_vector = 0; cPackedVectors > t_vector; ++t_vector) {
+            // Partial sums of the positive and the negative coefficients
+            std::array<data_output_type_t, 2> t_partialSums{};
+            transmitPeConfig(t_peConfigs[0]);
+            transmitChConfig(mChConfigs[0]);
+            for (size_t t_sign = 0; 2 > t_sign; ++t_sign) {
+#ifdef PE_IMMEDIATES
+                if (0 < t_sign) {
+                    transmitPeConfig(t_peConfigs[1]);
+                }
+                for (size_t i = 0; i < 4; ++i) {
+                    transmitData(2 * i + cPixelInput, t_sums[t_sign][t_vector][2 * i + cPixelInput]);
+                }
+#else
+                for (size_t i = 0; i < 8; ++i) {
+                    transmitData(i, t_sums[t_sign][t_vector][i]);
+                }
+#endif
+                execute();
+                t_partialSums[t_sign] = data_outputs[2].read();
+                sc_core::wait(calcDelay(sizeof(uint32_t)));
+            }
+
+            // Saturating differences of the partial sums, the multiplier of the final sum calculates zero
+            std::array<int16_t, 2> t_differences{};
+            transmitPeConfig(t_peConfigs[2]);
+            transmitChConfig(mChConfigs[1]);
+            transmitData(0, 0);
+            transmitData(1, 0);
+            for (size_t t_diff = 0; cPackedDifferences > t_diff; ++t_diff) {
+                transmitData(2, t_partialSums[t_diff]);
+                transmitData(3, t_partialSums[1 - t_diff]);
+                execute();
+                t_differences[t_diff] = static_cast<int16_t>(data_outputs[2].read().to_int());
+                sc_core::wait(calcDelay(sizeof(uint32_t)));
+            }
+
+            storePackedSobelResults(t_vector, t_differences, resultsA);
+        }
+    };
+#else
+    // Process one Sobel direction pixel by pixel
+    auto processDirection = [&](const std::array<int16_t, 3 * 3> &kernelA,
+                                std::array<int16_t, cOutputSize * cOutputSize> &resultsA) {
+        const std::array<std::vector<uint8_t>, 3> t_peConfigs{sobelPeConfigurations(kernelA)};
+
+        for (size_t yiter = 1; yiter < Testbench::cInputSize - 1; ++yiter) {
+            for (size_t xiter = 1; xiter < Testbench::cInputSize - 1; ++xiter) {
+
+                // Transmit configurations for channels and processing elements
+                transmitPeConfig(t_peConfigs[0]);
+                transmitChConfig(mChConfigs[0]);
+
+                // Transmit values for first calculation
+                transmitData(cPixelInput, pixel(yiter - 1, xiter - 1));
+                transmitData(2 + cPixelInput, pixel(yiter - 1, xiter));
+                transmitData(4 + cPixelInput, pixel(yiter - 1, xiter + 1));
+                transmitData(6 + cPixelInput, pixel(yiter, xiter - 1));
+#ifndef PE_IMMEDIATES
+                for (size_t i = 0; i < 4; ++i) {
+                    transmitData(2 * i, kernelA[i]);
+                }
+#endif
+                execute();
+
+#ifndef FEEDBACK_REGISTERS
+                // Read first temporary value
+                temp0 = data_outputs[2].read();
+                sc_core::wait(calcDelay(sizeof(uint32_t)));
+#endif
+
+#ifdef PE_IMMEDIATES
+                // Coefficients of the lower half of the kernel
+                transmitPeConfig(t_peConfigs[1]);
+#endif
+
+                // Transmit values for second calculation
+                transmitData(cPixelInput, pixel(yiter, xiter));
+                transmitData(2 + cPixelInput, pixel(yiter, xiter + 1));
+                transmitData(4 + cPixelInput, pixel(yiter + 1, xiter - 1));
+                transmitData(6 + cPixelInput, pixel(yiter + 1, xiter));
+#ifndef PE_IMMEDIATES
+                for (size_t i = 0; i < 4; ++i) {
+                    transmitData(2 * i, kernelA[4 + i]);
+                }
+#endif
+                execute();
+
+#ifndef FEEDBACK_REGISTERS
+                // Read second temporary value
+                temp1 = data_outputs[2].read();
+                sc_core::wait(calcDelay(sizeof(uint32_t)));
+#endif
+
+                // Transmit configurations for channels and processing elements
+                transmitPeConfig(t_peConfigs[2]);
+                transmitChConfig(mChConfigs[t_finalChConfig]);
+
+                // Transmit values for third calculation
+                transmitData(cPixelInput, pixel(yiter + 1, xiter + 1));
+#ifndef FEEDBACK_REGISTERS
+                transmitData(2, temp0);
+                transmitData(3, temp1);
+#endif
+#ifndef PE_IMMEDIATES
+                transmitData(0, kernelA[8]);
+#endif
+                execute();
+
+                resultsA.at((yiter)*cOutputSize + (xiter)) = static_cast<int16_t>(data_outputs[2].read().to_int());
+                sc_core::wait(calcDelay(sizeof(uint32_t)));
+            }
+        }
+    };
+#endif
+
     auto t_start = sc_core::sc_time_stamp();
     auto t_startSobelx = t_start;
-    for (size_t yiter = 1; yiter < Testbench::cInputSize - 1; ++yiter) {
-        for (size_t xiter = 1; xiter < Testbench::cInputSize - 1; ++xiter) {
-
-            // Transmit configurations for channels and processing elements
-            pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(mPeConfigs, 0));
-            sc_core::wait(calcDelay(mPeConfigs[0].size() * sizeof(uint8_t)));
-            sc_core::wait(changePeConfigDelay);
-            ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(mChConfigs, 0));
-            sc_core::wait(calcDelay(mChConfigs[0].size() * sizeof(uint8_t)));
-            sc_core::wait(changeChConfigDelay);
-
-            // Transmit values for first calculation
-            data_inputs[1].write(mInputValues.at((yiter - 1) * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(mInputValues.at((yiter - 1) * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[5].write(mInputValues.at((yiter - 1) * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[7].write(mInputValues.at(yiter * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobelx[0]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(sobelx[1]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[4].write(sobelx[2]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[6].write(sobelx[3]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
-            sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
-
-            // Read first temporary value
-            temp0 = data_outputs[2].read();
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Transmit values for second calculation
-            data_inputs[1].write(mInputValues.at(yiter * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(mInputValues.at(yiter * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[5].write(mInputValues.at((yiter + 1) * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[7].write(mInputValues.at((yiter + 1) * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobelx[4]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(sobelx[5]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[4].write(sobelx[6]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[6].write(sobelx[7]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
-            sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
-
-            // Read second temporary value
-            temp1 = data_outputs[2].read();
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Transmit configurations for channels and processing elements
-            pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(mPeConfigs, 1));
-            sc_core::wait(calcDelay(mPeConfigs[1].size() * sizeof(uint8_t)));
-            sc_core::wait(changePeConfigDelay);
-            ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(mChConfigs, 1));
-            sc_core::wait(calcDelay(mChConfigs[1].size() * sizeof(uint8_t)));
-            sc_core::wait(changeChConfigDelay);
-
-            // Transmit values for third calculation
-            data_inputs[1].write(mInputValues.at((yiter + 1) * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(temp0);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(temp1);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobelx[8]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
-            sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
+    processDirection(sobelx, mSobelxValues);
+    auto t_stopSobelx = sc_core::sc_time_stamp();
+    auto t_startSobely = t_stopSobelx;
+    processDirection(sobely, mSobelyValues);
+    auto t_stopSobely = sc_core::sc_time_stamp();
+    sc_core::sc_stop();
+
+    auto sqrt_sum = [](const auto &a, const auto &b) -> auto
+    {
+        return std::sqrt(a * a + b * b);
+    };
 
-            mSobelxValues.at((yiter)*cOutputSize + (xiter)) = static_cast<int16_t>(data_outputs[2].read().to_int());
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
+    std::transform(mSobelxValues.cbegin(), mSobelxValues.cend(), mSobelyValues.cbegin(), mResultValues.begin(),
+                   sqrt_sum);
+
+#ifdef PACKED_DATAPATH
+    std::cout << "\n\nScalar reference mismatches (" << cgra::cPackedLanes << " lanes, pixels >> "
+              << cPackedPixelShift << "): "
+              << "\n";
+    std::cout << "sobel x-direction: " << verifyPackedSobel(sobelx, mSobelxValues) << "\n";
+    std::cout << "sobel y-direction: " << verifyPackedSobel(sobely, mSobelyValues) << std::endl;
+#else
+    std::cout << "\n\nFunctional model mismatches (" << cgra::SimdVcgra::instructionSet() << "): "
+              << "\n";
+    std::cout << "sobel x-direction: " << verifyWithFunctionalModel(sobelx, mSobelxValues) << "\n";
+    std::cout << "sobel y-direction: " << verifyWithFunctionalModel(sobely, mSobelyValues) << std::endl;
+#endif
+
+    std::cout << "\n\nSimulation timings: "
+              << "\n";
+    std::cout << "overall: " << (t_stopSobely - t_start).to_string() << "\n";
+    std::cout << "sobel x-direction: " << (t_stopSobelx - t_startSobelx) << "\n";
+    std::cout << "sobel y-direction: " << (t_stopSobely - t_startSobely) << "\n";
+    std::cout << "lower bound per direction (VCGRA only): "
+              << 3 * (cInputSize - 2) * (cInputSize - 2) * cgra::SimdVcgra::cCyclesPerInvocation << " cycles"
+              << std::endl;
+
+    // Without PE_IMMEDIATES, the Sobel coefficients are transmitted as data values for every pixel
+    constexpr size_t t_numOfPixels{2 * (cInputSize - 2) * (cInputSize - 2)};
+    std::cout << "\n\nTransmitted input data: "
+              << "\n";
+    std::cout << "data values: " << t_dataValues << " (" << static_cast<double>(t_dataValues) / t_numOfPixels
+              << " per pixel and direction)\n";
+    std::cout << "configuration bytes: " << t_configBytes << " ("
+              << static_cast<double>(t_configBytes) / t_numOfPixels << " per pixel and direction)" << std::endl;
+}
+#else
+void Testbench::collectResults()
+{
+    ++mCycles;
+
+    if (out_valid.read() && out_ready.read()) {
+        // Each result vector is received in its own clock cycle, also if the VCGRA produces them back to back
+        if (!mStreamResults.empty() && mLastResultCycle + 1 == mCycles) {
+            ++mBackToBackResults;
+        }
+        mLastResultCycle = mCycles;
+        mStreamResults.push_back(static_cast<int16_t>(data_outputs[2].read().to_int()));
+        if (mExpectedResults == mStreamResults.size()) {
+            mResultsComplete.notify(sc_core::SC_ZERO_TIME);
         }
     }
+}
 
-    auto t_stopSobelx = sc_core::sc_time_stamp();
-    auto t_startSobely = t_stopSobelx;
+std::vector<int16_t> Testbench::streamPass(const std::vector<input_vector_t> &vectorsA)
+{
+    mStreamResults.clear();
+    mStreamResults.reserve(vectorsA.size());
+    mExpectedResults = vectorsA.size();
+
+    for (const auto &vector : vectorsA) {
+        std::array<bool, cgra::cInputChannel_NumOfInputs> t_accepted{};
+        for (size_t i = 0; cgra::cInputChannel_NumOfInputs > i; ++i) {
+            data_inputs[i].write(vector[i]);
+            in_valids[i].write(true);
+        }
 
-    for (size_t yiter = 1; yiter < Testbench::cInputSize - 1; ++yiter) {
-        for (size_t xiter = 1; xiter < Testbench::cInputSize - 1; ++xiter) {
-
-            // Transmit configurations for channels and processing elements
-            pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(mPeConfigs, 0));
-            sc_core::wait(calcDelay(mPeConfigs[0].size() * sizeof(uint8_t)));
-            sc_core::wait(changePeConfigDelay);
-            ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(mChConfigs, 0));
-            sc_core::wait(calcDelay(mChConfigs[0].size() * sizeof(uint8_t)));
-            sc_core::wait(changeChConfigDelay);
-
-            // Transmit values for first calculation
-            data_inputs[1].write(mInputValues.at((yiter - 1) * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(mInputValues.at((yiter - 1) * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[5].write(mInputValues.at((yiter - 1) * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[7].write(mInputValues.at(yiter * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobely[0]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(sobely[1]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[4].write(sobely[2]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[6].write(sobely[3]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
-            sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
-
-            // Read first temporary value
-            temp0 = data_outputs[2].read();
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Transmit values for second calculation
-            data_inputs[1].write(mInputValues.at(yiter * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(mInputValues.at(yiter * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[5].write(mInputValues.at((yiter + 1) * cInputSize + (xiter - 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[7].write(mInputValues.at((yiter + 1) * cInputSize + xiter));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobely[4]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(sobely[5]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[4].write(sobely[6]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[6].write(sobely[7]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
+        // Every lane completes its handshake on its own
+        while (!std::all_of(t_accepted.cbegin(), t_accepted.cend(), [](const bool acceptedA) { return acceptedA; })) {
             sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
-
-            // Read second temporary value
-            temp1 = data_outputs[2].read();
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Transmit configurations for channels and processing elements
-            pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(mPeConfigs, 1));
-            sc_core::wait(calcDelay(mPeConfigs[1].size() * sizeof(uint8_t)));
-            sc_core::wait(changePeConfigDelay);
-            ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(mChConfigs, 1));
-            sc_core::wait(calcDelay(mChConfigs[1].size() * sizeof(uint8_t)));
-            sc_core::wait(changeChConfigDelay);
-
-            // Transmit values for third calculation
-            data_inputs[1].write(mInputValues.at((yiter + 1) * cInputSize + (xiter + 1)));
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[2].write(temp0);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[3].write(temp1);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-            data_inputs[0].write(sobely[8]);
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
-
-            // Start execution and wait for ready signal of VCGRA
-            start.write(true);
-            sc_core::wait(clk.posedge_event());
-            sc_core::wait(clk.posedge_event());
-            start.write(false);
-            sc_core::wait(ready.posedge_event());
-
-            mSobelyValues.at((yiter)*cOutputSize + (xiter)) = static_cast<int16_t>(data_outputs[2].read().to_int());
-            sc_core::wait(calcDelay(sizeof(uint32_t)));
+            for (size_t i = 0; cgra::cInputChannel_NumOfInputs > i; ++i) {
+                if (!t_accepted[i] && in_readys[i].read()) {
+                    t_accepted[i] = true;
+                    in_valids[i].write(false);
+                }
+            }
         }
     }
 
+    if (mExpectedResults > mStreamResults.size()) {
+        sc_core::wait(mResultsComplete);
+    }
+
+    return mStreamResults;
+}
+
+void Testbench::streamStimuli()
+{
+    // Time delay for switching to new configuration.
+    const sc_core::sc_time changePeConfigDelay(6.4, sc_core::SC_US);
+    const sc_core::sc_time changeChConfigDelay(6.5, sc_core::SC_US);
+
+    constexpr size_t t_numOfWindows{(cInputSize - 2) * (cInputSize - 2)};
+
+    auto configure = [&](const std::vector<uint8_t> &peConfA, const std::size_t chIndexA) {
+        pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(peConfA));
+        sc_core::wait(changePeConfigDelay);
+        ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(mChConfigs.at(chIndexA)));
+        sc_core::wait(changeChConfigDelay);
+    };
+
+#ifndef PACKED_DATAPATH
+    auto pixel = [this](const size_t y, const size_t x) -> data_input_type_t {
+        return mInputValues.at(y * cInputSize + x);
+    };
+#endif
+
+#ifdef PACKED_DATAPATH
+    // Process one Sobel direction with cPackedLanes pixel windows per input vector
+    auto processDirection = [&](const std::array<int16_t, 3 * 3> &kernelA,
+                                std::array<int16_t, cOutputSize * cOutputSize> &resultsA) -> uint64_t {
+        const uint64_t t_startCycles{mCycles};
+        const std::array<std::vector<uint8_t>, 3> t_peConfigs{packedSobelPeConfigurations(kernelA)};
+        const std::array<std::vector<input_vector_t>, 2> t_sums{packedSobelVectors(kernelA)};
+        mBackToBackResults = 0;
+
+        // Partial sums of the positive and the negative coefficients
+        configure(t_peConfigs[0], 0);
+        const std::vector<int16_t> t_positive{streamPass(t_sums[0])};
+#ifdef PE_IMMEDIATES
+        configure(t_peConfigs[1], 0);
+#endif
+        const std::vector<int16_t> t_negative{streamPass(t_sums[1])};
+
+        // Saturating differences of the partial sums, the multiplier of the final sum calculates zero
+        std::array<std::vector<int16_t>, 2> t_differences;
+        configure(t_peConfigs[2], 1);
+        for (size_t t_diff = 0; cPackedDifferences > t_diff; ++t_diff) {
+            std::vector<input_vector_t> t_vectors(cPackedVectors);
+            for (size_t t_vector = 0; cPackedVectors > t_vector; ++t_vector) {
+                t_vectors[t_vector][2] = (0 == t_diff) ? t_positive[t_vector] : t_negative[t_vector];
+                t_vectors[t_vector][3] = (0 == t_diff) ? t_negative[t_vector] : t_positive[t_vector];
+            }
+            t_differences[t_diff] = streamPass(t_vectors);
+        }
+
+        for (size_t t_vector = 0; cPackedVectors > t_vector; ++t_vector) {
+            storePackedSobelResults(t_vector,
+                                    {t_differences[0][t_vector],
+                                     (1 < cPackedDifferences) ? t_differences[1][t_vector] : int16_t{0}},
+                                    resultsA);
+        }
+
+        return mCycles - t_startCycles;
+    };
+#else
+    // Process one Sobel direction and return the number of clock cycles
+    auto processDirection = [&](const std::array<int16_t, 3 * 3> &kernelA,
+                                std::array<int16_t, cOutputSize * cOutputSize> &resultsA) -> uint64_t {
+        const uint64_t t_startCycles{mCycles};
+        const std::array<std::vector<uint8_t>, 3> t_peConfigs{sobelPeConfigurations(kernelA)};
+        mBackToBackResults = 0;
+
+        std::vector<input_vector_t> t_upper(t_numOfWindows);
+        std::vector<input_vector_t> t_lower(t_numOfWindows);
+        for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+            const size_t yiter = t_window / (cInputSize - 2) + 1;
+            const size_t xiter = t_window % (cInputSize - 2) + 1;
+            t_upper[t_window][cPixelInput] = pixel(yiter - 1, xiter - 1);
+            t_upper[t_window][2 + cPixelInput] = pixel(yiter - 1, xiter);
+            t_upper[t_window][4 + cPixelInput] = pixel(yiter - 1, xiter + 1);
+            t_upper[t_window][6 + cPixelInput] = pixel(yiter, xiter - 1);
+            t_lower[t_window][cPixelInput] = pixel(yiter, xiter);
+            t_lower[t_window][2 + cPixelInput] = pixel(yiter, xiter + 1);
+            t_lower[t_window][4 + cPixelInput] = pixel(yiter + 1, xiter - 1);
+            t_lower[t_window][6 + cPixelInput] = pixel(yiter + 1, xiter);
+#ifndef PE_IMMEDIATES
+            for (size_t i = 0; i < 4; ++i) {
+                t_upper[t_window][2 * i] = kernelA[i];
+                t_lower[t_window][2 * i] = kernelA[4 + i];
+            }
+#endif
+        }
+
+        configure(t_peConfigs[0], 0);
+        const std::vector<int16_t> t_temp0{streamPass(t_upper)};
+#ifdef PE_IMMEDIATES
+        configure(t_peConfigs[1], 0);
+#endif
+        const std::vector<int16_t> t_temp1{streamPass(t_lower)};
+
+        // Unused lanes keep the values of the second pass like the functional model
+        std::vector<input_vector_t> t_final{t_lower};
+        for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+            const size_t yiter = t_window / (cInputSize - 2) + 1;
+            const size_t xiter = t_window % (cInputSize - 2) + 1;
+#ifndef PE_IMMEDIATES
+            t_final[t_window][0] = kernelA[8];
+#endif
+            t_final[t_window][cPixelInput] = pixel(yiter + 1, xiter + 1);
+            t_final[t_window][2] = t_temp0[t_window];
+            t_final[t_window][3] = t_temp1[t_window];
+        }
+
+        configure(t_peConfigs[2], 1);
+        const std::vector<int16_t> t_results{streamPass(t_final)};
+        for (size_t t_window = 0; t_numOfWindows > t_window; ++t_window) {
+            const size_t yiter = t_window / (cInputSize - 2) + 1;
+            const size_t xiter = t_window % (cInputSize - 2) + 1;
+            resultsA.at(yiter * cOutputSize + xiter) = t_results[t_window];
+        }
+
+        return mCycles - t_startCycles;
+    };
+#endif
+
+    auto t_start = sc_core::sc_time_stamp();
+    const uint64_t t_cyclesSobelx{processDirection(sobelx, mSobelxValues)};
+    const std::size_t t_backToBackSobelx{mBackToBackResults};
+    auto t_stopSobelx = sc_core::sc_time_stamp();
+    const uint64_t t_cyclesSobely{processDirection(sobely, mSobelyValues)};
+    const std::size_t t_backToBackSobely{mBackToBackResults};
     auto t_stopSobely = sc_core::sc_time_stamp();
     sc_core::sc_stop();
 
@@ -450,11 +890,35 @@ void Testbench::stimuli()
     std::transform(mSobelxValues.cbegin(), mSobelxValues.cend(), mSobelyValues.cbegin(), mResultValues.begin(),
                    sqrt_sum);
 
-    std::cout << "\n\nSimulation timings: "
+#ifdef PACKED_DATAPATH
+    std::cout << "\n\nScalar reference mismatches (" << cgra::cPackedLanes << " lanes, pixels >> "
+              << cPackedPixelShift << "): "
+              << "\n";
+    std::cout << "sobel x-direction: " << verifyPackedSobel(sobelx, mSobelxValues) << "\n";
+    std::cout << "sobel y-direction: " << verifyPackedSobel(sobely, mSobelyValues) << std::endl;
+#else
+    std::cout << "\n\nFunctional model mismatches (" << cgra::SimdVcgra::instructionSet() << "): "
+              << "\n";
+    std::cout << "sobel x-direction: " << verifyWithFunctionalModel(sobelx, mSobelxValues) << "\n";
+    std::cout << "sobel y-direction: " << verifyWithFunctionalModel(sobely, mSobelyValues) << std::endl;
+#endif
+
+    std::cout << "\n\nSimulation timings (streaming): "
               << "\n";
     std::cout << "overall: " << (t_stopSobely - t_start).to_string() << "\n";
-    std::cout << "sobel x-direction: " << (t_stopSobelx - t_startSobelx) << "\n";
-    std::cout << "sobel y-direction: " << (t_stopSobely - t_startSobely) << std::endl;
+    std::cout << "sobel x-direction: " << (t_stopSobelx - t_start) << " (" << t_cyclesSobelx << " cycles, "
+              << static_cast<double>(t_numOfWindows) / t_cyclesSobelx << " pixels/cycle)\n";
+    std::cout << "sobel y-direction: " << (t_stopSobely - t_stopSobelx) << " (" << t_cyclesSobely << " cycles, "
+              << static_cast<double>(t_numOfWindows) / t_cyclesSobely << " pixels/cycle)\n";
+    std::cout << "upper bound per direction (VCGRA only): "
+              << 1.0 / (3 * cgra::StreamingVCGRA::cInitiationInterval) << " pixels/cycle" << std::endl;
+
+    // With PIPELINED_PE, all but the first result of each of the three passes follow their predecessor directly
+    std::cout << "\nBack-to-back results (of " << 3 * t_numOfWindows << " per direction): "
+              << "\n";
+    std::cout << "sobel x-direction: " << t_backToBackSobelx << "\n";
+    std::cout << "sobel y-direction: " << t_backToBackSobely << std::endl;
 }
+#endif
 
 } // namespace cgra
@@ -0,0 +1,117 @@
+/*
+ * testbench_vcgra_scaling.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "testbench_vcgra_scaling.hpp"
+#include "WorkloadGenerator.hpp"
+#include <limits>
+#include <random>
+
+#ifdef GSYSC
+#include <gsysc.h>
+#include "utils.hpp"
+#endif
+
+namespace
+{
+
+/**
+ * @brief Create configuration bitvector from byte array
+ *
+ * @tparam bw   Bitwidth of target bitvector
+ * @param[in] configA   Input configuration byte array
+ * @return cgra::config_vector_t<bw>     Vector with configuration
+ */
+template <uint32_t bw> auto prepareConfig(const std::vector<uint8_t> &configA) -> cgra::config_vector_t<bw>
+{
+
+    cgra::config_vector_t<bw> config{0};
+    for (auto value : configA) {
+        config <<= sizeof(value) * 8;
+        config |= value;
+    }
+
+    return config;
+}
+
+} // namespace
+
+namespace cgra
+{
+
+ScalingTestbench::ScalingTestbench(const sc_core::sc_module_name &nameA, const std::size_t numVectorsA)
+    : sc_core::sc_module(nameA), mNumVectors(numVectorsA)
+{
+    if (0 == mNumVectors) {
+        throw std::invalid_argument("Number of input vectors is zero.");
+    }
+
+    SC_THREAD(stimuli);
+    SC_METHOD(countCycles);
+    sensitive << clk.pos();
+    dont_initialize();
+}
+
+void ScalingTestbench::end_of_elaboration()
+{
+    rst.write(true);
+    start.write(false);
+    pe_config.write(cgra::pe_config_type_t{0});
+    ch_config.write(cgra::ch_config_type_t{0});
+    for (auto &in : data_inputs) {
+        in.write(cgra::VCGRA::data_input_type_t{0});
+    }
+}
+
+void ScalingTestbench::countCycles()
+{
+    ++mCycles;
+}
+
+void ScalingTestbench::stimuli()
+{
+    const std::vector<uint8_t> t_peConfig{cgra::generateScalingPeConfiguration()};
+    const std::vector<uint8_t> t_chConfig{cgra::generateScalingChConfiguration()};
+    cgra::FunctionalVcgra t_model{t_peConfig, t_chConfig};
+
+    std::mt19937 t_generator{0x5CA1AB1E};
+    std::uniform_int_distribution<int32_t> t_distribution{std::numeric_limits<value_type_t>::min(),
+                                                          std::numeric_limits<value_type_t>::max()};
+    std::array<value_type_t, cgra::FunctionalVcgra::cNumOfInputs> t_inputs{};
+    std::array<value_type_t, cgra::FunctionalVcgra::cNumOfOutputs> t_expected{};
+
+    // Configure the VCGRA once, the configurations are applied with the next clock edges
+    pe_config.write(prepareConfig<cgra::cPeConfigBitWidth>(t_peConfig));
+    ch_config.write(prepareConfig<cgra::cVChConfigBitWidth>(t_chConfig));
+    sc_core::wait(clk.posedge_event());
+    sc_core::wait(clk.posedge_event());
+
+    const uint64_t t_firstCycle{mCycles};
+    for (; mNumVectors > mProcessedVectors; ++mProcessedVectors) {
+        for (std::size_t t_input = 0; t_inputs.size() > t_input; ++t_input) {
+            t_inputs[t_input] = static_cast<value_type_t>(t_distribution(t_generator));
+            data_inputs[t_input].write(data_input_type_t{t_inputs[t_input]});
+        }
+
+        // Start execution and wait for ready signal of VCGRA
+        start.write(true);
+        sc_core::wait(clk.posedge_event());
+        sc_core::wait(clk.posedge_event());
+        start.write(false);
+        sc_core::wait(ready.posedge_event());
+
+        t_model.evaluate(t_inputs.data(), t_expected.data());
+        for (std::size_t t_output = 0; t_expected.size() > t_output; ++t_output) {
+            if (static_cast<value_type_t>(data_outputs[t_output].read().to_int()) != t_expected[t_output]) {
+                ++mMismatches;
+            }
+        }
+    }
+    mExecutionCycles = mCycles - t_firstCycle;
+
+    sc_core::sc_stop();
+}
+
+} // namespace cgra
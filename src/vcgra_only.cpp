@@ -6,6 +6,9 @@
  */
 
 #include "testbench_vcgra_only.hpp"
+#include "PeConfiguration.hpp"
+#include "ChConfiguration.hpp"
+#include "MonolithicVCGRA.h"
 #include <systemc>
 #include <type_traits>
 #include <fstream>
@@ -21,13 +24,18 @@ const std::vector<std::vector<uint8_t>> cPeConfigs = {
     {0x33, 0x33, 0x01, 0x01, 0x00, 0x10, 0x00, 0x80},
     {0x38, 0x80, 0x01, 0x80, 0x00, 0x10, 0x00, 0x80},
 };
-//! Vector of PE configurations
+//! Vector of PE configurations (operation codes only)
 
 const std::vector<std::vector<uint8_t>> cChConfigs = {
     {0x05, 0x39, 0x77, 0x01, 0xAB, 0x05, 0x7F, 0x05, 0xAF, 0xB0},
     {0x05, 0x26, 0xE4, 0x01, 0xAF, 0x05, 0x6F, 0x05, 0xAF, 0xB0},
 };
-//! Vector of channel configurations
+//! Vector of channel configurations (without feedback registers)
+
+// The hand-written configurations address PEs, VirtualChannel selects and data outputs
+// of the default topology, use vcgra_scaling for other topologies
+static_assert(cgra::calc_isTopology(cgra::cPeLevels, cgra::cDefaultTopology),
+              "The Sobel configuration of vcgra_only needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
 
 } // namespace
 
@@ -54,7 +62,11 @@ std::vector<char*> gsysc_renaming_strings{};
 auto sc_main(int argc, char ** argv) -> int
 {
     cgra::Testbench testbench("vcgra_testbench", "../demo/lena.pgm");
-    cgra::VCGRA vcgra("VCGRA_Instance");
+#ifndef STREAMING_VCGRA
+    cgra::vcgra_type_t vcgra("VCGRA_Instance");
+#else
+    cgra::StreamingVCGRA vcgra("VCGRA_Instance");
+#endif
 #ifdef GSYSC
     REG_MODULE(&vcgra, const_cast<char*>(vcgra.basename()), nullptr);
     REG_MODULE(&testbench, const_cast<char*>(testbench.basename()), nullptr);
@@ -62,19 +74,39 @@ auto sc_main(int argc, char ** argv) -> int
 
     // Load configurations into testbench
     for (const auto &peConf : cPeConfigs) {
-        testbench.appendPeConfiguration(peConf);
+        testbench.appendPeConfiguration(cgra::expandPeConfiguration(peConf));
     }
 
     for (const auto &chConf : cChConfigs) {
-        testbench.appendChConfiguration(chConf);
+        testbench.appendChConfiguration(cgra::expandChConfiguration(chConf));
     }
 
+#if defined(FEEDBACK_REGISTERS) && !defined(STREAMING_VCGRA)
+    // Final sum which reads the partial sums of the two previous invocations
+    // (data output 2) from the feedback registers instead of data inputs 2 and 3
+    auto t_feedbackChConf = cgra::expandChConfiguration(cChConfigs.at(1));
+    cgra::setInputFeedback(t_feedbackChConf, 2, 1, 2);
+    cgra::setInputFeedback(t_feedbackChConf, 3, 1, 2);
+    cgra::setInputFeedback(t_feedbackChConf, 4, 0, 2);
+    cgra::setInputFeedback(t_feedbackChConf, 5, 0, 2);
+    testbench.appendChConfiguration(t_feedbackChConf);
+#endif
+
 #ifndef GSYSC
     // Signals
     sc_core::sc_clock s_clk("clk", 200, sc_core::SC_NS);
+#ifndef STREAMING_VCGRA
     sc_core::sc_signal<cgra::start_type_t> s_start("start");
-    sc_core::sc_signal<cgra::reset_type_t> s_rst("rst");
     sc_core::sc_signal<cgra::ready_type_t> s_ready("ready");
+#else
+    sc_core::sc_vector<sc_core::sc_signal<cgra::StreamingVCGRA::handshake_type_t>> s_inValids("inValids",
+                                                                                            vcgra.in_valids.size());
+    sc_core::sc_vector<sc_core::sc_signal<cgra::StreamingVCGRA::handshake_type_t>> s_inReadys("inReadys",
+                                                                                            vcgra.in_readys.size());
+    sc_core::sc_signal<cgra::StreamingVCGRA::handshake_type_t> s_outValid("outValid");
+    sc_core::sc_signal<cgra::StreamingVCGRA::handshake_type_t> s_outReady("outReady");
+#endif
+    sc_core::sc_signal<cgra::reset_type_t> s_rst("rst");
     sc_core::sc_signal<cgra::pe_config_type_t> s_peConfig("peConfig");
     sc_core::sc_signal<cgra::ch_config_type_t> s_chConfig("chConfig");
     sc_core::sc_vector<sc_core::sc_signal<cgra::VCGRA::data_input_type_t>> s_inputs("inputs", vcgra.data_inputs.size());
@@ -83,9 +115,16 @@ auto sc_main(int argc, char ** argv) -> int
 #else
     // Signals
     sc_clock s_clk("clk", 200, SC_NS);
+#ifndef STREAMING_VCGRA
     sc_signal<cgra::start_type_t> s_start("start");
-    sc_signal<cgra::reset_type_t> s_rst("rst");
     sc_signal<cgra::ready_type_t> s_ready("ready");
+#else
+    sc_vector<sc_signal<cgra::StreamingVCGRA::handshake_type_t>> s_inValids("inValids", vcgra.in_valids.size());
+    sc_vector<sc_signal<cgra::StreamingVCGRA::handshake_type_t>> s_inReadys("inReadys", vcgra.in_readys.size());
+    sc_signal<cgra::StreamingVCGRA::handshake_type_t> s_outValid("outValid");
+    sc_signal<cgra::StreamingVCGRA::handshake_type_t> s_outReady("outReady");
+#endif
+    sc_signal<cgra::reset_type_t> s_rst("rst");
     sc_signal<cgra::pe_config_type_t> s_peConfig("peConfig");
     sc_signal<cgra::ch_config_type_t> s_chConfig("chConfig");
     sc_vector<sc_signal<cgra::VCGRA::data_input_type_t>> s_inputs("inputs", vcgra.data_inputs.size());
@@ -100,12 +139,19 @@ auto sc_main(int argc, char ** argv) -> int
     testbench.pe_config.bind(s_peConfig);
     vcgra.ch_config.bind(s_chConfig);
     testbench.ch_config.bind(s_chConfig);
-    vcgra.start.bind(s_start);
-    testbench.start.bind(s_start);
     vcgra.rst.bind(s_rst);
     testbench.rst.bind(s_rst);
+#ifndef STREAMING_VCGRA
+    vcgra.start.bind(s_start);
+    testbench.start.bind(s_start);
     testbench.ready.bind(s_ready);
     vcgra.ready.bind(s_ready);
+#else
+    vcgra.out_valid.bind(s_outValid);
+    testbench.out_valid.bind(s_outValid);
+    vcgra.out_ready.bind(s_outReady);
+    testbench.out_ready.bind(s_outReady);
+#endif
 
 #ifdef GSYSC
     RENAME_SIGNAL(&s_clk,
@@ -114,12 +160,19 @@ auto sc_main(int argc, char ** argv) -> int
         (cgra::create_name<std::string,uint32_t>("s_peConfig_", 0)));
     RENAME_SIGNAL(&s_chConfig,
         (cgra::create_name<std::string,uint32_t>("s_chConfig_", 0)));
-    RENAME_SIGNAL(&s_start,
-        (cgra::create_name<std::string,uint32_t>("s_start_", 0)));
     RENAME_SIGNAL(&s_rst,
         (cgra::create_name<std::string,uint32_t>("s_rst_", 0)));
+#ifndef STREAMING_VCGRA
+    RENAME_SIGNAL(&s_start,
+        (cgra::create_name<std::string,uint32_t>("s_start_", 0)));
     RENAME_SIGNAL(&s_ready,
         (cgra::create_name<std::string,uint32_t>("s_ready_", 0)));
+#else
+    RENAME_SIGNAL(&s_outValid,
+        (cgra::create_name<std::string,uint32_t>("s_outValid_", 0)));
+    RENAME_SIGNAL(&s_outReady,
+        (cgra::create_name<std::string,uint32_t>("s_outReady_", 0)));
+#endif
 
     REG_PORT(&vcgra.clk,           &vcgra,     &s_clk);
     REG_PORT(&testbench.clk,       &testbench, &s_clk);
@@ -127,12 +180,19 @@ auto sc_main(int argc, char ** argv) -> int
     REG_PORT(&testbench.pe_config, &testbench, &s_peConfig);
     REG_PORT(&vcgra.ch_config,     &vcgra,     &s_chConfig);
     REG_PORT(&testbench.ch_config, &testbench, &s_chConfig);
-    REG_PORT(&vcgra.start,         &vcgra,     &s_start);
-    REG_PORT(&testbench.start,     &testbench, &s_start);
     REG_PORT(&vcgra.rst,           &vcgra,     &s_rst);
     REG_PORT(&testbench.rst,       &testbench, &s_rst);
+#ifndef STREAMING_VCGRA
+    REG_PORT(&vcgra.start,         &vcgra,     &s_start);
+    REG_PORT(&testbench.start,     &testbench, &s_start);
     REG_PORT(&testbench.ready,     &testbench, &s_ready);
     REG_PORT(&vcgra.ready,         &vcgra,     &s_ready);
+#else
+    REG_PORT(&vcgra.out_valid,     &vcgra,     &s_outValid);
+    REG_PORT(&testbench.out_valid, &testbench, &s_outValid);
+    REG_PORT(&vcgra.out_ready,     &vcgra,     &s_outReady);
+    REG_PORT(&testbench.out_ready, &testbench, &s_outReady);
+#endif
 #endif
 
     for (std::size_t iter = 0; iter < vcgra.data_inputs.size(); ++iter) {
@@ -141,6 +201,18 @@ auto sc_main(int argc, char ** argv) -> int
 #ifdef GSYSC
         REG_PORT(&vcgra.data_inputs.at(iter), &vcgra, &s_inputs.at(iter));
         REG_PORT(&testbench.data_inputs.at(iter), &testbench, &s_inputs.at(iter));
+#endif
+#ifdef STREAMING_VCGRA
+        vcgra.in_valids.at(iter).bind(s_inValids.at(iter));
+        testbench.in_valids.at(iter).bind(s_inValids.at(iter));
+        vcgra.in_readys.at(iter).bind(s_inReadys.at(iter));
+        testbench.in_readys.at(iter).bind(s_inReadys.at(iter));
+#ifdef GSYSC
+        REG_PORT(&vcgra.in_valids.at(iter), &vcgra, &s_inValids.at(iter));
+        REG_PORT(&testbench.in_valids.at(iter), &testbench, &s_inValids.at(iter));
+        REG_PORT(&vcgra.in_readys.at(iter), &vcgra, &s_inReadys.at(iter));
+        REG_PORT(&testbench.in_readys.at(iter), &testbench, &s_inReadys.at(iter));
+#endif
 #endif
     }
 
@@ -160,8 +232,19 @@ auto sc_main(int argc, char ** argv) -> int
     sc_core::sc_trace(file_ptr, s_peConfig, s_peConfig.basename());
     sc_core::sc_trace(file_ptr, s_chConfig, s_chConfig.basename());
     sc_core::sc_trace(file_ptr, s_rst, s_rst.basename());
+#ifndef STREAMING_VCGRA
     sc_core::sc_trace(file_ptr, s_ready, s_ready.basename());
     sc_core::sc_trace(file_ptr, s_start, s_start.basename());
+#else
+    sc_core::sc_trace(file_ptr, s_outValid, s_outValid.basename());
+    sc_core::sc_trace(file_ptr, s_outReady, s_outReady.basename());
+    for (const auto &valid : s_inValids) {
+        sc_core::sc_trace(file_ptr, valid, valid.basename());
+    }
+    for (const auto &ready : s_inReadys) {
+        sc_core::sc_trace(file_ptr, ready, ready.basename());
+    }
+#endif
     for (const auto &in : s_inputs) {
         sc_core::sc_trace(file_ptr, in, in.basename());
     }
@@ -10,6 +10,8 @@
  */
 
 #include "Testbench_VcgraPreloaders.hpp"
+#include "PeConfiguration.hpp"
+#include "ChConfiguration.hpp"
 #include <systemc>
 #include <type_traits>
 #include <fstream>
@@ -45,13 +47,18 @@ const std::vector<std::vector<uint8_t>> cPeConfigs = {
     {0x33, 0x33, 0x01, 0x01, 0x00, 0x10, 0x00, 0x80},
     {0x38, 0x80, 0x01, 0x80, 0x00, 0x10, 0x00, 0x80},
 };
-//! Vector of PE configurations
+//! Vector of PE configurations (operation codes only)
 
 const std::vector<std::vector<uint8_t>> cChConfigs = {
     {0x05, 0x39, 0x77, 0x01, 0xAB, 0x05, 0x7F, 0x05, 0xAF, 0xB0},
     {0x05, 0x26, 0xE4, 0x01, 0xAF, 0x05, 0x6F, 0x05, 0xAF, 0xB0},
 };
-//! Vector of channel configurations
+//! Vector of channel configurations (without feedback registers)
+
+// The hand-written configurations address PEs, VirtualChannel selects and data outputs
+// of the default topology, use vcgra_scaling for other topologies
+static_assert(cgra::calc_isTopology(cgra::cPeLevels, cgra::cDefaultTopology),
+              "The Sobel configuration of vcgra_prefetchers needs the default topology VCGRA_PE_LEVELS=4,4,4,4");
 
 /**
  * @brief Bind signals of vectors
@@ -91,11 +98,11 @@ int sc_main(int argc, char **argv)
 
     // Load configurations into testbench
     for (auto &peConf : cPeConfigs) {
-        testbench.appendPeConfiguration(peConf);
+        testbench.appendPeConfiguration(cgra::expandPeConfiguration(peConf));
     }
 
     for (auto &chConf : cChConfigs) {
-        testbench.appendChConfiguration(chConf);
+        testbench.appendChConfiguration(cgra::expandChConfiguration(chConf));
     }
 
     // Signals
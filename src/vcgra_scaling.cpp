@@ -0,0 +1,157 @@
+/*
+ * vcgra_scaling.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "testbench_vcgra_scaling.hpp"
+#include "MonolithicVCGRA.h"
+#include <systemc>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <fstream>
+
+#ifdef GSYSC
+#include <gsysc.h>
+#endif
+
+#ifdef GSYSC
+namespace cgra {
+//gSysC renaming vector
+//--------------------------------------------------
+
+/*!
+ * \var gsysc_renaming_strings
+ *
+ * \brief Stored pointer to strings for port and signal renaming
+ *
+ * \details
+ * gSysC ports and signals store its corresponding name as a pointer to a char-array.
+ * If a string name needs to be constructed dynamically, it needs to be stored somewhere during
+ * simulation run. The strings are constructed on the heap and the pointer to the char-arrays
+ * are stored within this vector. They are deleted at the end of the simulation run.
+ */
+std::vector<char*> gsysc_renaming_strings{};
+}
+#endif
+
+/*!
+ * \brief Measure throughput and simulation speed of the VCGRA topology of this build
+ *
+ * \details
+ * The topology is selected with the CMake option VCGRA_PE_LEVELS. The first
+ * command line argument is the number of input vectors (default: 10000).
+ */
+auto sc_main(int argc, char ** argv) -> int
+{
+    const std::size_t t_numVectors{1 < argc ? std::stoul(argv[1]) : 10000U};
+
+    cgra::ScalingTestbench testbench("vcgra_scaling_testbench", t_numVectors);
+    cgra::vcgra_type_t vcgra("VCGRA_Instance");
+#ifdef GSYSC
+    REG_MODULE(&vcgra, const_cast<char*>(vcgra.basename()), nullptr);
+    REG_MODULE(&testbench, const_cast<char*>(testbench.basename()), nullptr);
+#endif
+
+#ifndef GSYSC
+    // Signals
+    sc_core::sc_clock s_clk("clk", 200, sc_core::SC_NS);
+    sc_core::sc_signal<cgra::start_type_t> s_start("start");
+    sc_core::sc_signal<cgra::ready_type_t> s_ready("ready");
+    sc_core::sc_signal<cgra::reset_type_t> s_rst("rst");
+    sc_core::sc_signal<cgra::pe_config_type_t> s_peConfig("peConfig");
+    sc_core::sc_signal<cgra::ch_config_type_t> s_chConfig("chConfig");
+    sc_core::sc_vector<sc_core::sc_signal<cgra::VCGRA::data_input_type_t>> s_inputs("inputs", vcgra.data_inputs.size());
+    sc_core::sc_vector<sc_core::sc_signal<cgra::VCGRA::data_output_type_t>> s_outputs("outputs",
+                                                                                      vcgra.data_outputs.size());
+#else
+    // Signals
+    sc_clock s_clk("clk", 200, SC_NS);
+    sc_signal<cgra::start_type_t> s_start("start");
+    sc_signal<cgra::ready_type_t> s_ready("ready");
+    sc_signal<cgra::reset_type_t> s_rst("rst");
+    sc_signal<cgra::pe_config_type_t> s_peConfig("peConfig");
+    sc_signal<cgra::ch_config_type_t> s_chConfig("chConfig");
+    sc_vector<sc_signal<cgra::VCGRA::data_input_type_t>> s_inputs("inputs", vcgra.data_inputs.size());
+    sc_vector<sc_signal<cgra::VCGRA::data_output_type_t>> s_outputs("outputs", vcgra.data_outputs.size());
+#endif
+
+    // Connect toplevel and testbench
+    vcgra.clk.bind(s_clk);
+    testbench.clk.bind(s_clk);
+    vcgra.pe_config.bind(s_peConfig);
+    testbench.pe_config.bind(s_peConfig);
+    vcgra.ch_config.bind(s_chConfig);
+    testbench.ch_config.bind(s_chConfig);
+    vcgra.rst.bind(s_rst);
+    testbench.rst.bind(s_rst);
+    vcgra.start.bind(s_start);
+    testbench.start.bind(s_start);
+    testbench.ready.bind(s_ready);
+    vcgra.ready.bind(s_ready);
+
+#ifdef GSYSC
+    REG_PORT(&vcgra.clk,           &vcgra,     &s_clk);
+    REG_PORT(&testbench.clk,       &testbench, &s_clk);
+    REG_PORT(&vcgra.pe_config,     &vcgra,     &s_peConfig);
+    REG_PORT(&testbench.pe_config, &testbench, &s_peConfig);
+    REG_PORT(&vcgra.ch_config,     &vcgra,     &s_chConfig);
+    REG_PORT(&testbench.ch_config, &testbench, &s_chConfig);
+    REG_PORT(&vcgra.rst,           &vcgra,     &s_rst);
+    REG_PORT(&testbench.rst,       &testbench, &s_rst);
+    REG_PORT(&vcgra.start,         &vcgra,     &s_start);
+    REG_PORT(&testbench.start,     &testbench, &s_start);
+    REG_PORT(&testbench.ready,     &testbench, &s_ready);
+    REG_PORT(&vcgra.ready,         &vcgra,     &s_ready);
+#endif
+
+    for (std::size_t iter = 0; iter < vcgra.data_inputs.size(); ++iter) {
+        vcgra.data_inputs.at(iter).bind(s_inputs.at(iter));
+        testbench.data_inputs.at(iter).bind(s_inputs.at(iter));
+#ifdef GSYSC
+        REG_PORT(&vcgra.data_inputs.at(iter), &vcgra, &s_inputs.at(iter));
+        REG_PORT(&testbench.data_inputs.at(iter), &testbench, &s_inputs.at(iter));
+#endif
+    }
+
+    for (std::size_t iter = 0; iter < vcgra.data_outputs.size(); ++iter) {
+        vcgra.data_outputs.at(iter).bind(s_outputs.at(iter));
+        testbench.data_outputs.at(iter).bind(s_outputs.at(iter));
+#ifdef GSYSC
+        REG_PORT(&vcgra.data_outputs.at(iter), &vcgra, &s_outputs.at(iter));
+        REG_PORT(&testbench.data_outputs.at(iter), &testbench, &s_outputs.at(iter));
+#endif
+    }
+
+    // Start simulation, no trace file to measure the simulation kernel only
+    const auto t_wallClockStart = std::chrono::steady_clock::now();
+#ifndef GSYSC
+    sc_core::sc_start();
+#else
+    sc_start();
+#endif
+    const std::chrono::duration<double> t_wallClock{std::chrono::steady_clock::now() - t_wallClockStart};
+
+    const double t_cycles{static_cast<double>(testbench.executionCycles())};
+    const double t_vectors{static_cast<double>(testbench.processedVectors())};
+
+    std::cout << "\n\nTopology: " << cgra::cNumOfLevels << " levels, " << cgra::cNumOfPe << " PEs, "
+              << cgra::cInputChannel_NumOfInputs << " data inputs, " << cgra::cPeLevels.back() << " data outputs\n";
+    std::cout << "functional model mismatches: " << testbench.mismatches() << "\n";
+    std::cout << "input vectors: " << testbench.processedVectors() << "\n";
+    std::cout << "clock cycles: " << testbench.executionCycles() << " (" << t_cycles / t_vectors
+              << " per vector)\n";
+    std::cout << "PE operations per cycle: " << t_vectors * cgra::cNumOfPe / t_cycles << "\n";
+    std::cout << "wall-clock time: " << t_wallClock.count() << " s\n";
+    std::cout << "input vectors per second: " << t_vectors / t_wallClock.count() << "\n";
+    std::cout << "simulated cycles per second: " << t_cycles / t_wallClock.count() << std::endl;
+
+#ifdef MCPAT
+    std::ofstream fp_mcpatStats{"mcpat_stats_vcgra_scaling.log", std::ios_base::out};
+    vcgra.dumpMcpatStatistics(fp_mcpatStats);
+    fp_mcpatStats.close();
+#endif
+
+    return 0 == testbench.mismatches() ? EXIT_SUCCESS : EXIT_FAILURE;
+}